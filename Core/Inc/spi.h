@@ -0,0 +1,62 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    spi.h
+  * @brief   This file contains all the function prototypes for
+  *          the spi.c file
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __SPI_H__
+#define __SPI_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+extern DMA_HandleTypeDef hdma_spi1_tx;
+
+/* USER CODE BEGIN Private defines */
+// SPI1时钟分频（APB2=100MHz）：0=/2 1=/4 2=/8 ... 7=/256
+#ifndef SPI1_BAUD_PRESCALER
+#define SPI1_BAUD_PRESCALER   1       // 100MHz/4 = 25MHz
+#endif
+
+// 小于该字节数的发送直接轮询DR，避免DMA启动开销
+#define SPI1_DMA_MIN_BYTES    16
+/* USER CODE END Private defines */
+
+void MX_SPI1_Init(void);
+void MX_SPI1_DeInit(void);
+
+/* USER CODE BEGIN Prototypes */
+void SPI1_SetFrame16(uint8_t enable);
+void SPI1_Transmit(const void *data, uint32_t count, uint8_t mem_inc);
+void SPI1_WaitIdle(void);
+uint8_t SPI1_IsBusy(void);
+void SPI1_OnTxComplete(void (*callback)(void));
+/* USER CODE END Prototypes */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SPI_H__ */
@@ -22,10 +22,12 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "lcd_Driver.h"
+#include "lcd_Pipe.h"
 #include "GUI.h" 
 #include "font.h"
 #include "esp32_weather.h"
 #include "dht11.h"
+#include "screen.h"
 #include "usart.h"
 #include <stdio.h>
 #include <string.h>
@@ -38,6 +40,7 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+#define INDOOR_SAMPLE_MS    60000U      // 室内温湿度历史曲线的采样周期（128列约2小时）
 
 /* USER CODE END PD */
 
@@ -99,25 +102,39 @@ int main(void)
 
   // 初始化LCD  
   Lcd_Init();
+#if LCD_SOFTSPI_BENCH
+  {
+    LCD_SoftSPIBench_t bench;
+    LCD_SoftSPI_Benchmark(1024, &bench);
+    u6_printf("soft-spi HAL: %lu bit/s (%lu cyc), BSRR: %lu bit/s (%lu cyc), bit-band: %lu bit/s (%lu cyc)\r\n",
+              bench.hal_bps, bench.hal_cycles, bench.bsrr_bps, bench.bsrr_cycles,
+              bench.bitband_bps, bench.bitband_cycles);
+  }
+#endif
   DHT11_Init();
 
   int humidity, temperature;
-  char buffer[100] = {0};
   char uart_msg[100] = {0};
 
-  // 清屏为黑色
-  Lcd_Clear(WHITE);
-
-  // 显示湿度图标
-  Gui_DrawImage(1, 50, gImage_humo_nei);  // 在(5,50)位置显示湿度图标
-  Gui_DrawImage(50, 50, gImage_temp_nei);  // 在(65,50)位置显示温度图标
-  Gui_DrawImage(90, 40, gImage_1);  // 在(100,50)位置显示外部温度图标
-  Gui_DrawImage(80, 10, gImage_temp_wai);  // 在(100,50)位置显示外部温度图标
+#if LCD_PIPE_REPORT
+  LCD_Pipe_ResetStats();
+#endif
+  // 清屏并画出图标，文字控件在数据到来后显示
+  Screen_Init();
+  Screen_Update();
+#if LCD_PIPE_REPORT
+  LCD_Pipe_Drain();
+  u6_printf("lcd pipe: %lu bufs, xfer %lu cyc, wait %lu cyc, overlap %u%%\r\n",
+            LCD_Pipe_GetStats()->submits, LCD_Pipe_GetStats()->xfer_cycles,
+            LCD_Pipe_GetStats()->wait_cycles, LCD_Pipe_OverlapPercent());
+#endif
 
 
   uint32_t weather_counter = 0;
+  uint32_t indoor_sample_tick = HAL_GetTick() - INDOOR_SAMPLE_MS;   // 第一次读数立即记录
   wifi_connect();
   get_weather();
+  Screen_Update();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -139,7 +156,7 @@ int main(void)
     //Gui_DrawFont_Num32(10, 100, BLACK, WHITE, 1);
     /*====================测试================ */
     /*读取DHT11温湿度数据*/
-    DHT11_Read(&humidity, &temperature);
+    bool dht_ok = DHT11_Read(&humidity, &temperature);
         // ✅ 打印湿度
     sprintf(uart_msg, "湿度: %d%%\r\n", humidity);
     HAL_UART_Transmit(&huart6, (uint8_t*)uart_msg, strlen(uart_msg), 1000);
@@ -147,35 +164,25 @@ int main(void)
     // ✅ 打印温度
     sprintf(uart_msg, "温度: %d°C\r\n", temperature);
     HAL_UART_Transmit(&huart6, (uint8_t*)uart_msg, strlen(uart_msg), 1000);
-    // 读取成功，显示数据-
-    sprintf(buffer, "%d%%",humidity); 
-    Gui_DrawAsciiString(25,55,BLACK, WHITE, buffer);
-
-    /*显示温度*/
-    sprintf(buffer, "%d",temperature);
-    if(temperature>30)
-    {
-      Gui_DrawAsciiString(68,55,RED, WHITE, buffer);
-      Gui_Circle(82, 52,1, RED);
-      Gui_DrawAsciiChar(82, 55, RED, WHITE, 'c');  // 显示摄氏度符号
-    }
-    else if(temperature<10)
-    {
-      Gui_DrawAsciiString(68,55,BLUE, WHITE, buffer);
-      Gui_Circle(82, 52,1, BLACK);
-      Gui_DrawAsciiChar(82, 55, BLACK, WHITE, 'c');  // 显示摄氏度符号
-    }
-    else
+    // 读取成功，显示数据（颜色和单位由Screen_SetIndoor决定，数值不变时不重画）
+    Screen_SetIndoor(humidity, temperature);
+    if(dht_ok && HAL_GetTick() - indoor_sample_tick >= INDOOR_SAMPLE_MS)
     {
-      Gui_DrawAsciiString(68,55,BLACK, WHITE, buffer);
-      Gui_Circle(82, 52, 1, BLACK);
-     Gui_DrawAsciiChar(82, 55, BLACK, WHITE, 'C');  // 显示摄氏度符号
+      indoor_sample_tick = HAL_GetTick();
+      Screen_AddIndoorSample(humidity, temperature);
     }
 
     get_weather();  // 重新获取天气
+    Screen_Update();
     // 等待2秒再读取
     HAL_Delay(2000);
     get_time();
+    Screen_Update();
+#if GUI_STRING_CACHE_REPORT
+    u6_printf("str cache: %lu hits, %lu misses (%u%%), %lu bytes saved\r\n",
+              Gui_StringCacheGetStats()->hits, Gui_StringCacheGetStats()->misses,
+              Gui_StringCacheHitPercent(), Gui_StringCacheGetStats()->bytes_saved);
+#endif
     
   }
   /* USER CODE END 3 */
@@ -0,0 +1,274 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    spi.c
+  * @brief   This file provides code for the configuration
+  *          of the SPI instances.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "spi.h"
+
+/* USER CODE BEGIN 0 */
+/*
+ * 说明：工程中未包含 stm32f4xx_hal_spi.c 驱动，SPI1 在寄存器层配置，
+ *       发送通道使用 HAL DMA（DMA2 Stream3 Channel3 = SPI1_TX）。
+ *       SPI1 只用于驱动 ST7735：单线只发送模式，SCK 空闲高电平、上升沿采样（模式3），
+ *       与原软件SPI时序一致。
+ */
+static volatile uint8_t spi1_dma_busy = 0;      // DMA传输进行中标志（中断中清除）
+static const uint8_t *spi1_dma_ptr;             // 下一段DMA的源地址
+static volatile uint32_t spi1_dma_remain = 0;   // 剩余未启动的帧数
+static uint8_t spi1_dma_inc = 1;                // 源地址是否递增
+static uint8_t spi1_frame16 = 0;                // 当前帧长：0=8位 1=16位
+static void (*volatile spi1_tx_cplt_cb)(void);  // 下一次DMA全部完成时调用（一次性）
+
+static void SPI1_DMA_StartChunk(void);
+static void SPI1_DMA_TxCplt(DMA_HandleTypeDef *hdma);
+/* USER CODE END 0 */
+
+DMA_HandleTypeDef hdma_spi1_tx;
+
+/* SPI1 init function */
+void MX_SPI1_Init(void)
+{
+
+  /* USER CODE BEGIN SPI1_Init 0 */
+
+  /* USER CODE END SPI1_Init 0 */
+
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  /* SPI1 clock enable */
+  __HAL_RCC_SPI1_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+  __HAL_RCC_GPIOA_CLK_ENABLE();
+
+  /**SPI1 GPIO Configuration
+  PA5     ------> SPI1_SCK
+  PA7     ------> SPI1_MOSI
+  */
+  GPIO_InitStruct.Pin = GPIO_PIN_5|GPIO_PIN_7;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
+  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+  /* SPI1 DMA Init */
+  /* SPI1_TX Init */
+  hdma_spi1_tx.Instance = DMA2_Stream3;
+  hdma_spi1_tx.Init.Channel = DMA_CHANNEL_3;
+  hdma_spi1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma_spi1_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma_spi1_tx.Init.MemInc = DMA_MINC_ENABLE;
+  hdma_spi1_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+  hdma_spi1_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+  hdma_spi1_tx.Init.Mode = DMA_NORMAL;
+  hdma_spi1_tx.Init.Priority = DMA_PRIORITY_HIGH;
+  hdma_spi1_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+  if (HAL_DMA_Init(&hdma_spi1_tx) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  HAL_DMA_RegisterCallback(&hdma_spi1_tx, HAL_DMA_XFER_CPLT_CB_ID, SPI1_DMA_TxCplt);
+
+  /* DMA interrupt init */
+  /* DMA2_Stream3_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA2_Stream3_IRQn, 5, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Stream3_IRQn);
+
+  /* USER CODE BEGIN SPI1_Init 1 */
+  // 主机模式、软件NSS、单线只发送、CPOL=1 CPHA=1、MSB先发
+  SPI1->CR1 = 0;
+  SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI
+            | SPI_CR1_BIDIMODE | SPI_CR1_BIDIOE
+            | SPI_CR1_CPOL | SPI_CR1_CPHA
+            | ((SPI1_BAUD_PRESCALER & 0x7U) << SPI_CR1_BR_Pos);
+  SPI1->CR2 = SPI_CR2_TXDMAEN;
+  SPI1->CR1 |= SPI_CR1_SPE;
+
+  spi1_dma_busy = 0;
+  spi1_dma_remain = 0;
+  spi1_frame16 = 0;
+  /* USER CODE END SPI1_Init 1 */
+}
+
+/* SPI1 deinit function */
+void MX_SPI1_DeInit(void)
+{
+  /* USER CODE BEGIN SPI1_DeInit 0 */
+  SPI1_WaitIdle();
+  /* USER CODE END SPI1_DeInit 0 */
+
+  SPI1->CR1 &= ~SPI_CR1_SPE;
+  SPI1->CR2 = 0;
+
+  /* Peripheral clock disable */
+  __HAL_RCC_SPI1_CLK_DISABLE();
+
+  /**SPI1 GPIO Configuration
+  PA5     ------> SPI1_SCK
+  PA7     ------> SPI1_MOSI
+  */
+  HAL_GPIO_DeInit(GPIOA, GPIO_PIN_5|GPIO_PIN_7);
+
+  /* SPI1 DMA DeInit */
+  HAL_NVIC_DisableIRQ(DMA2_Stream3_IRQn);
+  HAL_DMA_DeInit(&hdma_spi1_tx);
+
+  /* USER CODE BEGIN SPI1_DeInit 1 */
+
+  /* USER CODE END SPI1_DeInit 1 */
+}
+
+/* USER CODE BEGIN 1 */
+
+/**
+ * @brief  切换SPI1帧长
+ * @param  enable: 1=16位帧（RGB565像素高字节先发），0=8位帧
+ * @note   DFF只能在SPE=0时修改，切换前等待上一次发送完成
+ */
+void SPI1_SetFrame16(uint8_t enable)
+{
+    enable = enable ? 1 : 0;
+    if(enable == spi1_frame16) return;
+
+    SPI1_WaitIdle();
+    SPI1->CR1 &= ~SPI_CR1_SPE;
+    if(enable)
+        SPI1->CR1 |= SPI_CR1_DFF;
+    else
+        SPI1->CR1 &= ~SPI_CR1_DFF;
+    SPI1->CR1 |= SPI_CR1_SPE;
+    spi1_frame16 = enable;
+}
+
+/**
+ * @brief  通过SPI1发送count帧数据
+ * @param  data: 数据源（8位帧为字节数组，16位帧为uint16_t数组）
+ * @param  count: 帧数
+ * @param  mem_inc: 1=源地址递增，0=重复发送同一个帧（用于纯色填充）
+ * @note   短数据直接轮询发送；长数据启动DMA后立即返回，
+ *         调用方在切换CS/DC或复用缓冲区前必须调用SPI1_WaitIdle()
+ */
+void SPI1_Transmit(const void *data, uint32_t count, uint8_t mem_inc)
+{
+    uint32_t bytes = spi1_frame16 ? count * 2 : count;
+
+    if(count == 0) return;
+
+    // 等待上一次DMA结束（TXE/BSY无需等待，DR可以继续写入）
+    while(spi1_dma_busy);
+
+    if(bytes < SPI1_DMA_MIN_BYTES)
+    {
+        const uint8_t *p8 = (const uint8_t *)data;
+        const uint16_t *p16 = (const uint16_t *)data;
+        uint32_t i;
+
+        for(i = 0; i < count; i++)
+        {
+            while(!(SPI1->SR & SPI_SR_TXE));
+            if(spi1_frame16)
+                SPI1->DR = mem_inc ? p16[i] : p16[0];
+            else
+                SPI1->DR = mem_inc ? p8[i] : p8[0];
+        }
+        return;
+    }
+
+    // 按帧长和地址递增方式重新配置数据流（EN=0时才能修改）
+    hdma_spi1_tx.Init.MemInc = mem_inc ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
+    hdma_spi1_tx.Init.PeriphDataAlignment = spi1_frame16 ? DMA_PDATAALIGN_HALFWORD : DMA_PDATAALIGN_BYTE;
+    hdma_spi1_tx.Init.MemDataAlignment = spi1_frame16 ? DMA_MDATAALIGN_HALFWORD : DMA_MDATAALIGN_BYTE;
+    hdma_spi1_tx.Instance->CR &= ~(DMA_SxCR_MINC | DMA_SxCR_PSIZE | DMA_SxCR_MSIZE);
+    hdma_spi1_tx.Instance->CR |= hdma_spi1_tx.Init.MemInc
+                               | hdma_spi1_tx.Init.PeriphDataAlignment
+                               | hdma_spi1_tx.Init.MemDataAlignment;
+
+    spi1_dma_ptr = (const uint8_t *)data;
+    spi1_dma_remain = count;
+    spi1_dma_inc = mem_inc;
+    spi1_dma_busy = 1;
+    SPI1_DMA_StartChunk();
+}
+
+/**
+ * @brief  等待SPI1上所有数据发送完毕（DMA结束且移位寄存器为空）
+ */
+void SPI1_WaitIdle(void)
+{
+    while(spi1_dma_busy);
+    while(!(SPI1->SR & SPI_SR_TXE));
+    while(SPI1->SR & SPI_SR_BSY);
+}
+
+/**
+ * @brief  查询SPI1是否仍在发送
+ * @return 1=忙 0=空闲
+ */
+uint8_t SPI1_IsBusy(void)
+{
+    if(spi1_dma_busy) return 1;
+    if(!(SPI1->SR & SPI_SR_TXE)) return 1;
+    return (SPI1->SR & SPI_SR_BSY) ? 1 : 0;
+}
+
+/**
+ * @brief  登记下一次DMA发送全部完成时的回调（一次性，在DMA2_Stream3中断中调用）
+ * @param  callback: 回调函数，NULL=取消
+ * @note   回调时DMA已读完源缓冲区（移位寄存器中可能还有最后一帧），缓冲区可以复用；
+ *         回调中可以直接调用SPI1_Transmit启动下一次发送
+ */
+void SPI1_OnTxComplete(void (*callback)(void))
+{
+    spi1_tx_cplt_cb = callback;
+}
+
+/**
+ * @brief  启动下一段DMA（NDTR最大65535帧，超长数据分段发送）
+ */
+static void SPI1_DMA_StartChunk(void)
+{
+    uint32_t n = (spi1_dma_remain > 0xFFFFU) ? 0xFFFFU : spi1_dma_remain;
+
+    spi1_dma_remain -= n;
+    HAL_DMA_Start_IT(&hdma_spi1_tx, (uint32_t)spi1_dma_ptr, (uint32_t)&SPI1->DR, n);
+    if(spi1_dma_inc)
+        spi1_dma_ptr += spi1_frame16 ? n * 2 : n;
+}
+
+/**
+ * @brief  DMA发送完成回调（在DMA2_Stream3中断中调用）
+ */
+static void SPI1_DMA_TxCplt(DMA_HandleTypeDef *hdma)
+{
+    void (*callback)(void);
+
+    (void)hdma;
+    if(spi1_dma_remain)
+    {
+        SPI1_DMA_StartChunk();
+        return;
+    }
+
+    spi1_dma_busy = 0;
+    callback = spi1_tx_cplt_cb;
+    spi1_tx_cplt_cb = NULL;
+    if(callback)
+        callback();
+}
+
+/* USER CODE END 1 */
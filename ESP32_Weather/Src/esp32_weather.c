@@ -5,6 +5,7 @@
 #include "stm32f4xx_hal_uart.h"
 #include "usart.h"
 #include "GUI.h"  
+#include "screen.h"
 
 static char esp32_rx_buffer[RXBUFFER];  //接收缓冲区
 static uint16_t esp32_rx_index = 0;
@@ -249,9 +250,7 @@ void parse_weather_json(void)
             //打印到串口调试
             sprintf(weather_msg, "温度: %s°C\n", temp_str);
             HAL_UART_Transmit(&huart6, (uint8_t*)weather_msg, strlen(weather_msg), 1000);
-        char lcd_temp[20];
-        sprintf(lcd_temp, "%s", temp_str);  // 英文显示，无换行符
-        Gui_DrawAsciiString(100, 10, BLACK, WHITE, lcd_temp);
+        Screen_SetOutdoorTemp(temp_str);  // 英文显示，由Screen_Update绘制
 
     }
     
@@ -259,9 +258,7 @@ void parse_weather_json(void)
         sscanf(condition_pos, "\"text\":\"%63[^\"]\"", condition_str);
         sprintf(weather_msg, "天气状况: %s\n", condition_str);
         HAL_UART_Transmit(&huart6, (uint8_t*)weather_msg, strlen(weather_msg), 1000);
-        char lcd_weather[20];
-        sprintf(lcd_weather, "%s", condition_str);  // 英文显示，无换行符
-        Gui_DrawAsciiString(10, 10, BLACK, WHITE, lcd_weather);
+        Screen_SetWeather(condition_str);  // 英文显示，由Screen_Update绘制
     }
 
     HAL_UART_Transmit(&huart6, (uint8_t*)"天气数据解析完成\n", 24, 1000);
@@ -424,13 +421,8 @@ void parse_time_data(void)
         // %02d：2位数字，不足前面补0（时、分、秒）
         sprintf(time_display, "%02d:%02d:%02d", hour, minute, second);
         
-        // 在LCD屏幕上显示日期
-        // 参数：x=10像素, y=90像素, 前景色=黑色, 背景色=白色, 显示内容=日期字符串
-        Gui_DrawAsciiString(10, 90, BLACK, WHITE, date_display);
-        
-        // 在LCD屏幕上显示时间
-        // 参数：x=20像素, y=110像素, 前景色=黑色, 背景色=白色, 显示内容=时间字符串
-        Gui_DrawAsciiString(20, 110, BLACK, WHITE, time_display);
+        // 交给主界面的日期/时间控件，由Screen_Update只重画变化的部分
+        Screen_SetDateTime(date_display, time_display);
     }
     // 如果parsed != 7，说明解析失败，函数直接结束，不显示任何内容
 }
\ No newline at end of file
@@ -2,6 +2,17 @@
 #define __GUI_H
 
 #include "stm32f4xx_hal.h"
+#include "font.h"
+
+// 裁剪区：所有Gui_*绘图函数只画在当前裁剪区内，完全在外的字形、线段和图片不产生任何发送
+typedef struct {
+    uint16_t x0, y0;        // 左上角（含）
+    uint16_t x1, y1;        // 右下角（不含），x1==x0或y1==y0时为空
+} GUI_Rect_t;
+uint8_t Gui_PushClip(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void Gui_PopClip(void);
+void Gui_ResetClip(void);
+const GUI_Rect_t *Gui_GetClip(void);
 
 // 函数声明
 uint16_t LCD_BGR2RGB(uint16_t c);
@@ -12,11 +23,49 @@ void Gui_box2(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t mode);
 void DisplayButtonDown(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 void DisplayButtonUp(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 
-// 汉字显示函数
+// 填充图形和圆弧（按水平段输出，每段一个窗口）；角度单位为度，0=12点方向，顺时针增加
+int16_t Gui_SinQ15(int16_t deg);
+int16_t Gui_CosQ15(int16_t deg);
+void Gui_FillCircle(uint16_t X, uint16_t Y, uint16_t R, uint16_t fc);
+void Gui_FillRoundRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t r, uint16_t fc);
+void Gui_Arc(uint16_t X, uint16_t Y, uint16_t R, uint16_t thick, int16_t start, uint16_t sweep, uint16_t fc);
+void Gui_Gauge(uint16_t X, uint16_t Y, uint16_t R, uint16_t thick, int16_t start, uint16_t sweep,
+               uint16_t value, uint16_t max, uint16_t fc, uint16_t bc);
+
+// 汉字显示函数（UTF-8，字库按码点查找）
+void Gui_DrawTextFont(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const FNT_Font_t *font, const char *s);
+void Gui_DrawText16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s);
+void Gui_DrawText24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s);
 void Gui_DrawFont_GBK16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s);
 void Gui_DrawFont_GBK24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s);
 
+// 字形缓存（GUI_GLYPH_CACHE_SLOTS，见LCD_Config.h）
+typedef struct {
+    uint32_t hits;          // 直接发送缓存中已展开的字形
+    uint32_t misses;        // 查找码点并展开点阵（包括字库中没有的字）
+    uint32_t evictions;     // 缓存已满，替换最久没有用到的字形
+} GUI_GlyphCacheStats_t;
+const GUI_GlyphCacheStats_t *Gui_GlyphCacheGetStats(void);
+void Gui_GlyphCacheReset(void);
+
+// 字符串缓存（GUI_STRING_CACHE_BYTES，见LCD_Config.h）
+typedef struct {
+    uint32_t hits;          // 整串直接发送缓存的像素块
+    uint32_t misses;        // 光栅化后放入缓存（不能缓存的文字不计）
+    uint32_t evictions;     // 表项或RAM不够，淘汰最久没有用到的字符串
+    uint32_t bytes_saved;   // 命中时省去展开的像素字节数
+} GUI_StringCacheStats_t;
+const GUI_StringCacheStats_t *Gui_StringCacheGetStats(void);
+uint8_t Gui_StringCacheHitPercent(void);
+void Gui_StringCacheReset(void);
+
 // 图片显示函数
+// Gui_DrawImage 的图片头（8字节）：[0]扫描方式 [1]位深 [2..3]宽 [4..5]高 [6]RGB565标志 [7]数据格式
+#define GUI_IMAGE_RAW       0x1B    // Image2Lcd原始格式：RGB565小端，每像素2字节（其他未知格式也按此处理）
+#define GUI_IMAGE_INDEXED   0x50    // 调色板：[1]=每像素1/2/4/8位，[8]=颜色数-1，后接调色板(RGB565小端)，每行按字节对齐、高位在前
+#define GUI_IMAGE_RLE       0x52    // 行程编码：[1]=16时像素为RGB565小端；[1]=8时[8]/调色板同上，像素为1字节索引
+                                    // 每包一个控制字节n：n>=0x80为后面1个像素重复(n-0x7F)次，否则后面(n+1)个像素原样输出
+#define GUI_IMAGE_BIG_ENDIAN 0x10   // [0]的bit4（Image2Lcd"WORD高低字节与PC相反"）：像素和调色板为高字节在前，原始格式直接发送
 void Gui_DrawBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *bitmap);
 void Gui_DrawIcon(uint16_t x, uint16_t y, uint16_t size, const uint16_t *icon_data);
 void Gui_DrawImage(uint16_t x, uint16_t y, const uint8_t *image_data);
@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Chart.h
+ * @brief          : 历史曲线控件（折线/面积图）
+ *                   每个曲线的采样保存在环形缓冲区里，一个采样占一列；
+ *                   新采样覆盖最老的一列（扫描式，像示波器一样从左到右循环），
+ *                   空白的游标列标出新旧数据的分界，每次只重画新采样附近的几列
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 使用方法：
+ * - 控件结构体由调用方静态分配，用 GUI_Chart_Init 初始化，GUI_Chart_AddSeries 添加曲线
+ * - 用 GUI_Chart_Push 加入一组采样（每条曲线一个值，只改内存，不发送）
+ * - 用 GUI_Chart_Update 把变化画到屏幕；没有新采样时不产生任何SPI数据
+ * - 纵轴按缓冲区内的最小/最大值自动缩放，取整到曲线的step；
+ *   只有取整后的范围变化时才整个图重画，其余情况只发送新采样、游标和游标后一列
+ ******************************************************************************
+ */
+
+#ifndef __GUI_CHART_H
+#define __GUI_CHART_H
+
+#include <stdint.h>
+
+#define GUI_CHART_W_MAX         128     // 最大宽度（列数=环形缓冲区长度）
+#define GUI_CHART_SERIES_MAX    2       // 最多曲线数
+
+/**
+ * @brief 曲线
+ */
+typedef struct
+{
+    uint16_t color;                     /**< 折线颜色 */
+    uint16_t fill;                      /**< 折线以下的填充色，等于图表背景色时只画折线 */
+    int16_t  step;                      /**< 纵轴范围取整单位（也是最小范围） */
+    int16_t  lo, hi;                    /**< 当前纵轴范围[lo, hi)，画在屏幕上的就是这个范围 */
+    int16_t  data[GUI_CHART_W_MAX];     /**< 采样，下标即列号 */
+} GUI_ChartSeries_t;
+
+/**
+ * @brief 图表
+ */
+typedef struct
+{
+    uint16_t x, y;                      /**< 左上角 */
+    uint8_t  w, h;                      /**< 宽（列数）、高 */
+    uint16_t bg;                        /**< 背景色（空白列和游标列） */
+    uint8_t  series;                    /**< 曲线数 */
+    uint8_t  head;                      /**< 游标列，下一个采样写在这里 */
+    uint8_t  count;                     /**< 有效采样数（最多w-1，游标列不放数据） */
+    uint8_t  pending;                   /**< 上次Update之后加入的采样数 */
+    uint8_t  drawn;                     /**< 0=下次Update整个图重画 */
+    GUI_ChartSeries_t s[GUI_CHART_SERIES_MAX];
+} GUI_Chart_t;
+
+// 初始化
+void GUI_Chart_Init(GUI_Chart_t *c, uint16_t x, uint16_t y, uint8_t w, uint8_t h, uint16_t bg);
+int8_t GUI_Chart_AddSeries(GUI_Chart_t *c, uint16_t color, uint16_t fill, int16_t step);
+
+// 加入一组采样（values[i]为第i条曲线的值），只记录，由GUI_Chart_Update发送
+void GUI_Chart_Push(GUI_Chart_t *c, const int16_t *values);
+
+// 清空采样
+void GUI_Chart_Clear(GUI_Chart_t *c);
+
+// 屏幕内容被其他绘图覆盖后，强制下次Update完整重画
+void GUI_Chart_Invalidate(GUI_Chart_t *c);
+
+// 把变化画到屏幕，返回1表示有绘制
+uint8_t GUI_Chart_Update(GUI_Chart_t *c);
+
+#endif /* __GUI_CHART_H */
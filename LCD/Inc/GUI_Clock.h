@@ -0,0 +1,93 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Clock.h
+ * @brief          : 指针式时钟控件
+ *                   表盘按像素计算（外圈、12个刻度点、中心圆），指针为定点正弦表算出的梯形；
+ *                   每次更新只重画上次和本次指针覆盖、且颜色真正变化的像素，
+ *                   被擦掉的部分按表盘重新算出，不需要整个表盘的显示缓冲
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 使用方法：
+ * - 控件结构体由调用方静态分配，用 GUI_Clock_Init 初始化
+ * - 用 GUI_Clock_SetTime 修改时间（只改内存，不发送），毫秒参数让秒针每1°前进一格
+ * - 用 GUI_Clock_Update 把变化画到屏幕；指针角度没有变化时不产生任何SPI数据
+ * - 第一次 Update、GUI_Clock_Move / SetColors 之后或 GUI_Clock_Invalidate 之后整个表盘重画
+ *   （外接正方形内表盘以外的部分用bg填充）；移动前的旧位置由调用方擦除
+ ******************************************************************************
+ */
+
+#ifndef __GUI_CLOCK_H
+#define __GUI_CLOCK_H
+
+#include <stdint.h>
+
+#define GUI_CLOCK_R_MIN     8       // 表盘最小半径
+#define GUI_CLOCK_R_MAX     63      // 表盘最大半径（行缓冲为2*R+1个像素）
+#define GUI_CLOCK_MARKS     12      // 刻度点数
+
+/**
+ * @brief 指针
+ */
+typedef enum
+{
+    GUI_CLOCK_HOUR = 0,     /**< 时针 */
+    GUI_CLOCK_MINUTE,       /**< 分针 */
+    GUI_CLOCK_SECOND,       /**< 秒针（在最上层） */
+    GUI_CLOCK_HANDS
+} GUI_ClockHand_t;
+
+/**
+ * @brief 指针形状（Q8定点像素）：从尾端宽base_w到针尖宽tip_w的梯形，宽度为半宽
+ */
+typedef struct
+{
+    int16_t len, tail;
+    int16_t base_w, tip_w;
+} GUI_ClockShape_t;
+
+/**
+ * @brief 时钟
+ */
+typedef struct
+{
+    int16_t  cx, cy;                            /**< 圆心 */
+    uint8_t  r;                                 /**< 表盘半径 */
+    uint8_t  rim;                               /**< 外圈宽度 */
+    uint8_t  hub;                               /**< 中心圆半径 */
+    uint8_t  mark_r[2];                         /**< 刻度点半径：[0]=3/6/9/12点，[1]=其余 */
+    uint16_t mark_in2;                          /**< 刻度点所在圆环内径的平方，更靠内的像素不用判断刻度 */
+    int8_t   mark_x[GUI_CLOCK_MARKS];           /**< 刻度点圆心（相对表盘圆心） */
+    int8_t   mark_y[GUI_CLOCK_MARKS];
+    GUI_ClockShape_t shape[GUI_CLOCK_HANDS];
+
+    uint16_t bg, face, rim_color, mark;         /**< 表盘外/表盘/外圈/刻度颜色 */
+    uint16_t hand_color[GUI_CLOCK_HANDS];       /**< 指针颜色，中心圆与秒针同色 */
+
+    // 绑定值：指针角度（度，0=12点方向，顺时针）
+    int16_t  angle[GUI_CLOCK_HANDS];
+
+    // 屏幕上当前的内容
+    int16_t  shown[GUI_CLOCK_HANDS];
+    uint8_t  drawn;                             /**< 0=下次Update整个表盘重画 */
+} GUI_Clock_t;
+
+// 初始化（默认白色表盘、黑色刻度和时分针、红色秒针）
+void GUI_Clock_Init(GUI_Clock_t *c, uint16_t cx, uint16_t cy, uint8_t r);
+
+// 布局和颜色变化：下次Update整个表盘重画
+void GUI_Clock_Move(GUI_Clock_t *c, uint16_t cx, uint16_t cy, uint8_t r);
+void GUI_Clock_SetColors(GUI_Clock_t *c, uint16_t bg, uint16_t face, uint16_t rim, uint16_t mark);
+void GUI_Clock_SetHandColors(GUI_Clock_t *c, uint16_t hour, uint16_t minute, uint16_t second);
+
+// 修改时间（只记录，由GUI_Clock_Update发送）
+void GUI_Clock_SetTime(GUI_Clock_t *c, uint8_t hour, uint8_t min, uint8_t sec, uint16_t ms);
+
+// 屏幕内容被其他绘图覆盖后，强制下次Update完整重画
+void GUI_Clock_Invalidate(GUI_Clock_t *c);
+
+// 把变化画到屏幕，返回1表示有绘制
+uint8_t GUI_Clock_Update(GUI_Clock_t *c);
+
+#endif /* __GUI_CLOCK_H */
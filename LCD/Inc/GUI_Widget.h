@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Widget.h
+ * @brief          : 保留模式控件（标签/数值/图标/圆点）
+ *                   控件记住上次画到屏幕上的内容，只有绑定的值、文字或颜色
+ *                   变化时才重画；标签只重画字符变化的格子，内容变短时只擦除旧内容多出的部分
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 使用方法：
+ * - 控件结构体由调用方静态分配，用 GUI_Label_Init / GUI_Icon_Init / GUI_Dot_Init 初始化
+ * - 用 GUI_Widget_SetText / SetInt / SetColor / SetImage 修改绑定值（只改内存，不发送）
+ * - 用 GUI_Widget_Update 把变化画到屏幕；没有变化时不产生任何SPI数据
+ * - 标签为不透明文字（fc != bc），背景色也用来擦除旧内容
+ ******************************************************************************
+ */
+
+#ifndef __GUI_WIDGET_H
+#define __GUI_WIDGET_H
+
+#include <stdint.h>
+
+#define GUI_WIDGET_TEXT_MAX     24      // 标签最多字符数（含结束符）
+
+/**
+ * @brief 控件类型
+ */
+typedef enum
+{
+    GUI_WIDGET_LABEL = 0,   /**< 单行文字 */
+    GUI_WIDGET_ICON,        /**< 带头信息的图片（Gui_DrawImage格式） */
+    GUI_WIDGET_DOT          /**< 空心小圆（温度的度数符号） */
+} GUI_WidgetType_t;
+
+/**
+ * @brief 标签字体
+ */
+typedef enum
+{
+    GUI_FONT_ASCII16 = 0,   /**< 8x16 ASCII */
+    GUI_FONT_NUM32          /**< 32x32 数字（非数字字符显示为空白） */
+} GUI_Font_t;
+
+/**
+ * @brief 控件
+ */
+typedef struct
+{
+    uint8_t  type;                      /**< GUI_WidgetType_t */
+    uint8_t  font;                      /**< GUI_Font_t（标签） */
+    uint16_t x, y;                      /**< 左上角（圆点为圆心） */
+    uint16_t w, h;                      /**< 边界：标签为最大字符数x字宽/字高，圆点为半径 */
+    uint16_t fc, bc;                    /**< 前景色/背景色 */
+
+    // 绑定值
+    char text[GUI_WIDGET_TEXT_MAX];
+    const uint8_t *image;
+
+    // 屏幕上当前的内容
+    char shown[GUI_WIDGET_TEXT_MAX];
+    const uint8_t *shown_image;
+    uint16_t shown_fc, shown_bc;
+    uint16_t shown_w, shown_h;          /**< 上次实际占用的宽高 */
+    uint8_t  drawn;                     /**< 0=屏幕上还没有这个控件的内容 */
+} GUI_Widget_t;
+
+// 初始化
+void GUI_Label_Init(GUI_Widget_t *w, uint16_t x, uint16_t y, uint8_t max_chars, GUI_Font_t font, uint16_t fc, uint16_t bc);
+void GUI_Icon_Init(GUI_Widget_t *w, uint16_t x, uint16_t y, const uint8_t *image, uint16_t bc);
+void GUI_Dot_Init(GUI_Widget_t *w, uint16_t cx, uint16_t cy, uint16_t r, uint16_t fc);
+
+// 修改绑定值（只记录，由GUI_Widget_Update发送）
+void GUI_Widget_SetText(GUI_Widget_t *w, const char *text);
+void GUI_Widget_SetInt(GUI_Widget_t *w, int32_t value, const char *fmt);
+void GUI_Widget_SetColor(GUI_Widget_t *w, uint16_t fc, uint16_t bc);
+void GUI_Widget_SetImage(GUI_Widget_t *w, const uint8_t *image);
+
+// 屏幕内容被其他绘图覆盖后，强制下次Update完整重画
+void GUI_Widget_Invalidate(GUI_Widget_t *w);
+
+// 把变化画到屏幕，返回1表示有绘制
+uint8_t GUI_Widget_Update(GUI_Widget_t *w);
+uint8_t GUI_Widget_UpdateAll(GUI_Widget_t *const *list, uint8_t count);
+
+#endif /* __GUI_WIDGET_H */
@@ -15,8 +15,103 @@
 // ST7735R 1.44寸屏幕分辨率参数
 #define X_MAX_PIXEL	        128     // 屏幕宽度（像素）
 #define Y_MAX_PIXEL	        160     // 屏幕高度（像素）
+#define LCD_COL_OFFSET      2       // CASET中的列偏移（屏幕第0列在控制器显存中的位置）
+#define LCD_ROW_OFFSET      3       // RASET中的行偏移
+
+// 控制器显存总行数：硬件滚动（VSCRDEF）的TFA+VSA+BFA必须等于它，
+// 滚动区在显存中的位置按MADCTL=0xC8（MY=1）由这个值和LCD_ROW_OFFSET算出。
+// 驱动写入的行地址为LCD_ROW_OFFSET ~ LCD_ROW_OFFSET+Y_MAX_PIXEL-1（3~162），显存至少要有163行；
+// 与列（132列中的2~129）一样按屏幕上下各留LCD_ROW_OFFSET行计算，任何在0~159内的滚动区都能设置
+#ifndef LCD_GRAM_ROWS
+#define LCD_GRAM_ROWS       (Y_MAX_PIXEL + 2 * LCD_ROW_OFFSET)
+#endif
+#if (LCD_GRAM_ROWS < Y_MAX_PIXEL + LCD_ROW_OFFSET)
+#error "LCD_GRAM_ROWS must cover every row the driver addresses (Y_MAX_PIXEL + LCD_ROW_OFFSET)"
+#endif
 
 // 颜色深度配置
 #define LCD_COLOR_DEPTH     16      // 16位颜色深度
 
+// 传输层选择（见lcd_Transport.h）
+#define LCD_TRANSPORT_SOFT_SPI  0       // GPIO模拟SPI（备用方案）
+#define LCD_TRANSPORT_HW_SPI    1       // 硬件SPI1 + DMA（PA5=SCK, PA7=MOSI）
+
+#ifndef LCD_TRANSPORT
+#define LCD_TRANSPORT       LCD_TRANSPORT_HW_SPI    // 上电默认使用的传输层
+#endif
+
+// 软件SPI/控制引脚的GPIO访问方式（硬件SPI下CS/DC/RES/BLK同样使用）
+#define LCD_GPIO_HAL        0       // HAL_GPIO_WritePin（函数调用+断言+分支）
+#define LCD_GPIO_BSRR       1       // 直接写BSRR，一条存储指令
+#define LCD_GPIO_BITBAND    2       // Cortex-M4位带别名，一条存储指令
+
+#ifndef LCD_GPIO_BACKEND
+#define LCD_GPIO_BACKEND    LCD_GPIO_BSRR
+#endif
+
+// 上电时通过调试串口输出软件SPI吞吐量测试结果（LCD_SoftSPI_Benchmark）
+#ifndef LCD_SOFTSPI_BENCH
+#define LCD_SOFTSPI_BENCH   0
+#endif
+
+// 像素发送流水线（见lcd_Pipe.h）：2个缓冲区乒乓，每个LCD_PIPE_BUF_PIXELS像素
+#ifndef LCD_PIPE_BUF_PIXELS
+#define LCD_PIPE_BUF_PIXELS 256
+#endif
+
+// 开机画面画完后通过调试串口输出流水线重叠率（LCD_Pipe_OverlapPercent）
+#ifndef LCD_PIPE_REPORT
+#define LCD_PIPE_REPORT     0
+#endif
+
+// 显示缓冲模式（见lcd_Framebuffer.h）
+#define LCD_FB_NONE         0       // 直接模式：每个绘图函数立即发送到LCD
+#define LCD_FB_FULL         1       // 全屏RGB565显存（X*Y*2 = 40KB），Lcd_Flush只发送变化区域
+#define LCD_FB_BAND         2       // 记录绘图操作，Lcd_Flush时按水平条带光栅化发送（约10KB）
+
+#ifndef LCD_FB_MODE
+#define LCD_FB_MODE         LCD_FB_NONE
+#endif
+
+#define LCD_FB_DIRTY_MAX    16      // 脏矩形列表长度，超出后强制合并
+#define LCD_FB_MERGE_SLACK  32      // 两个脏矩形合并后多出的像素不超过此值就合并（一次开窗约11字节命令）
+
+#define LCD_BAND_LINES      16      // 条带高度（行），条带缓冲 = LCD_BAND_LINES*X_MAX_PIXEL*2 字节
+#define LCD_BAND_OPS_MAX    64      // 一次Lcd_Flush之间可记录的绘图操作数
+#define LCD_BAND_ARENA      2048    // 记录窗口像素数据的缓冲（像素），不够时提前光栅化发送
+
+// 抗锯齿字体：1=Gui_DrawAsciiChar/Gui_DrawFont_Num32使用灰度字库ascii_aa（4位）/num32_aa（2位），
+// 每对前景/背景色建一张混合表，每像素一次查表
+#ifndef GUI_FONT_AA
+#define GUI_FONT_AA             0
+#endif
+
+// 裁剪区栈（GUI.c）：Gui_PushClip最多嵌套的层数，栈底为整个屏幕
+#ifndef GUI_CLIP_DEPTH
+#define GUI_CLIP_DEPTH          4
+#endif
+
+// 字形缓存（GUI.c）：最近画过的字形按颜色展开成RGB565保存在RAM中，重复出现的字不再查找和展开
+#ifndef GUI_GLYPH_CACHE_SLOTS
+#define GUI_GLYPH_CACHE_SLOTS   8       // 缓存的字形数，0=不使用缓存
+#endif
+#ifndef GUI_GLYPH_CACHE_PIXELS
+#define GUI_GLYPH_CACHE_PIXELS  (24*24) // 每个字形最多的像素数（hz24），RAM = 约SLOTS*PIXELS*2字节；更大的字形不缓存
+#endif
+
+// 字符串缓存（GUI.c）：整行文字按字体和颜色光栅化成一块RGB565，重复的标签一次开窗直接发送
+#ifndef GUI_STRING_CACHE_BYTES
+#define GUI_STRING_CACHE_BYTES  8192    // 像素块占用的RAM（字节），0=不使用缓存；放不下的文字逐字画
+#endif
+#define GUI_STRING_CACHE_ENTRIES 8      // 最多缓存的字符串数
+#define GUI_STRING_CACHE_TEXT   24      // 可缓存的最长字符串（字节，含结束符）
+#ifndef GUI_STRING_CACHE_REPORT
+#define GUI_STRING_CACHE_REPORT 0       // 1=主循环每次刷新后从调试串口输出命中率和节省的字节数
+#endif
+
+// 是否编译硬件SPI后端（主机端构建没有SPI1外设时设为0）
+#ifndef LCD_HW_SPI_ENABLE
+#define LCD_HW_SPI_ENABLE   1
+#endif
+
 #endif /* __LCD_CONFIG_H */
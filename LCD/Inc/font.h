@@ -19,52 +19,60 @@
  */
 #define USE_ONCHIP_FLASH_FONT 1
 
-/**
- * @brief 16x16像素中文字符结构体定义
- * @details 用于存储单个中文字符的字模数据
- */
-struct typFNT_GB162
-{
-       const char *Index;  /**< 字符索引，指向中文字符字符串 */
-       char Msk[32];       /**< 字模数据，16x16像素=32字节 */
-};
+#include <stdint.h>
 
 /**
- * @brief 24x24像素中文字符结构体定义
- * @details 用于存储单个大号中文字符的字模数据
+ * @brief 按码点索引的点阵字库
+ * @details codes[] 为升序排列的Unicode码点（只支持BMP，汉字都在其中），
+ *          bitmaps 中第i个字形对应 codes[i]，按行扫描、高位在前，每行按字节对齐。
+ *          码点表和字形分开存放，二分查找只访问紧凑的码点表，几千个字符也只需十几次比较。
+ *          bpp>1为抗锯齿字体：每像素一个灰度值，0为背景色，(1<<bpp)-1为前景色
  */
-struct typFNT_GB242
+typedef struct
 {
-       const char *Index;  /**< 字符索引，指向中文字符字符串 */
-       char Msk[72];       /**< 字模数据，24x24像素=72字节 */
-};
+    uint8_t  width;             /**< 字形宽度（像素） */
+    uint8_t  height;            /**< 字形高度（像素） */
+    uint8_t  bpp;               /**< 每像素位数：1=单色，2/4=抗锯齿灰度 */
+    uint16_t glyph_bytes;       /**< 每个字形的字节数 */
+    uint16_t count;             /**< 字符数量 */
+    const uint16_t *codes;      /**< 升序码点表 */
+    const uint8_t  *bitmaps;    /**< count个字形 */
+} FNT_Font_t;
 
 /**
- * @brief 字体数据数组外部声明
+ * @brief 汉字字库数据（码点表和字形）所在的段
+ * @note  STM32F411XX_FLASH.ld 把 .font_blob 放在Flash扇区6~7（FONT区域，256KB），
+ *        完整的GB2312 16x16字库（约250KB）不占程序空间，更换字库时只需擦写这两个扇区；
+ *        主机端构建不指定段
  */
-extern const unsigned char sz32[];                     /**< 32x32像素数字字体数据数组 */
-extern const struct typFNT_GB162 hz16[];              /**< 16x16中文字符字模数据数组 */
-extern const struct typFNT_GB242 hz24[];              /**< 24x24中文字符字模数据数组 */
-extern const unsigned char ascii_font[95][16];           /**< 95个可打印ASCII字符的8x16字模 */
+#if defined(__arm__) && defined(__GNUC__)
+#define FNT_BLOB            __attribute__((section(".font_blob")))
+#else
+#define FNT_BLOB
+#endif
+
+#define FNT_CODE_INVALID    0xFFFD  /**< 无法解码的UTF-8字节返回的码点（U+FFFD替换字符） */
+
+// 字库查找（font.c）
+const uint8_t *FNT_FindGlyph(const FNT_Font_t *font, uint32_t code);
+uint32_t FNT_Utf8Next(const char **s);
 
-extern const unsigned char gImage_weather[3208];       /**< 天气图片数据*/
-extern const unsigned char gImage_humo_nei[768];          /**< 湿度图片数据*/
-extern const unsigned char gImage_temp_nei[728];          /**<  温度图片数据*/
-extern const unsigned char gImage_clock[2458];        /**<  时钟图片数据*/
-extern const unsigned char gImage_temp_wai[768];          /**< 外部温度图片数据 */
-extern const unsigned char gImage_1[3288];       
 /**
- * @brief 字体数量定义
+ * @brief 字体和图片数据外部声明、数组大小和字符数量
+ * @note  font_assets.h 由构建时的 tools/assets/asset_gen.py 根据 assets/assets.txt 生成：
+ *        ascii_font[][]、sz32[]/sz32_num、hz16/hz16_num、hz24/hz24_num（FNT_Font_t）、
+ *        ascii_aa、num32_aa（抗锯齿FNT_Font_t）、gImage_*[]
  */
-#define hz16_num   4    /* 当前已定义的16x16中文字符数量 */
-#define hz24_num   1    /* 当前已定义的24x24中文字符数量 */
+#include "font_assets.h"
 
 /* 
  * 使用说明：
- * 1. ASCII字符使用asc16[]数组，支持8x16像素显示
- * 2. 中文字符使用hz16[]或hz24[]数组，分别支持16x16和24x24像素显示
- * 3. 添加新字符时，需要同时更新对应的_num宏定义
- * 4. 字模数据通过字模软件生成，按行扫描方式存储
+ * 1. ASCII字符使用ascii_font[]数组，支持8x16像素显示
+ * 2. 中文字符使用hz16或hz24字库（FNT_Font_t），分别支持16x16和24x24像素显示，
+ *    通过Gui_DrawText16/Gui_DrawText24按UTF-8字符串显示
+ * 3. 添加字符或图片时修改 assets/ 下的BDF/PNG源文件和 assets/assets.txt，
+ *    数组和_num宏在构建时重新生成，不要手工修改
+ * 4. 字模按行扫描、高位在前存储
  */
 
 #endif /* __FONT_H__ */
@@ -3,6 +3,8 @@
 
 /*头文件*/
 #include "stm32f4xx_hal.h"
+#include "LCD_Config.h"
+#include "lcd_Transport.h"
 
 #define RED  	0xf800
 #define GREEN	0x07e0
@@ -30,23 +32,50 @@
 #define LCD_DC         	    GPIO_PIN_3	//PA3 GPIO_Out--->>ST7735 --DC (数据/命令选择)
 #define LCD_RES     	    GPIO_PIN_2	//PA2 GPIO_Out--->>ST7735 --RES (硬件复位)
 
+// 引脚编号（位带别名地址按引脚编号计算）
+#define LCD_SCL_POS         5
+#define LCD_SDA_POS         7
+#define LCD_CS_POS          4
+#define LCD_BLK_POS         1
+#define LCD_DC_POS          3
+#define LCD_RES_POS         2
+
 //#define LCD_CS_SET(x) LCD_CTRL->ODR=(LCD_CTRL->ODR&~LCD_CS)|(x ? LCD_CS:0)
 
-//LCD控制口置1操作语句宏定义 (使用HAL库标准方式)
-#define	LCD_SCL_SET     HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_SET)    
-#define	LCD_SDA_SET     HAL_GPIO_WritePin(LCD_CTRL, LCD_SDA, GPIO_PIN_SET)   
-#define	LCD_CS_SET      HAL_GPIO_WritePin(LCD_CTRL, LCD_CS, GPIO_PIN_SET)  
-#define	LCD_BLK_SET     HAL_GPIO_WritePin(LCD_CTRL, LCD_BLK, GPIO_PIN_SET)   
-#define	LCD_DC_SET      HAL_GPIO_WritePin(LCD_CTRL, LCD_DC, GPIO_PIN_SET) 
-#define	LCD_RES_SET     HAL_GPIO_WritePin(LCD_CTRL, LCD_RES, GPIO_PIN_SET) 
+// Cortex-M4位带别名：ODR的每一位映射为一个32位字，写0/1即清/置该位
+// （LCD_GPIO_BITBAND后端使用；软件SPI吞吐量测试不论选哪个后端都会用到）
+#define LCD_CTRL_BASE           GPIOA_BASE
+#define LCD_ODR_BB(pos)         (*(volatile uint32_t *)(PERIPH_BB_BASE + ((LCD_CTRL_BASE + 0x14U - PERIPH_BASE) * 32U) + ((pos) * 4U)))
+
+// 引脚写操作，由LCD_Config.h中的LCD_GPIO_BACKEND选择实现方式
+#if (LCD_GPIO_BACKEND == LCD_GPIO_BSRR)
+// BSRR低16位置1、高16位清0，一条存储指令完成，无需读-改-写
+#define LCD_PIN_SET(pin, pos)   (LCD_CTRL->BSRR = (uint32_t)(pin))
+#define LCD_PIN_CLR(pin, pos)   (LCD_CTRL->BSRR = (uint32_t)(pin) << 16)
+#elif (LCD_GPIO_BACKEND == LCD_GPIO_BITBAND)
+#define LCD_PIN_SET(pin, pos)   (LCD_ODR_BB(pos) = 1U)
+#define LCD_PIN_CLR(pin, pos)   (LCD_ODR_BB(pos) = 0U)
+#else
+// HAL库标准方式
+#define LCD_PIN_SET(pin, pos)   HAL_GPIO_WritePin(LCD_CTRL, (pin), GPIO_PIN_SET)
+#define LCD_PIN_CLR(pin, pos)   HAL_GPIO_WritePin(LCD_CTRL, (pin), GPIO_PIN_RESET)
+#endif
+
+//LCD控制口置1操作语句宏定义
+#define	LCD_SCL_SET     LCD_PIN_SET(LCD_SCL, LCD_SCL_POS)
+#define	LCD_SDA_SET     LCD_PIN_SET(LCD_SDA, LCD_SDA_POS)
+#define	LCD_CS_SET      LCD_PIN_SET(LCD_CS, LCD_CS_POS)
+#define	LCD_BLK_SET     LCD_PIN_SET(LCD_BLK, LCD_BLK_POS)
+#define	LCD_DC_SET      LCD_PIN_SET(LCD_DC, LCD_DC_POS)
+#define	LCD_RES_SET     LCD_PIN_SET(LCD_RES, LCD_RES_POS)
 
 //LCD控制口置0操作语句宏定义
-#define	LCD_SCL_CLR     HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_RESET)  
-#define	LCD_SDA_CLR     HAL_GPIO_WritePin(LCD_CTRL, LCD_SDA, GPIO_PIN_RESET) 
-#define	LCD_CS_CLR      HAL_GPIO_WritePin(LCD_CTRL, LCD_CS, GPIO_PIN_RESET) 
-#define	LCD_BLK_CLR     HAL_GPIO_WritePin(LCD_CTRL, LCD_BLK, GPIO_PIN_RESET) 
-#define	LCD_RES_CLR     HAL_GPIO_WritePin(LCD_CTRL, LCD_RES, GPIO_PIN_RESET)
-#define	LCD_DC_CLR      HAL_GPIO_WritePin(LCD_CTRL, LCD_DC, GPIO_PIN_RESET)
+#define	LCD_SCL_CLR     LCD_PIN_CLR(LCD_SCL, LCD_SCL_POS)
+#define	LCD_SDA_CLR     LCD_PIN_CLR(LCD_SDA, LCD_SDA_POS)
+#define	LCD_CS_CLR      LCD_PIN_CLR(LCD_CS, LCD_CS_POS)
+#define	LCD_BLK_CLR     LCD_PIN_CLR(LCD_BLK, LCD_BLK_POS)
+#define	LCD_RES_CLR     LCD_PIN_CLR(LCD_RES, LCD_RES_POS)
+#define	LCD_DC_CLR      LCD_PIN_CLR(LCD_DC, LCD_DC_POS)
 
 // 为了兼容旧代码，保留旧的宏定义
 #define LCD_LED_SET     LCD_BLK_SET
@@ -70,23 +99,91 @@ LCD_CS_SET;\
 
 
 
+/**
+ * @brief LCD发送统计（所有字节都经过lcd_Driver.c中的LCD_Tx*计数）
+ */
+typedef struct
+{
+    uint32_t selects;       /**< CS拉低次数（SPI事务数） */
+    uint32_t commands;      /**< 命令个数 */
+    uint32_t cmd_bytes;     /**< 命令字节数（DC=0） */
+    uint32_t param_bytes;   /**< 命令参数字节数（DC=1，非像素） */
+    uint32_t pixel_bytes;   /**< 像素字节数 */
+    uint32_t windows;       /**< 请求的显存窗口数 */
+    uint32_t continued;     /**< 直接接续控制器当前写入、没有发送任何命令的窗口数 */
+    uint32_t saved_bytes;   /**< 窗口缓存省下的命令+参数字节数 */
+    uint32_t frame_saved_bytes; /**< 上一帧（两次Lcd_Flush之间）省下的字节数 */
+} LCD_Stats_t;
+
 // ST7735 LCD驱动函数声明
 void LCD_GPIO_Init(void);
 void LCD_SPI_Init(void);
 void Lcd_WriteCommand(uint8_t cmd);
 void Lcd_WriteData(uint8_t data);
 void Lcd_WriteData_16Bit(uint16_t data);
+void LCD_WriteData_16Bit(uint16_t Data);
 void Lcd_Reset(void);
 void Lcd_Init(void);
 void Lcd_Clear(uint16_t Color);
 void Lcd_SetXY(uint16_t x, uint16_t y);
 void Lcd_SetRegion(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end);
 void Gui_DrawPoint(uint16_t x, uint16_t y, uint16_t Color);
+void Lcd_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Color);
+void Lcd_DrawHLine(uint16_t x, uint16_t y, uint16_t w, uint16_t Color);
+void Lcd_DrawVLine(uint16_t x, uint16_t y, uint16_t h, uint16_t Color);
+
+// 像素流：窗口内连续写像素，期间CS保持选中
+void Lcd_BeginWindow(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end);
+void Lcd_WritePixel(uint16_t Color);
+void Lcd_WritePixels(const uint16_t *colors, uint32_t count);
+void Lcd_FillPixels(uint16_t Color, uint32_t count);
+void Lcd_WritePixelBytes(const uint8_t *data, uint32_t count);
+void Lcd_EndWindow(void);
+
+// 乒乓缓冲：填充一块的同时DMA发送另一块（见lcd_Pipe.h）
+uint16_t *Lcd_AcquirePixels(void);
+void Lcd_CommitPixels(uint16_t *buf, uint32_t count);
+
+void Lcd_PushRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *src, uint16_t stride);
+
+// 显示缓冲（LCD_FB_MODE != LCD_FB_NONE时发送变化区域，否则为空操作）
+void Lcd_Flush(void);
+
+// 硬件垂直滚动（VSCRDEF/VSCSAD）：滚动只发一条命令，滚动区内的绘图坐标由驱动换算
+uint8_t Lcd_ScrollArea(uint16_t y, uint16_t h);
+void Lcd_ScrollTo(uint16_t offset);
+void Lcd_Scroll(int16_t lines);
+uint16_t Lcd_ScrollOffset(void);
+
 void LCD_DisplayOn(void);
 void LCD_DisplayOff(void);
 void LCD_BacklightOn(void);
 void LCD_BacklightOff(void);
 
+// 传输层切换
+void LCD_SetTransport(const LCD_Transport_t *transport);
+const LCD_Transport_t *LCD_GetTransport(void);
+
+// 发送统计
+const LCD_Stats_t *LCD_GetStats(void);
+void LCD_ResetStats(void);
+
+/**
+ * @brief 软件SPI吞吐量测试结果（DWT周期计数）
+ */
+typedef struct
+{
+    uint32_t bytes;             /**< 每种方式发送的字节数 */
+    uint32_t hal_cycles;        /**< HAL_GPIO_WritePin方式耗费的CPU周期 */
+    uint32_t bsrr_cycles;       /**< BSRR后端耗费的CPU周期 */
+    uint32_t bitband_cycles;    /**< 位带后端耗费的CPU周期 */
+    uint32_t hal_bps;           /**< HAL方式 位/秒 */
+    uint32_t bsrr_bps;          /**< BSRR后端 位/秒 */
+    uint32_t bitband_bps;       /**< 位带后端 位/秒 */
+} LCD_SoftSPIBench_t;
+
+void LCD_SoftSPI_Benchmark(uint32_t bytes, LCD_SoftSPIBench_t *result);
+
 // 兼容旧接口
 void Lcd_WriteIndex(uint8_t Index);
 void Lcd_WriteReg(uint8_t Index, uint8_t Data);
@@ -0,0 +1,85 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Framebuffer.h
+ * @brief          : 显示缓冲（离屏绘图目标）
+ *                   LCD_FB_MODE != LCD_FB_NONE 时，lcd_Driver.c 把窗口/填充/画点
+ *                   全部转到这里，GUI.c 的函数无需修改即在RAM中绘图，
+ *                   最后由 Lcd_Flush() 一次性发送到LCD
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * LCD_FB_FULL（lcd_Framebuffer.c）：
+ * - 全屏 uint16_t[Y_MAX_PIXEL][X_MAX_PIXEL] 显存
+ * - 写入时逐像素比较，只有颜色真正改变的像素才计入脏矩形
+ * - 脏矩形相交或相邻时合并，Lcd_Flush 每个矩形只开一次窗口
+ * - Lcd_ReadPoint 直接读显存
+ *
+ * LCD_FB_BAND（lcd_Band.c）：
+ * - 只记录绘图操作（纯色填充 / 窗口像素，像素数据拷贝到LCD_BAND_ARENA中）
+ * - Lcd_Flush 时按 LCD_BAND_LINES 行一条带光栅化，没有操作覆盖的条带直接跳过
+ * - 条带内只发送被操作覆盖的像素：逐行求覆盖段，上下相同的段合并为一个矩形，每个矩形一次开窗
+ * - 操作表或像素缓冲用满时提前光栅化发送，对调用方透明
+ * - 不保存屏幕内容，Lcd_ReadPoint 只能读到本次Flush之前记录的像素，其余返回0
+ ******************************************************************************
+ */
+
+#ifndef __LCD_FRAMEBUFFER_H
+#define __LCD_FRAMEBUFFER_H
+
+#include <stdint.h>
+#include "LCD_Config.h"
+
+/**
+ * @brief 矩形（闭区间，屏幕坐标）
+ */
+typedef struct
+{
+    uint16_t x0;
+    uint16_t y0;
+    uint16_t x1;
+    uint16_t y1;
+} LCD_Rect_t;
+
+/**
+ * @brief 显示缓冲统计
+ */
+typedef struct
+{
+    uint32_t flushes;       /**< 实际发送过数据的Lcd_Flush次数 */
+    uint32_t rects;         /**< 发送的矩形数（每个一次开窗） */
+    uint32_t pixels;        /**< 发送的像素数 */
+    uint32_t merges;        /**< 脏矩形合并次数（FULL） */
+    uint32_t bands;         /**< 光栅化的条带数（BAND） */
+    uint32_t bands_skipped; /**< 没有操作覆盖而跳过的条带数（BAND） */
+    uint32_t early_flushes; /**< 操作表/像素缓冲满导致的提前发送次数（BAND） */
+} LCD_FB_Stats_t;
+
+#if (LCD_FB_MODE != LCD_FB_NONE)
+
+// 窗口写入（语义与Lcd_BeginWindow一致：行优先，写满后回到窗口起点；超出屏幕的像素丢弃）
+void LCD_FB_BeginWindow(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end);
+void LCD_FB_WritePixels(const uint16_t *colors, uint32_t count);
+void LCD_FB_FillPixels(uint16_t Color, uint32_t count);
+void LCD_FB_EndWindow(void);
+
+// 已裁剪到屏幕内的矩形填充/单点
+void LCD_FB_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Color);
+void LCD_FB_SetPixel(uint16_t x, uint16_t y, uint16_t Color);
+uint16_t LCD_FB_GetPixel(uint16_t x, uint16_t y);
+
+// 强制把一块区域标记为需要发送（例如上电后LCD显存内容未知）
+void LCD_FB_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+
+// 发送所有脏区域（由Lcd_Flush调用）
+void LCD_FB_Flush(void);
+
+// LCD硬件滚动后[y, y+h)行循环上移lines行，保持与屏幕一致（由Lcd_ScrollTo在Flush之后调用）
+void LCD_FB_Scroll(uint16_t y, uint16_t h, uint16_t lines);
+
+const LCD_FB_Stats_t *LCD_FB_GetStats(void);
+void LCD_FB_ResetStats(void);
+
+#endif /* LCD_FB_MODE */
+
+#endif /* __LCD_FRAMEBUFFER_H */
@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Mock.h
+ * @brief          : 记录型传输层（不接硬件）
+ *                   把驱动发出的每个字节连同DC电平记录下来，
+ *                   用于在主机端比较不同后端/不同实现发出的命令序列；
+ *                   只在主机端构建（tools/lcd_sim）中编译，不进固件
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ */
+
+#ifndef __LCD_MOCK_H
+#define __LCD_MOCK_H
+
+#include <stdint.h>
+#include "lcd_Transport.h"
+
+#ifndef LCD_MOCK_LOG_SIZE
+#define LCD_MOCK_LOG_SIZE   4096    // 逐字节记录的条目上限，超出后只累计统计和哈希
+#endif
+
+/**
+ * @brief 一个被记录的字节
+ */
+typedef struct
+{
+    uint8_t dc;     /**< 0=命令 1=数据 */
+    uint8_t byte;   /**< 发送的字节 */
+} LCD_MockEntry_t;
+
+/**
+ * @brief 记录统计
+ */
+typedef struct
+{
+    uint32_t bytes;         /**< 总字节数 */
+    uint32_t cmd_bytes;     /**< DC=0 字节数 */
+    uint32_t data_bytes;    /**< DC=1 字节数 */
+    uint32_t selects;       /**< CS下降沿次数（事务数） */
+    uint32_t hash;          /**< (dc,byte)流的FNV-1a哈希，两次运行哈希相同即字节流相同 */
+    uint32_t logged;        /**< 已写入日志的条目数（<=LCD_MOCK_LOG_SIZE） */
+} LCD_MockStats_t;
+
+void LCD_Mock_Reset(void);
+const LCD_MockStats_t *LCD_Mock_GetStats(void);
+const LCD_MockEntry_t *LCD_Mock_GetLog(void);
+
+#endif /* __LCD_MOCK_H */
@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Pipe.h
+ * @brief          : 像素发送流水线（乒乓缓冲）
+ *                   CPU填充一个缓冲区的同时，DMA发送另一个缓冲区
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 一般不直接使用，GUI通过lcd_Driver.h中的接口使用：
+ *   Lcd_BeginWindow(...);
+ *   buf = Lcd_AcquirePixels();          // 最多LCD_PIPE_BUF_PIXELS个像素
+ *   ...填充buf...
+ *   Lcd_CommitPixels(buf, n);           // 排队发送后立即返回，可以马上Acquire下一块
+ *   Lcd_EndWindow();                    // 等待全部发送完成再释放片选
+ * 缓冲区用DMA完成中断释放；统计中的周期数来自DWT，用于计算CPU渲染与SPI发送的重叠程度
+ ******************************************************************************
+ */
+
+#ifndef __LCD_PIPE_H
+#define __LCD_PIPE_H
+
+#include <stdint.h>
+#include "LCD_Config.h"
+
+/**
+ * @brief 流水线统计
+ */
+typedef struct
+{
+    uint32_t submits;       /**< 提交的缓冲区数 */
+    uint32_t pixels;        /**< 提交的像素数 */
+    uint32_t xfer_cycles;   /**< 缓冲区从开始发送到DMA完成的CPU周期累计 */
+    uint32_t wait_cycles;   /**< CPU等待空闲缓冲区/等待发送结束的周期累计 */
+} LCD_PipeStats_t;
+
+uint16_t *LCD_Pipe_Acquire(void);
+void LCD_Pipe_Submit(uint16_t *buf, uint32_t count);
+void LCD_Pipe_Release(uint16_t *buf);
+void LCD_Pipe_Drain(void);
+
+const LCD_PipeStats_t *LCD_Pipe_GetStats(void);
+void LCD_Pipe_ResetStats(void);
+uint8_t LCD_Pipe_OverlapPercent(void);
+
+#endif /* __LCD_PIPE_H */
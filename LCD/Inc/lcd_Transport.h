@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Transport.h
+ * @brief          : ST7735传输层接口
+ *                   把"CS/DC控制 + 字节发送"抽象成一组函数指针，
+ *                   lcd_Driver.c 只通过这一层访问硬件
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 可用后端：
+ * - LCD_Transport_SoftSPI : GPIO模拟SPI（备用方案，任何引脚都能用）
+ * - LCD_Transport_HwSPI   : 硬件SPI1 + DMA2 Stream3
+ * - LCD_Transport_Mock    : 不接硬件，只记录DC/字节流（见lcd_Mock.h，仅主机端构建）
+ ******************************************************************************
+ */
+
+#ifndef __LCD_TRANSPORT_H
+#define __LCD_TRANSPORT_H
+
+#include <stdint.h>
+#include "LCD_Config.h"
+
+/**
+ * @brief 传输层操作表
+ * @note  除Write16Async外所有操作都是阻塞的：函数返回后传入的缓冲区可以立即复用
+ */
+typedef struct
+{
+    const char *Name;                                   /**< 后端名称（调试输出用） */
+    void (*Init)(void);                                 /**< 初始化引脚/外设 */
+    void (*Select)(void);                               /**< CS=0，选中LCD */
+    void (*Deselect)(void);                             /**< 等待发送完成后CS=1 */
+    void (*SetDC)(uint8_t dc);                          /**< 0=命令 1=数据（等待发送完成后切换） */
+    void (*Write)(const uint8_t *buf, uint32_t len);    /**< 发送len个字节 */
+    void (*Write16)(const uint16_t *px, uint32_t count);/**< 发送count个16位像素（高字节先发） */
+    void (*Fill16)(uint16_t color, uint32_t count);     /**< 重复发送count个16位像素（高字节先发） */
+    void (*Write16Async)(const uint16_t *px, uint32_t count, void (*done)(void));
+                                                        /**< 启动发送后立即返回，缓冲区读完后调用done（可能在中断中）；
+                                                             阻塞型后端发送完直接调用done */
+} LCD_Transport_t;
+
+extern const LCD_Transport_t LCD_Transport_SoftSPI;
+#if LCD_HW_SPI_ENABLE
+extern const LCD_Transport_t LCD_Transport_HwSPI;
+#endif
+extern const LCD_Transport_t LCD_Transport_Mock;
+
+#endif /* __LCD_TRANSPORT_H */
@@ -10,6 +10,7 @@
  * 主要功能：
  * - 颜色转换处理
  * - 基本图形绘制（线条、圆形、矩形）
+ * - 填充图形（实心圆、圆角矩形、粗圆弧、环形仪表），按水平段输出
  * - 按钮视觉效果
  * - 数字和字符串显示
  * - 为上层应用提供便捷的绘图接口
@@ -20,6 +21,7 @@
 #include "lcd_Driver.h"  // 注意大小写
 #include "GUI.h"
 #include <stdio.h>  // 用于sprintf
+#include <string.h>
 #include "font.h"  
 
 /*==================================================================颜色处理类=========================================================================*/
@@ -38,7 +40,186 @@ uint16_t LCD_BGR2RGB(uint16_t c)
   return(rgb);
 }
 
+/*==================================================================裁剪区=========================================================================*/
+
+// 裁剪区栈：[0]为整个屏幕，Gui_PushClip压入与栈顶的交集
+static GUI_Rect_t gui_clip[GUI_CLIP_DEPTH + 1] = { { 0, 0, X_MAX_PIXEL, Y_MAX_PIXEL } };
+static uint8_t gui_clip_top = 0;
+
+/**
+ * @brief 求矩形与当前裁剪区的交集
+ * @param out 交集（可以为NULL，只判断是否可见）
+ * @return 1=有可见部分，0=完全在裁剪区外（或w/h为0）
+ */
+static uint8_t Gui_ClipBox(uint16_t x, uint16_t y, uint16_t w, uint16_t h, GUI_Rect_t *out)
+{
+    const GUI_Rect_t *c = &gui_clip[gui_clip_top];
+    uint32_t x1 = (uint32_t)x + w, y1 = (uint32_t)y + h;
+
+    if(w == 0 || h == 0 || x >= c->x1 || y >= c->y1 || x1 <= c->x0 || y1 <= c->y0) return 0;
+    if(out != NULL) {
+        out->x0 = (x > c->x0) ? x : c->x0;
+        out->y0 = (y > c->y0) ? y : c->y0;
+        out->x1 = (x1 < c->x1) ? (uint16_t)x1 : c->x1;
+        out->y1 = (y1 < c->y1) ? (uint16_t)y1 : c->y1;
+    }
+    return 1;
+}
+
+/**
+ * @brief 压入裁剪区：之后的绘图只画在(x,y,w,h)与当前裁剪区的交集内
+ * @return 1=成功，0=栈已满（裁剪区不变）
+ * @note 必须与Gui_PopClip成对使用；交集为空时之后的绘图全部丢弃
+ * @example Gui_PushClip(0, 110, 64, 16); Gui_DrawAsciiString(20, 110, ...); Gui_PopClip();
+ */
+uint8_t Gui_PushClip(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    GUI_Rect_t *next;
+
+    if(gui_clip_top >= GUI_CLIP_DEPTH) return 0;
+    next = &gui_clip[gui_clip_top + 1];
+    if(!Gui_ClipBox(x, y, w, h, next)) {
+        next->x0 = next->x1 = gui_clip[gui_clip_top].x0;   // 空裁剪区
+        next->y0 = next->y1 = gui_clip[gui_clip_top].y0;
+    }
+    gui_clip_top++;
+    return 1;
+}
+
+/**
+ * @brief 弹出裁剪区，恢复上一层（已在栈底时不变）
+ */
+void Gui_PopClip(void)
+{
+    if(gui_clip_top > 0) gui_clip_top--;
+}
+
+/**
+ * @brief 清空裁剪区栈，恢复为整个屏幕
+ */
+void Gui_ResetClip(void)
+{
+    gui_clip_top = 0;
+}
+
+/**
+ * @brief 当前裁剪区
+ */
+const GUI_Rect_t *Gui_GetClip(void)
+{
+    return &gui_clip[gui_clip_top];
+}
+
+/**
+ * @brief 填充矩形的可见部分
+ */
+static void Gui_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    GUI_Rect_t v;
+
+    if(!Gui_ClipBox(x, y, w, h, &v)) return;
+    Lcd_FillRect(v.x0, v.y0, v.x1 - v.x0, v.y1 - v.y0, color);
+}
+
+/**
+ * @brief 以一个窗口输出内存中一块像素（一行w个像素，连续存放）的可见部分
+ * @note 整块可见时一次写入；左右被裁掉时窗口只开可见的列，逐行写入
+ */
+static void Gui_BlitBlock(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *px)
+{
+    GUI_Rect_t v;
+    uint16_t vw, row;
+
+    if(!Gui_ClipBox(x, y, w, h, &v)) return;
+    vw = v.x1 - v.x0;
+    px += (uint32_t)(v.y0 - y) * w + (v.x0 - x);
+
+    Lcd_BeginWindow(v.x0, v.y0, v.x1 - 1, v.y1 - 1);
+    if(vw == w) {
+        Lcd_WritePixels(px, (uint32_t)w * (v.y1 - v.y0));
+    } else {
+        for(row = v.y0; row < v.y1; row++, px += w) Lcd_WritePixels(px, vw);
+    }
+    Lcd_EndWindow();
+}
+
+/*==================================================================线段合并（点 -> 水平/垂直段）=========================================================================*/
+
+#define SPAN_NONE   0   // 只有一个点，方向未定
+#define SPAN_H      1   // 水平段
+#define SPAN_V      2   // 垂直段
+
+// 正在累积的线段：连续输入的同色相邻点合并，颜色/方向/位置不接续时输出
+static struct {
+    uint16_t x0, y0, x1, y1;
+    uint16_t color;
+    uint8_t dir;
+    uint8_t open;
+} gui_span;
+
+/**
+ * @brief 输出正在累积的线段（一个窗口）
+ */
+static void Gui_SpanEnd(void)
+{
+    if(!gui_span.open) return;
+    gui_span.open = 0;
+
+    if(gui_span.dir == SPAN_V)
+        Lcd_DrawVLine(gui_span.x0, gui_span.y0, gui_span.y1 - gui_span.y0 + 1, gui_span.color);
+    else
+        Lcd_DrawHLine(gui_span.x0, gui_span.y0, gui_span.x1 - gui_span.x0 + 1, gui_span.color);
+}
+
+/**
+ * @brief 画一个点：与上一段同色且在其行/列的两端相邻时延长该段，否则先输出上一段
+ * @note 裁剪区外的点（包括负坐标）直接丢弃，线段因此总在裁剪区内；落在当前段内的同色点忽略
+ */
+static void Gui_SpanPoint(int x, int y, uint16_t color)
+{
+    const GUI_Rect_t *c = &gui_clip[gui_clip_top];
+
+    if(x < c->x0 || x >= c->x1 || y < c->y0 || y >= c->y1) return;
+
+    if(gui_span.open && gui_span.color == color) {
+        if(gui_span.dir != SPAN_V && y == gui_span.y0) {
+            if(x + 1 == gui_span.x0) { gui_span.x0 = x; gui_span.dir = SPAN_H; return; }
+            if(x == gui_span.x1 + 1) { gui_span.x1 = x; gui_span.dir = SPAN_H; return; }
+            if(x >= gui_span.x0 && x <= gui_span.x1) return;
+        }
+        if(gui_span.dir != SPAN_H && x == gui_span.x0) {
+            if(y + 1 == gui_span.y0) { gui_span.y0 = y; gui_span.dir = SPAN_V; return; }
+            if(y == gui_span.y1 + 1) { gui_span.y1 = y; gui_span.dir = SPAN_V; return; }
+            if(y >= gui_span.y0 && y <= gui_span.y1) return;
+        }
+    }
+
+    Gui_SpanEnd();
+    gui_span.x0 = gui_span.x1 = x;
+    gui_span.y0 = gui_span.y1 = y;
+    gui_span.color = color;
+    gui_span.dir = SPAN_NONE;
+    gui_span.open = 1;
+}
+
 /*==================================================================基础几何图形类=========================================================================*/
+/**
+ * @brief  圆的一个八分之一弧上的点（a从0增加到a==b）
+ */
+static void Gui_CirclePoint(int X, int Y, int a, int b, uint8_t octant, uint16_t fc)
+{
+    switch(octant) {
+        case 0: Gui_SpanPoint(X+a, Y+b, fc); break;
+        case 1: Gui_SpanPoint(X-a, Y+b, fc); break;
+        case 2: Gui_SpanPoint(X+a, Y-b, fc); break;
+        case 3: Gui_SpanPoint(X-a, Y-b, fc); break;
+        case 4: Gui_SpanPoint(X+b, Y+a, fc); break;
+        case 5: Gui_SpanPoint(X-b, Y+a, fc); break;
+        case 6: Gui_SpanPoint(X+b, Y-a, fc); break;
+        default: Gui_SpanPoint(X-b, Y-a, fc); break;
+    }
+}
+
 /**
  * @brief  绘制圆形（空心）
  * @param  X: 圆心X坐标
@@ -46,44 +227,42 @@ uint16_t LCD_BGR2RGB(uint16_t c)
  * @param  R: 圆的半径
  * @param  fc: 圆形边框颜色
  * @return 无
+ * @note   逐个八分圆输出，同一八分圆内相邻的点是连续的：
+ *         上下两端的弧合并成水平段，左右两侧的弧合并成垂直段；
+ *         坐标按有符号数计算，靠近屏幕边缘时伸出去的部分被裁掉，整个圆在裁剪区外时直接返回
  */
 void Gui_Circle(uint16_t X,uint16_t Y,uint16_t R,uint16_t fc) 
 {
-    unsigned short  a,b; 
+    int a,b; 
     int c; 
-    a=0; 
-    b=R; 
-    c=3-2*R; 
-    while (a<b) 
-    { 
-        Gui_DrawPoint(X+a,Y+b,fc);
-        Gui_DrawPoint(X-a,Y+b,fc);
-        Gui_DrawPoint(X+a,Y-b,fc);
-        Gui_DrawPoint(X-a,Y-b,fc);
-        Gui_DrawPoint(X+b,Y+a,fc);
-        Gui_DrawPoint(X-b,Y+a,fc);
-        Gui_DrawPoint(X+b,Y-a,fc);
-        Gui_DrawPoint(X-b,Y-a,fc);
-
-        if(c<0) c=c+4*a+6; 
-        else 
+    uint8_t octant;
+    const GUI_Rect_t *clip = &gui_clip[gui_clip_top];
+
+    if((int)X + R < clip->x0 || (int)X - R >= clip->x1 || (int)Y + R < clip->y0 || (int)Y - R >= clip->y1) return;
+
+    for(octant = 0; octant < 8; octant++)
+    {
+        a=0; 
+        b=R; 
+        c=3-2*R; 
+        while (a<b) 
         { 
-            c=c+4*(a-b)+10; 
-            b-=1; 
+            Gui_CirclePoint(X, Y, a, b, octant, fc);
+
+            if(c<0) c=c+4*a+6; 
+            else 
+            { 
+                c=c+4*(a-b)+10; 
+                b-=1; 
+            } 
+           a+=1; 
         } 
-       a+=1; 
-    } 
-    if (a==b) 
-    { 
-        Gui_DrawPoint(X+a,Y+b,fc); 
-        Gui_DrawPoint(X+a,Y+b,fc); 
-        Gui_DrawPoint(X+a,Y-b,fc); 
-        Gui_DrawPoint(X-a,Y-b,fc); 
-        Gui_DrawPoint(X+b,Y+a,fc); 
-        Gui_DrawPoint(X-b,Y+a,fc); 
-        Gui_DrawPoint(X+b,Y-a,fc); 
-        Gui_DrawPoint(X-b,Y-a,fc); 
-    } 
+        if (a==b) 
+        { 
+            Gui_CirclePoint(X, Y, a, b, octant, fc);
+        } 
+    }
+    Gui_SpanEnd();
 }
 
 /**
@@ -94,12 +273,22 @@ void Gui_Circle(uint16_t X,uint16_t Y,uint16_t R,uint16_t fc)
  * @param  y1: 终点Y坐标
  * @param  Color: 线条颜色
  * @return 无
+ * @note   斜线按Bresenham逐点合并：平缓的线每一级台阶一个水平段，陡峭的线每一级一个垂直段；
+ *         外接矩形在裁剪区外时直接返回
  */
 void Gui_DrawLine(uint16_t x0, uint16_t y0,uint16_t x1, uint16_t y1,uint16_t Color)   
 {
     int dx, dy, dx2, dy2, x_inc, y_inc, error, index;
+    uint16_t left = (x0 < x1) ? x0 : x1, top = (y0 < y1) ? y0 : y1;
+    uint16_t w = ((x0 < x1) ? (x1 - x0) : (x0 - x1)) + 1, h = ((y0 < y1) ? (y1 - y0) : (y0 - y1)) + 1;
+
+    // 水平/垂直线直接按一个窗口填充
+    if (y0 == y1 || x0 == x1) {
+        Gui_FillRect(left, top, w, h, Color);
+        return;
+    }
+    if (!Gui_ClipBox(left, top, w, h, NULL)) return;
 
-    Lcd_SetXY(x0,y0);
     dx = x1-x0;
     dy = y1-y0;
 
@@ -123,7 +312,7 @@ void Gui_DrawLine(uint16_t x0, uint16_t y0,uint16_t x1, uint16_t y1,uint16_t Col
     if (dx > dy) {
         error = dy2 - dx; 
         for (index=0; index <= dx; index++) {
-            Gui_DrawPoint(x0,y0,Color);
+            Gui_SpanPoint(x0,y0,Color);
             if (error >= 0) {
                 error-=dx2;
                 y0+=y_inc;
@@ -134,7 +323,7 @@ void Gui_DrawLine(uint16_t x0, uint16_t y0,uint16_t x1, uint16_t y1,uint16_t Col
     } else {
         error = dx2 - dy; 
         for (index=0; index <= dy; index++) {
-            Gui_DrawPoint(x0,y0,Color);
+            Gui_SpanPoint(x0,y0,Color);
             if (error >= 0) {
                 error-=dy2;
                 x0+=x_inc;
@@ -143,6 +332,7 @@ void Gui_DrawLine(uint16_t x0, uint16_t y0,uint16_t x1, uint16_t y1,uint16_t Col
             y0+=y_inc;
         }
     }
+    Gui_SpanEnd();
 }
 
 /*==================================================================矩形/框体类=========================================================================*/
@@ -163,11 +353,8 @@ void Gui_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h,uint16_t bc)
     Gui_DrawLine(x+w-1, y, x+w-1, y+h-1, 0x2965);  // 右边框（暗色-阴影效果）
     Gui_DrawLine(x, y+h-1, x+w-1, y+h-1, 0x2965);  // 下边框（暗色-阴影效果）
     
-    uint16_t i, j;
-    for(i = 1; i < h-1; i++) {
-        for(j = 1; j < w-1; j++) {
-            Gui_DrawPoint(x+j, y+i, bc);
-        }
+    if(w > 2 && h > 2) {
+        Gui_FillRect(x+1, y+1, w-2, h-2, bc);       // 内部填充
     }
 }
 
@@ -214,12 +401,8 @@ void Gui_box2(uint16_t x,uint16_t y,uint16_t w,uint16_t h, uint8_t mode)
  */
 void DisplayButtonDown(uint16_t x1,uint16_t y1,uint16_t x2,uint16_t y2)
 {
-    uint16_t i, j;
-    
-    for(i = y1+2; i < y2-1; i++) {
-        for(j = x1+2; j < x2-1; j++) {
-            Gui_DrawPoint(j, i, 0xC618);  // 按下状态的灰色背景
-        }
+    if(x2 > x1+3 && y2 > y1+3) {
+        Gui_FillRect(x1+2, y1+2, x2-x1-3, y2-y1-3, 0xC618);  // 按下状态的灰色背景
     }
     
     Gui_DrawLine(x1,  y1,  x2,y1, GRAY2);        // 上边框（暗色）
@@ -240,12 +423,8 @@ void DisplayButtonDown(uint16_t x1,uint16_t y1,uint16_t x2,uint16_t y2)
  */
 void DisplayButtonUp(uint16_t x1,uint16_t y1,uint16_t x2,uint16_t y2)
 {
-    uint16_t i, j;
-    
-    for(i = y1+2; i < y2-1; i++) {
-        for(j = x1+2; j < x2-1; j++) {
-            Gui_DrawPoint(j, i, 0xE71C);  // 弹起状态的浅灰色背景
-        }
+    if(x2 > x1+3 && y2 > y1+3) {
+        Gui_FillRect(x1+2, y1+2, x2-x1-3, y2-y1-3, 0xE71C);  // 弹起状态的浅灰色背景
     }
     Gui_DrawLine(x1,  y1,  x2,y1, WHITE);        // 上边框（亮色）
     Gui_DrawLine(x1,  y1,  x1,y2, WHITE);        // 左边框（亮色）
@@ -256,6 +435,751 @@ void DisplayButtonUp(uint16_t x1,uint16_t y1,uint16_t x2,uint16_t y2)
 }
 
 
+/*==================================================================填充图形/圆弧类=========================================================================*/
+
+// sin(0°..90°)，Q15定点（32767=1.0），其余象限由对称得到
+static const int16_t gui_sin_q15[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,  4560,  5126,
+     5690,  6252,  6813,  7371,  7927,  8481,  9032,  9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+    16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+    21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+    25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+    28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+    30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+    32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+    32767,
+};
+
+/**
+ * @brief  正弦（查表，整数角度）
+ * @param  deg: 角度（度），可以为负或大于360
+ * @return sin(deg)，Q15定点（-32767~32767）
+ */
+int16_t Gui_SinQ15(int16_t deg)
+{
+    int16_t d = deg % 360;
+
+    if(d < 0) d += 360;
+    if(d <= 90)  return gui_sin_q15[d];
+    if(d <= 180) return gui_sin_q15[180 - d];
+    if(d <= 270) return -gui_sin_q15[d - 180];
+    return -gui_sin_q15[360 - d];
+}
+
+/**
+ * @brief  余弦（查表），Q15定点
+ */
+int16_t Gui_CosQ15(int16_t deg)
+{
+    return Gui_SinQ15(deg + 90);
+}
+
+/**
+ * @brief  整数平方根（向下取整），逐位试商
+ */
+static uint16_t Gui_ISqrt(uint32_t v)
+{
+    uint32_t r = 0, bit = 1UL << 30;
+
+    while(bit > v) bit >>= 2;
+    while(bit) {
+        if(v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)r;
+}
+
+/**
+ * @brief  半径r的圆在距圆心dy行处的半宽（像素）
+ * @note   取到圆心距离小于r+0.5的像素：x^2 + dy^2 <= r^2 + r
+ */
+static uint16_t Gui_CircleHalfWidth(uint16_t r, int dy)
+{
+    return Gui_ISqrt((uint32_t)r * r + r - (uint32_t)(dy * dy));
+}
+
+/**
+ * @brief  画一条水平段（有符号坐标，裁剪后一个窗口）
+ */
+static void Gui_HSpan(int x0, int x1, int y, uint16_t color)
+{
+    const GUI_Rect_t *c = &gui_clip[gui_clip_top];
+
+    if(y < c->y0 || y >= c->y1) return;
+    if(x0 < c->x0) x0 = c->x0;
+    if(x1 >= c->x1) x1 = c->x1 - 1;
+    if(x0 > x1) return;
+    Lcd_FillRect(x0, y, x1 - x0 + 1, 1, color);
+}
+
+/**
+ * @brief  绘制实心圆
+ * @param  X: 圆心X坐标
+ * @param  Y: 圆心Y坐标
+ * @param  R: 半径
+ * @param  fc: 填充颜色
+ * @note   每行一个水平段、一个窗口（2R+1个窗口），不逐点发送；伸出裁剪区的部分被裁掉
+ */
+void Gui_FillCircle(uint16_t X, uint16_t Y, uint16_t R, uint16_t fc)
+{
+    const GUI_Rect_t *clip = &gui_clip[gui_clip_top];
+    int dy;
+    uint16_t hw;
+
+    if((int)X + R < clip->x0 || (int)X - R >= clip->x1 || (int)Y + R < clip->y0 || (int)Y - R >= clip->y1) return;
+
+    for(dy = -(int)R; dy <= (int)R; dy++) {
+        hw = Gui_CircleHalfWidth(R, dy);
+        Gui_HSpan((int)X - hw, (int)X + hw, (int)Y + dy, fc);
+    }
+}
+
+/**
+ * @brief  绘制实心圆角矩形
+ * @param  x: 左上角X坐标
+ * @param  y: 左上角Y坐标
+ * @param  w: 宽度
+ * @param  h: 高度
+ * @param  r: 圆角半径（超过短边的一半时减小）
+ * @param  fc: 填充颜色
+ * @note   中间的直边部分一个窗口，上下圆角每行一个水平段
+ */
+void Gui_FillRoundRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t r, uint16_t fc)
+{
+    uint16_t hw, side = (w < h) ? w : h;
+    int dy;
+
+    if(!Gui_ClipBox(x, y, w, h, NULL)) return;
+    if(side > 0 && r > (side - 1) / 2) r = (side - 1) / 2;
+
+    Gui_FillRect(x, y + r, w, h - 2 * r, fc);
+    for(dy = 1; dy <= (int)r; dy++) {
+        hw = Gui_CircleHalfWidth(r, dy);
+        Gui_HSpan(x + r - hw, x + w - 1 - r + hw, y + r - dy, fc);              // 上圆角
+        Gui_HSpan(x + r - hw, x + w - 1 - r + hw, y + h - 1 - r + dy, fc);      // 下圆角
+    }
+}
+
+// 扇形边界：从12点方向顺时针的角度对应的方向（屏幕坐标，y向下），Q15
+typedef struct {
+    int32_t x, y;
+} Gui_Dir_t;
+
+static Gui_Dir_t Gui_AngleDir(int16_t deg)
+{
+    Gui_Dir_t d = { Gui_SinQ15(deg), -Gui_CosQ15(deg) };
+    return d;
+}
+
+/**
+ * @brief  点(dx,dy)是否在方向u顺时针的半开半平面[u, u+180°)内
+ */
+static uint8_t Gui_DirSide(Gui_Dir_t u, int dx, int dy)
+{
+    int32_t cross = u.x * dy - u.y * dx;
+
+    return cross > 0 || (cross == 0 && u.x * dx + u.y * dy > 0);
+}
+
+/**
+ * @brief  画一段行内的水平段中落在扇形[a0, a0+sweep)内的部分
+ * @param  u0,u1: 起止方向；sweep>=360时不判断角度
+ * @note   逐像素判断角度（只有整数乘法），连续在扇形内的像素合并成一个水平段
+ */
+static void Gui_SectorSpan(int X, int Y, int x0, int x1, int dy, Gui_Dir_t u0, Gui_Dir_t u1, uint16_t sweep, uint16_t fc)
+{
+    int dx, run = 0;
+    uint8_t in;
+
+    if(sweep >= 360) {
+        Gui_HSpan(X + x0, X + x1, Y + dy, fc);
+        return;
+    }
+    for(dx = x0; dx <= x1 + 1; dx++) {
+        if(dx > x1) in = 0;
+        else if(sweep <= 180) in = Gui_DirSide(u0, dx, dy) && !Gui_DirSide(u1, dx, dy);
+        else in = Gui_DirSide(u0, dx, dy) || !Gui_DirSide(u1, dx, dy);
+
+        if(in && !run) {
+            run = 1;
+            x0 = dx;
+        } else if(!in && run) {
+            run = 0;
+            Gui_HSpan(X + x0, X + dx - 1, Y + dy, fc);
+        }
+    }
+}
+
+/**
+ * @brief  绘制粗圆弧（圆环的一段）
+ * @param  X: 圆心X坐标
+ * @param  Y: 圆心Y坐标
+ * @param  R: 外半径
+ * @param  thick: 宽度（像素），>=R+1时为实心扇形
+ * @param  start: 起始角度（度），0=12点方向，顺时针增加
+ * @param  sweep: 圆弧跨过的角度（度），>=360为整个圆环
+ * @param  fc: 颜色
+ * @note   逐行求出圆环的一段或两段，再截取扇形内的部分，每段一个窗口；
+ *         扇形为半开区间[start, start+sweep)，首尾相接的两段圆弧不重叠也没有缝隙
+ */
+void Gui_Arc(uint16_t X, uint16_t Y, uint16_t R, uint16_t thick, int16_t start, uint16_t sweep, uint16_t fc)
+{
+    uint16_t ri = (thick > R) ? 0 : R + 1 - thick;     // 内半径，0=没有内孔
+    Gui_Dir_t u0 = Gui_AngleDir(start), u1 = Gui_AngleDir(start + (int16_t)(sweep % 360));
+    const GUI_Rect_t *clip = &gui_clip[gui_clip_top];
+    int dy, ho, hi;
+
+    if(sweep == 0 || thick == 0) return;
+    if((int)X + R < clip->x0 || (int)X - R >= clip->x1 || (int)Y + R < clip->y0 || (int)Y - R >= clip->y1) return;
+
+    for(dy = -(int)R; dy <= (int)R; dy++) {
+        if((int)Y + dy < clip->y0 || (int)Y + dy >= clip->y1) continue;
+        ho = Gui_CircleHalfWidth(R, dy);
+
+        // 内孔：到圆心距离小于ri-0.5的像素，x^2 + dy^2 <= ri^2 - ri（这一行没有内孔时为-1）
+        hi = -1;
+        if(ri > 0 && (int32_t)ri * ri - ri - dy * dy >= 0)
+            hi = Gui_ISqrt((uint32_t)((int32_t)ri * ri - ri - dy * dy));
+
+        if(hi < 0) {
+            Gui_SectorSpan(X, Y, -ho, ho, dy, u0, u1, sweep, fc);
+        } else {
+            Gui_SectorSpan(X, Y, -ho, -hi - 1, dy, u0, u1, sweep, fc);
+            Gui_SectorSpan(X, Y, hi + 1, ho, dy, u0, u1, sweep, fc);
+        }
+    }
+}
+
+/**
+ * @brief  绘制环形仪表（例如湿度环）
+ * @param  X, Y: 圆心坐标
+ * @param  R: 外半径
+ * @param  thick: 环宽（像素）
+ * @param  start: 0刻度的角度（度，0=12点方向，顺时针）
+ * @param  sweep: 满刻度跨过的角度（度，<=360）
+ * @param  value: 当前值（大于max时按max）
+ * @param  max: 满刻度值
+ * @param  fc: 已到达部分的颜色
+ * @param  bc: 剩余部分（轨道）的颜色
+ * @note   两段圆弧首尾相接，每个像素只发送一次；数值变化时也可以只用Gui_Arc重画变化的一段
+ * @example Gui_Gauge(64, 80, 30, 6, 225, 270, humidity, 100, BLUE, GRAY2);
+ */
+void Gui_Gauge(uint16_t X, uint16_t Y, uint16_t R, uint16_t thick, int16_t start, uint16_t sweep,
+               uint16_t value, uint16_t max, uint16_t fc, uint16_t bc)
+{
+    uint16_t split;
+
+    if(max == 0) return;
+    if(value > max) value = max;
+    split = (uint16_t)((uint32_t)sweep * value / max);
+
+    Gui_Arc(X, Y, R, thick, start, split, fc);
+    Gui_Arc(X, Y, R, thick, start + split, sweep - split, bc);
+}
+
+/*==================================================================点阵输出（字模公共部分）=========================================================================*/
+
+// 半字节展开表：4位点阵 -> 4个像素，只在前景/背景色变化时重建
+static uint16_t glyph_lut[16][4];
+static uint16_t glyph_lut_fc, glyph_lut_bc;
+static uint8_t glyph_lut_valid = 0;
+
+/**
+ * @brief 按前景/背景色准备半字节展开表
+ * @note 同一颜色组合连续画字（一整行文字）时只计算一次
+ */
+static void Gui_GlyphLut(uint16_t fc, uint16_t bc)
+{
+    uint8_t n, b;
+
+    if(glyph_lut_valid && glyph_lut_fc == fc && glyph_lut_bc == bc) return;
+
+    for(n = 0; n < 16; n++) {
+        for(b = 0; b < 4; b++) {
+            glyph_lut[n][b] = (n & (0x08 >> b)) ? fc : bc;
+        }
+    }
+    glyph_lut_fc = fc;
+    glyph_lut_bc = bc;
+    glyph_lut_valid = 1;
+}
+
+/**
+ * @brief 展开一行点阵：整字节查表，每字节两次拷贝4个像素；不足8位的尾部逐位处理
+ */
+static uint16_t *Gui_ExpandRow(uint16_t *dst, const uint8_t *p, uint16_t w, uint16_t fc, uint16_t bc)
+{
+    uint16_t col;
+    uint8_t v;
+
+    for(col = 0; col + 8 <= w; col += 8) {
+        v = *p++;
+        memcpy(dst, glyph_lut[v >> 4], sizeof(glyph_lut[0]));
+        memcpy(dst + 4, glyph_lut[v & 0x0F], sizeof(glyph_lut[0]));
+        dst += 8;
+    }
+    for(; col < w; col++) {
+        *dst++ = (p[0] & (0x80 >> (col & 7))) ? fc : bc;
+    }
+    return dst;
+}
+
+// 抗锯齿字形的混合表：灰度值 -> RGB565，只在前景/背景色或灰度位数变化时重建
+static uint16_t aa_lut[16];
+static uint16_t aa_lut_fc, aa_lut_bc;
+static uint8_t aa_lut_bpp = 0;      // 0=无效
+
+/**
+ * @brief 按前景/背景色准备2/4位灰度的混合表
+ * @note R/G/B分量按灰度比例线性混合；文字总是用固定的一对颜色画，
+ *       整行文字只计算一次，之后每个像素只查一次表，不做乘法
+ */
+static void Gui_AALut(uint16_t fc, uint16_t bc, uint8_t bpp)
+{
+    uint8_t max = (1 << bpp) - 1;
+    uint8_t a;
+    uint16_t r, g, b;
+
+    if(aa_lut_bpp == bpp && aa_lut_fc == fc && aa_lut_bc == bc) return;
+
+    for(a = 0; a <= max; a++) {
+        r = ((fc >> 11) * a + (bc >> 11) * (max - a) + max / 2) / max;
+        g = (((fc >> 5) & 0x3F) * a + ((bc >> 5) & 0x3F) * (max - a) + max / 2) / max;
+        b = ((fc & 0x1F) * a + (bc & 0x1F) * (max - a) + max / 2) / max;
+        aa_lut[a] = (r << 11) | (g << 5) | b;
+    }
+    aa_lut_fc = fc;
+    aa_lut_bc = bc;
+    aa_lut_bpp = bpp;
+}
+
+/**
+ * @brief 展开一行2/4位灰度点阵：每个像素查一次混合表
+ */
+static uint16_t *Gui_ExpandAARow(uint16_t *dst, const uint8_t *p, uint16_t w, uint8_t bpp)
+{
+    uint16_t col;
+    uint8_t v;
+
+    if(bpp == 4) {
+        for(col = 0; col + 2 <= w; col += 2) {
+            v = *p++;
+            *dst++ = aa_lut[v >> 4];
+            *dst++ = aa_lut[v & 0x0F];
+        }
+        if(col < w) *dst++ = aa_lut[*p >> 4];
+    } else {
+        for(col = 0; col + 4 <= w; col += 4) {
+            v = *p++;
+            dst[0] = aa_lut[v >> 6];
+            dst[1] = aa_lut[(v >> 4) & 0x03];
+            dst[2] = aa_lut[(v >> 2) & 0x03];
+            dst[3] = aa_lut[v & 0x03];
+            dst += 4;
+        }
+        for(; col < w; col++) {
+            *dst++ = aa_lut[(*p >> (6 - 2 * (col & 3))) & 0x03];
+        }
+    }
+    return dst;
+}
+
+/**
+ * @brief 展开n行点阵到dst（1位查半字节表，2/4位查混合表）
+ * @param stride dst中一行的像素数（连续存放时等于w，展开到整串文字的像素块中时为块宽）
+ */
+static void Gui_ExpandRows(uint16_t *dst, uint16_t stride, const uint8_t *bits, uint16_t w, uint16_t n, uint8_t bpp, uint16_t fc, uint16_t bc)
+{
+    uint16_t bytes_per_row = (w * bpp + 7) / 8;
+    uint16_t r;
+
+    if(bpp == 1) Gui_GlyphLut(fc, bc);
+    else Gui_AALut(fc, bc, bpp);
+
+    for(r = 0; r < n; r++, bits += bytes_per_row, dst += stride) {
+        if(bpp == 1) Gui_ExpandRow(dst, bits, w, fc, bc);
+        else Gui_ExpandAARow(dst, bits, w, bpp);
+    }
+}
+
+/**
+ * @brief 以一个窗口输出点阵（前景色和背景色都写）
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param w 点阵宽度（像素，最大32）
+ * @param h 点阵高度（像素）
+ * @param bits 点阵数据，每行(w*bpp+7)/8字节，高位在左
+ * @param bpp 每像素位数：1=单色，2/4=抗锯齿灰度
+ * @param fc 前景色
+ * @param bc 背景色
+ * @note 整个字模只设置一次窗口，CS在整个字模期间保持选中；点阵查表展开。
+ *       部分在裁剪区外时窗口只开可见部分：裁掉的行不展开，裁掉的列展开后在缓冲区内挤掉
+ */
+static void Gui_BlitGlyph(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *bits, uint8_t bpp, uint16_t fc, uint16_t bc)
+{
+    uint16_t bytes_per_row = (w * bpp + 7) / 8;
+    uint16_t rows_per_buf = LCD_PIPE_BUF_PIXELS / w;   // 一块缓冲区装几行
+    uint16_t row, n, k, vw, cx;
+    uint16_t *buf;
+    GUI_Rect_t v;
+
+    if(rows_per_buf == 0 || !Gui_ClipBox(x, y, w, h, &v)) return;
+    vw = v.x1 - v.x0;
+    cx = v.x0 - x;
+
+    Lcd_BeginWindow(v.x0, v.y0, v.x1 - 1, v.y1 - 1);
+    for(row = v.y0 - y; row < v.y1 - y; row += n) {
+        n = (v.y1 - y - row < rows_per_buf) ? (v.y1 - y - row) : rows_per_buf;
+
+        // 展开下一块时，上一块正在由DMA发送
+        buf = Lcd_AcquirePixels();
+        Gui_ExpandRows(buf, w, bits + row * bytes_per_row, w, n, bpp, fc, bc);
+        if(vw != w) {
+            for(k = 0; k < n; k++) memmove(buf + k * vw, buf + k * w + cx, vw * sizeof(uint16_t));
+        }
+        Lcd_CommitPixels(buf, (uint32_t)n * vw);
+    }
+    Lcd_EndWindow();
+}
+
+/**
+ * @brief 输出点阵的前景像素（透明背景，fc==bc时使用）
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param w 点阵宽度（像素）
+ * @param h 点阵高度（像素）
+ * @param bits 点阵数据，每行(w*bpp+7)/8字节，高位在左
+ * @param bpp 每像素位数
+ * @param fc 前景色
+ * @note 每行连续的前景点合并成一个水平段，背景像素不发送；
+ *       不知道底色无法混合，灰度点阵取过半的像素
+ */
+static void Gui_PlotGlyph(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *bits, uint8_t bpp, uint16_t fc)
+{
+    uint16_t bytes_per_row = (w * bpp + 7) / 8;
+    uint8_t max = (1 << bpp) - 1;
+    uint16_t row, col, bit;
+
+    for(row = 0; row < h; row++) {
+        const uint8_t *p = bits + row * bytes_per_row;
+        for(col = 0, bit = 0; col < w; col++, bit += bpp) {
+            if(((p[bit >> 3] >> (8 - bpp - (bit & 7))) & max) * 2 > max) {
+                Gui_SpanPoint(x + col, y + row, fc);
+            }
+        }
+    }
+    Gui_SpanEnd();
+}
+
+/**
+ * @brief 输出一个字模：有背景色时整块窗口输出，透明时只画前景点；完全在裁剪区外时不展开也不发送
+ */
+static void Gui_DrawGlyph(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t *bits, uint8_t bpp, uint16_t fc, uint16_t bc)
+{
+    if(!Gui_ClipBox(x, y, w, h, NULL)) return;     // 完全在裁剪区外
+    if(fc != bc)
+        Gui_BlitGlyph(x, y, w, h, bits, bpp, fc, bc);
+    else
+        Gui_PlotGlyph(x, y, w, h, bits, bpp, fc);
+}
+
+/*==================================================================字形缓存=========================================================================*/
+
+static GUI_GlyphCacheStats_t glyph_cache_stats;
+
+#if (GUI_GLYPH_CACHE_SLOTS > 0)
+// 一个按颜色展开好的字形；stamp越大越近用到，0=空
+typedef struct {
+    const FNT_Font_t *font;
+    uint16_t code;
+    uint16_t fc, bc;
+    uint32_t stamp;
+    uint16_t px[GUI_GLYPH_CACHE_PIXELS];
+} Gui_GlyphSlot_t;
+
+static Gui_GlyphSlot_t glyph_cache[GUI_GLYPH_CACHE_SLOTS];
+static uint32_t glyph_cache_clock = 0;
+#endif
+
+/**
+ * @brief 获取字形缓存的命中统计
+ */
+const GUI_GlyphCacheStats_t *Gui_GlyphCacheGetStats(void)
+{
+    return &glyph_cache_stats;
+}
+
+/**
+ * @brief 清空字形缓存和统计
+ * @note 字库扇区被重新写入后必须调用，否则会继续显示旧的字形
+ */
+void Gui_GlyphCacheReset(void)
+{
+#if (GUI_GLYPH_CACHE_SLOTS > 0)
+    memset(glyph_cache, 0, sizeof(glyph_cache));
+    glyph_cache_clock = 0;
+#endif
+    memset(&glyph_cache_stats, 0, sizeof(glyph_cache_stats));
+}
+
+/**
+ * @brief 输出字库中的一个字（单色或抗锯齿）
+ * @param x 左上角X坐标
+ * @param y 左上角Y坐标
+ * @param font 字库
+ * @param code Unicode码点
+ * @param fc 前景色
+ * @param bc 背景色
+ * @note 缓存中有同一字库、码点和颜色的字形时整块直接发送，省去二分查找和点阵展开；
+ *       否则查找、展开到最久没用的位置再发送。透明字形（fc==bc）只发前景点，不经过缓存；
+ *       完全在裁剪区外的字直接返回，部分可见时缓存整个字形、只发送可见部分
+ */
+static void Gui_DrawFontGlyph(uint16_t x, uint16_t y, const FNT_Font_t *font, uint32_t code, uint16_t fc, uint16_t bc)
+{
+    const uint8_t *glyph;
+#if (GUI_GLYPH_CACHE_SLOTS > 0)
+    Gui_GlyphSlot_t *slot, *victim = glyph_cache;
+#endif
+
+    if(!Gui_ClipBox(x, y, font->width, font->height, NULL)) return;    // 完全在裁剪区外：不查找也不占缓存
+
+#if (GUI_GLYPH_CACHE_SLOTS > 0)
+    if(fc != bc && font->width * font->height <= GUI_GLYPH_CACHE_PIXELS)
+    {
+        for(slot = glyph_cache; slot < glyph_cache + GUI_GLYPH_CACHE_SLOTS; slot++) {
+            if(slot->stamp && slot->font == font && slot->code == code && slot->fc == fc && slot->bc == bc) break;
+            if(slot->stamp < victim->stamp) victim = slot;
+        }
+
+        if(slot < glyph_cache + GUI_GLYPH_CACHE_SLOTS) {
+            glyph_cache_stats.hits++;
+        } else {
+            glyph_cache_stats.misses++;
+            glyph = FNT_FindGlyph(font, code);
+            if(glyph == NULL) return;   // 字库中没有的字不占缓存
+
+            if(victim->stamp) glyph_cache_stats.evictions++;
+            slot = victim;
+            Gui_ExpandRows(slot->px, font->width, glyph, font->width, font->height, font->bpp, fc, bc);
+            slot->font = font;
+            slot->code = (uint16_t)code;    // 找到的码点都不超过0xFFFF
+            slot->fc = fc;
+            slot->bc = bc;
+        }
+        slot->stamp = ++glyph_cache_clock;
+
+        // Lcd_WritePixels发送完才返回，之后覆盖这个位置是安全的
+        Gui_BlitBlock(x, y, font->width, font->height, slot->px);
+        return;
+    }
+#endif
+
+    if(fc != bc) glyph_cache_stats.misses++;   // 关闭缓存或字形过大时，每次都要查找展开
+    glyph = FNT_FindGlyph(font, code);
+    if(glyph != NULL)
+    {
+        Gui_DrawGlyph(x, y, font->width, font->height, glyph, font->bpp, fc, bc);
+    }
+}
+
+/*==================================================================字符串缓存=========================================================================*/
+
+static GUI_StringCacheStats_t str_cache_stats;
+
+#if (GUI_STRING_CACHE_BYTES > 0)
+// 一串已光栅化的文字；像素块在str_arena中按分配顺序紧密排列，stamp越大越近用到，0=空
+typedef struct {
+    const void *font;               // FNT_Font_t，只有ASCII的文字为ascii_font
+    uint16_t fc, bc;
+    uint16_t w, h;
+    uint16_t offset;                // 像素块在str_arena中的位置（像素）
+    uint32_t stamp;
+    char text[GUI_STRING_CACHE_TEXT];
+} Gui_StringEntry_t;
+
+static uint16_t str_arena[GUI_STRING_CACHE_BYTES / 2];
+static uint16_t str_arena_used = 0;     // 已分配的像素数
+static Gui_StringEntry_t str_cache[GUI_STRING_CACHE_ENTRIES];
+static uint32_t str_cache_clock = 0;
+
+/**
+ * @brief 按字符排布文字：dst为NULL时只计算宽度，否则把每个字展开到dst（一行stride像素）
+ * @param font 字库；NULL表示只有ASCII字符（ascii_font，GUI_FONT_AA=1时为ascii_aa）
+ * @return 文字宽度（像素）；有字库中没有的字时返回0（逐字画时那里保持原样，不能缓存成整块）
+ * @note 字体高度必须一致（调用方保证）
+ */
+static uint16_t Gui_RasterText(uint16_t *dst, uint16_t stride, const FNT_Font_t *font, const char *s, uint16_t fc, uint16_t bc)
+{
+    uint8_t font_has_ascii = (font != NULL && font->count > 0 && font->codes[0] < 0x80);
+    const uint8_t *bits;
+    uint16_t x = 0, gw, gh;
+    uint8_t bpp;
+    uint32_t code;
+
+    while(*s)
+    {
+        code = FNT_Utf8Next(&s);
+        if(code < 0x80 && !font_has_ascii) {
+#if GUI_FONT_AA
+            bits = FNT_FindGlyph(&ascii_aa, code);
+            bpp = ascii_aa.bpp;
+#else
+            bits = (code >= 0x20 && code <= 0x7E) ? ascii_font[code - 0x20] : NULL;
+            bpp = 1;
+#endif
+            gw = 8;
+            gh = 16;
+        } else {
+            bits = FNT_FindGlyph(font, code);
+            bpp = font->bpp;
+            gw = font->width;
+            gh = font->height;
+        }
+        if(bits == NULL) return 0;
+
+        if(dst != NULL) Gui_ExpandRows(dst + x, stride, bits, gw, gh, bpp, fc, bc);
+        x += gw;
+    }
+    return x;
+}
+
+/**
+ * @brief 找最久没用的表项
+ * @param used_only 1=只在已用的表项中找（调用方保证至少有一个），0=空表项优先
+ */
+static Gui_StringEntry_t *Gui_StringOldest(uint8_t used_only)
+{
+    Gui_StringEntry_t *oldest = NULL;
+    uint8_t i;
+
+    for(i = 0; i < GUI_STRING_CACHE_ENTRIES; i++) {
+        if(used_only && str_cache[i].stamp == 0) continue;
+        if(oldest == NULL || str_cache[i].stamp < oldest->stamp) oldest = &str_cache[i];
+    }
+    return oldest;
+}
+
+/**
+ * @brief 淘汰一个缓存项，后面的像素块前移补上空出的位置
+ */
+static void Gui_StringEvict(Gui_StringEntry_t *e)
+{
+    uint16_t size = e->w * e->h;
+    uint8_t i;
+
+    memmove(&str_arena[e->offset], &str_arena[e->offset + size],
+            (str_arena_used - e->offset - size) * sizeof(str_arena[0]));
+    str_arena_used -= size;
+    for(i = 0; i < GUI_STRING_CACHE_ENTRIES; i++) {
+        if(str_cache[i].stamp && str_cache[i].offset > e->offset)
+            str_cache[i].offset -= size;
+    }
+    e->stamp = 0;
+    str_cache_stats.evictions++;
+}
+#endif
+
+/**
+ * @brief 通过字符串缓存画一行文字
+ * @param font 字库；NULL表示只有ASCII字符
+ * @return 1=已画出（或完全在裁剪区外），0=不能缓存（透明、单个字、太长、有缺字或字高不一致），由调用方逐字画
+ * @note 命中时一次开窗直接发送缓存的像素块（部分在裁剪区外时只发送可见部分）；
+ *       未命中时光栅化到最久没用的位置再发送，空间不够时按最久没用的顺序淘汰
+ */
+static uint8_t Gui_DrawStringCached(uint16_t x, uint16_t y, const FNT_Font_t *font, const char *s, uint16_t fc, uint16_t bc)
+{
+#if (GUI_STRING_CACHE_BYTES > 0)
+    const void *key = (font != NULL) ? (const void *)font : (const void *)ascii_font;
+    const char *p = s;
+    Gui_StringEntry_t *e;
+    uint16_t w, h;
+    uint8_t i;
+
+    if(fc == bc || *s == '\0' || strlen(s) >= GUI_STRING_CACHE_TEXT) return 0;
+    FNT_Utf8Next(&p);
+    if(*p == '\0') return 0;       // 单个字交给字形缓存，整块没有好处
+    // ASCII用8x16字体补字时，字库的字高必须也是16
+    h = (font != NULL) ? font->height : 16;
+    if(font != NULL && h != 16 && !(font->count > 0 && font->codes[0] < 0x80)) return 0;
+
+    for(i = 0; i < GUI_STRING_CACHE_ENTRIES; i++) {
+        e = &str_cache[i];
+        if(e->stamp && e->font == key && e->fc == fc && e->bc == bc && strcmp(e->text, s) == 0) break;
+    }
+
+    if(i < GUI_STRING_CACHE_ENTRIES) {
+        if(!Gui_ClipBox(x, y, e->w, e->h, NULL)) return 1;     // 完全在裁剪区外
+        str_cache_stats.hits++;
+        str_cache_stats.bytes_saved += (uint32_t)e->w * e->h * 2;
+    } else {
+        w = Gui_RasterText(NULL, 0, font, s, fc, bc);
+        if(w == 0 || (uint32_t)w * h > sizeof(str_arena) / sizeof(str_arena[0])) return 0;
+        if(!Gui_ClipBox(x, y, w, h, NULL)) return 1;           // 完全在裁剪区外：不光栅化
+        str_cache_stats.misses++;
+
+        // 取一个空表项（没有时淘汰最久没用的），再按最久没用的顺序淘汰到像素块放得下
+        e = Gui_StringOldest(0);
+        if(e->stamp) Gui_StringEvict(e);
+        while(str_arena_used + (uint32_t)w * h > sizeof(str_arena) / sizeof(str_arena[0])) {
+            Gui_StringEvict(Gui_StringOldest(1));
+        }
+
+        e->font = key;
+        e->fc = fc;
+        e->bc = bc;
+        e->w = w;
+        e->h = h;
+        e->offset = str_arena_used;
+        strcpy(e->text, s);
+        str_arena_used += w * h;
+        Gui_RasterText(&str_arena[e->offset], w, font, s, fc, bc);
+    }
+    e->stamp = ++str_cache_clock;
+
+    Gui_BlitBlock(x, y, e->w, e->h, &str_arena[e->offset]);
+    return 1;
+#else
+    (void)x; (void)y; (void)font; (void)s; (void)fc; (void)bc;
+    return 0;
+#endif
+}
+
+/**
+ * @brief 获取字符串缓存的统计
+ */
+const GUI_StringCacheStats_t *Gui_StringCacheGetStats(void)
+{
+    return &str_cache_stats;
+}
+
+/**
+ * @brief 字符串缓存命中率（%），还没有查找时为0
+ */
+uint8_t Gui_StringCacheHitPercent(void)
+{
+    uint32_t total = str_cache_stats.hits + str_cache_stats.misses;
+    return total ? (uint8_t)((uint64_t)str_cache_stats.hits * 100 / total) : 0;
+}
+
+/**
+ * @brief 清空字符串缓存和统计
+ */
+void Gui_StringCacheReset(void)
+{
+#if (GUI_STRING_CACHE_BYTES > 0)
+    memset(str_cache, 0, sizeof(str_cache));
+    str_arena_used = 0;
+    str_cache_clock = 0;
+#endif
+    memset(&str_cache_stats, 0, sizeof(str_cache_stats));
+}
+
 /*================================================================== ASCII码显示类=========================================================================*/
 
 /**
@@ -269,27 +1193,20 @@ void DisplayButtonUp(uint16_t x1,uint16_t y1,uint16_t x2,uint16_t y2)
  * @param c 要显示的ASCII字符（0x20-0x7E）
  * @note 每个字符占用8x16=128像素，字模数据16字节
  * @note 支持字符范围：空格(' ')到波浪号('~')，共95个字符
- * @note 字模数据存储在ascii_font[]数组中
+ * @note 字模数据存储在ascii_font[]数组中；GUI_FONT_AA=1时使用4位灰度的ascii_aa字库
  * @example Gui_DrawAsciiChar(10, 20, WHITE, BLACK, 'A');
  */
 void Gui_DrawAsciiChar(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char c)
 {
     if(c < 0x20 || c > 0x7E) return;  // 只支持可打印ASCII字符
     
+#if GUI_FONT_AA
+    Gui_DrawFontGlyph(x, y, &ascii_aa, (uint8_t)c, fc, bc);
+#else
     int char_index = c - 0x20;  // 转换为字模数组索引(空格是第0个)
     
-    for(int row = 0; row < 16; row++) {
-        uint8_t line = ascii_font[char_index][row];  // 获取该行字模数据
-        for(int col = 0; col < 8; col++) {
-            if(line & (0x80 >> col)) {
-                Gui_DrawPoint(x + col, y + row, fc);  // 前景色
-            } else {
-                if(fc != bc) {
-                    Gui_DrawPoint(x + col, y + row, bc);  // 背景色
-                }
-            }
-        }
-    }
+    Gui_DrawGlyph(x, y, 8, 16, ascii_font[char_index], 1, fc, bc);
+#endif
 }
 
 /**
@@ -302,7 +1219,7 @@ void Gui_DrawAsciiChar(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char c)
  * @param bc 背景色，16位RGB565格式
  * @param str 要显示的字符串指针
  * @note 每个字符宽度8像素，高度16像素
- * @note 遇到'\n'自动换行，行高16像素
+ * @note 遇到'\n'自动换行，行高16像素；单行字符串经过字符串缓存，重复的文字一次开窗发送
  * @note 支持字符：字母、数字、标点符号、特殊符号等
  * @example Gui_DrawAsciiString(10, 20, WHITE, BLACK, "Hello World!");
  * @example Gui_DrawAsciiString(10, 20, RED, BLACK, "Temp: 25.6C\nHumi: 60%");
@@ -311,7 +1228,12 @@ void Gui_DrawAsciiString(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const
 {
     uint16_t pos_x = x;
     uint16_t pos_y = y;
+    int n;
     
+    // 单行可打印字符串整串经过字符串缓存
+    for(n = 0; str[n] >= 0x20 && str[n] <= 0x7E; n++);
+    if(str[n] == '\0' && Gui_DrawStringCached(x, y, NULL, str, fc, bc)) return;
+
     for(int i = 0; str[i] != '\0'; i++) {
         if(str[i] == '\n') {
             // 换行处理
@@ -366,140 +1288,91 @@ void Gui_DrawAsciiStringCenter(uint16_t x, uint16_t y, uint16_t width, uint16_t
 
 /*==================================================================中文字符显示类=========================================================================*/
 /**
- * @brief 显示16x16像素中文字符
- * @details 支持显示16x16像素的中文汉字，使用GB2312/GBK编码
- *          从hz16[]字模数组中查找对应字符的字模数据进行显示
+ * @brief 按字库显示UTF-8字符串
+ * @details 整串先查字符串缓存；不能缓存时逐字在font中按码点二分查找（经过字形缓存）。
+ *          font中没有ASCII字符时（hz16/hz24），ASCII字符用8x16字体
  * @param x 显示起始X坐标（左上角）
  * @param y 显示起始Y坐标（左上角）
  * @param fc 前景色（字体颜色），16位RGB565格式
- * @param bc 背景色，16位RGB565格式
- * @param s 指向要显示的中文字符串的指针
- * @note 每个中文字符占用16x16=256像素，字模数据32字节
- * @note 只能显示已定义在hz16[]数组中的字符
- * @example Gui_DrawFont_GBK16(10, 20, WHITE, BLACK, (uint8_t*)"孙涵");
+ * @param bc 背景色，16位RGB565格式，与fc相同时背景透明
+ * @param font 字库（hz16、hz24或其他FNT_Font_t）
+ * @param s UTF-8字符串
+ * @note 字库中没有的字符留出一个字宽的空位，不合法的UTF-8字节按一个缺字处理；
+ *       超出裁剪区右边的字不再解码
  */
-void Gui_DrawFont_GBK16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s)
+void Gui_DrawTextFont(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const FNT_Font_t *font, const char *s)
 {
-    unsigned char i,j;
-    unsigned short k,x0;
-    x0=x;
+    uint8_t font_has_ascii = (font->count > 0 && font->codes[0] < 0x80);   // 码点升序，看第一个即可
+    uint32_t code;
 
-    while(*s) 
-    {	
-        if((*s) < 0x80)  // ASCII字符
+    if(Gui_DrawStringCached(x, y, font, s, fc, bc)) return;
+
+    while(*s && x < gui_clip[gui_clip_top].x1)     // 后面的字都在裁剪区右边
+    {
+        code = FNT_Utf8Next(&s);
+        if(code < 0x80 && !font_has_ascii)  // ASCII字符，字库中没有时用8x16字体
         {
-            if(*s >= 0x20 && *s <= 0x7E) {
-                Gui_DrawAsciiChar(x, y, fc, bc, *s);
+            if(code >= 0x20 && code <= 0x7E) {
+                Gui_DrawAsciiChar(x, y, fc, bc, (char)code);
             }
             x += 8;  // ASCII字符宽度8像素
-            s++;
         }
-        else  // 中文字符
+        else  // 中文字符，或抗锯齿字库中的ASCII字符
         {
-            // 保持原来的中文显示逻辑不变
-            for (k=0;k<hz16_num;k++) 
-            {
-                if ((hz16[k].Index[0]==*(s))&&(hz16[k].Index[1]==*(s+1)))
-                { 
-                    for(i=0;i<16;i++)
-                    {
-                        for(j=0;j<8;j++) 
-                        {
-                            if(hz16[k].Msk[i*2]&(0x80>>j))
-                                Gui_DrawPoint(x+j,y+i,fc);
-                            else {
-                                if (fc!=bc) Gui_DrawPoint(x+j,y+i,bc);
-                            }
-                        }
-                        for(j=0;j<8;j++) 
-                        {
-                            if(hz16[k].Msk[i*2+1]&(0x80>>j))
-                                Gui_DrawPoint(x+j+8,y+i,fc);
-                            else 
-                            {
-                                if (fc!=bc) Gui_DrawPoint(x+j+8,y+i,bc);
-                            }
-                        }
-                    }
-                }
-            }
-            s+=2;
-            x+=16;  // 中文字符宽度16像素
-        } 
+            Gui_DrawFontGlyph(x, y, font, code, fc, bc);
+            x += font->width;
+        }
     }
 }
 
 /**
- * @brief 显示24x24像素中文字符
- * @details 支持显示24x24像素的大号中文汉字，使用GB2312/GBK编码
- *          从hz24[]字模数组中查找对应字符的字模数据进行显示
+ * @brief 显示16x16像素中英文混合字符串（UTF-8）
+ * @details 中文从hz16字库中按码点查找，可以直接显示天气接口返回的UTF-8文字
  * @param x 显示起始X坐标（左上角）
  * @param y 显示起始Y坐标（左上角）
  * @param fc 前景色（字体颜色），16位RGB565格式
  * @param bc 背景色，16位RGB565格式
- * @param s 指向要显示的中文字符串的指针
+ * @param s UTF-8字符串
+ * @note 每个中文字符占用16x16=256像素，字模数据32字节
+ * @note 只能显示assets/fonts/hz16.bdf中收录的字符
+ * @example Gui_DrawText16(10, 20, WHITE, BLACK, "孙涵");
+ */
+void Gui_DrawText16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s)
+{
+    Gui_DrawTextFont(x, y, fc, bc, &hz16, s);
+}
+
+/**
+ * @brief 显示24x24像素中文字符串（UTF-8）
+ * @details 中文从hz24字库中按码点查找，ASCII字符仍为8x16
+ * @param x 显示起始X坐标（左上角）
+ * @param y 显示起始Y坐标（左上角）
+ * @param fc 前景色（字体颜色），16位RGB565格式
+ * @param bc 背景色，16位RGB565格式
+ * @param s UTF-8字符串
  * @note 每个中文字符占用24x24=576像素，字模数据72字节
- * @note 只能显示已定义在hz24[]数组中的字符
  * @note 显示效果比16x16字体更加清晰，适合重要信息显示
- * @example Gui_DrawFont_GBK24(50, 100, RED, BLACK, (uint8_t*)"霖");
+ * @example Gui_DrawText24(50, 100, RED, BLACK, "霖");
  */
-void Gui_DrawFont_GBK24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s)
+void Gui_DrawText24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s)
+{
+    Gui_DrawTextFont(x, y, fc, bc, &hz24, s);
+}
+
+/**
+ * @brief 兼容旧接口：字库的索引一直是UTF-8（源文件编码），等同于Gui_DrawText16
+ */
+void Gui_DrawFont_GBK16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s)
 {
-    unsigned char i,j;
-    unsigned short k;
+    Gui_DrawText16(x, y, fc, bc, (const char *)s);
+}
 
-    while(*s) 
-    {
-        if(*s < 0x80)  // ASCII字符
-        {
-            if(*s >= 0x20 && *s <= 0x7E) {
-                Gui_DrawAsciiChar(x, y, fc, bc, *s);
-            }
-            x += 8;  // ASCII字符宽度8像素
-            s++;
-        }
-        else  // 中文字符
-        {
-            // 保持原来的中文显示逻辑不变
-            for (k=0;k<hz24_num;k++) 
-            {
-                if ((hz24[k].Index[0]==*(s))&&(hz24[k].Index[1]==*(s+1)))
-                { 
-                    for(i=0;i<24;i++)
-                    {
-                        for(j=0;j<8;j++) 
-                        {
-                            if(hz24[k].Msk[i*3]&(0x80>>j))
-                                Gui_DrawPoint(x+j,y+i,fc);
-                            else 
-                            {
-                                if (fc!=bc) Gui_DrawPoint(x+j,y+i,bc);
-                            }
-                        }
-                        for(j=0;j<8;j++) 
-                        {
-                            if(hz24[k].Msk[i*3+1]&(0x80>>j))
-                                Gui_DrawPoint(x+j+8,y+i,fc);
-                            else {
-                                if (fc!=bc) Gui_DrawPoint(x+j+8,y+i,bc);
-                            }
-                        }
-                        for(j=0;j<8;j++) 
-                        {
-                            if(hz24[k].Msk[i*3+2]&(0x80>>j))	
-                                Gui_DrawPoint(x+j+16,y+i,fc);
-                            else 
-                            {
-                                if (fc!=bc) Gui_DrawPoint(x+j+16,y+i,bc);
-                            }
-                        }
-                    }
-                }
-            }
-            s+=2;
-            x+=24;  // 中文字符宽度24像素
-        }
-    }
+/**
+ * @brief 兼容旧接口，等同于Gui_DrawText24
+ */
+void Gui_DrawFont_GBK24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_t *s)
+{
+    Gui_DrawText24(x, y, fc, bc, (const char *)s);
 }
 
 
@@ -515,31 +1388,20 @@ void Gui_DrawFont_GBK24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint8_
  * @param bc 背景色，16位RGB565格式
  * @param num 要显示的数字（0-9）
  * @note 每个数字占用32x32=1024像素，字模数据128字节
- * @note 数字字模数据存储在sz32[]数组中
+ * @note 数字字模数据存储在sz32[]数组中，只有前sz32_num个数字有字模，其余不显示；
+ *       GUI_FONT_AA=1时使用2位灰度的num32_aa字库（0-9）
  * @note 适合用于显示时钟时间、日期等重要数字信息
  * @example Gui_DrawFont_Num32(50, 100, WHITE, BLACK, 8); // 显示数字"8"
  */
 void Gui_DrawFont_Num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num)
 {
-	unsigned char i,j,k,c;
-	//lcd_text_any(x+94+i*42,y+34,32,32,0x7E8,0x0,sz32,knum[i]);
-//	w=w/8;
-
-    for(i=0;i<32;i++)
-	{
-		for(j=0;j<4;j++) 
-		{
-			c=*(sz32+num*32*4+i*4+j);
-			for (k=0;k<8;k++)	
-			{
-	
-		    	if(c&(0x80>>k))	Gui_DrawPoint(x+j*8+k,y+i,fc);
-				else {
-					if (fc!=bc) Gui_DrawPoint(x+j*8+k,y+i,bc);
-				}
-			}
-		}
-	}
+#if GUI_FONT_AA
+    if(num > 9) return;
+    Gui_DrawFontGlyph(x, y, &num32_aa, '0' + num, fc, bc);
+#else
+    if(num >= sz32_num) return;     // 字库中没有这个数字
+    Gui_DrawGlyph(x, y, 32, 32, sz32 + num*32*4, 1, fc, bc);
+#endif
 }
 
 /*==================================================================图片/位图显示类=========================================================================*/
@@ -554,20 +1416,13 @@ void Gui_DrawFont_Num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16
  * @param width 图片宽度（像素）
  * @param height 图片高度（像素）
  * @param bitmap 指向图片数据的指针，RGB565格式
- * @note 图片数据按行存储，每个像素2字节
+ * @note 图片数据按行存储，每个像素2字节；只发送裁剪区内的部分
  * @example Gui_DrawBitmap(10, 10, 32, 32, weather_icon);
  */
 void Gui_DrawBitmap(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint16_t *bitmap)
 {
-    uint16_t i, j;
-    
-    for(i = 0; i < height; i++)
-    {
-        for(j = 0; j < width; j++)
-        {
-            Gui_DrawPoint(x + j, y + i, bitmap[i * width + j]);
-        }
-    }
+    // 一个窗口连续写入全部可见像素
+    Gui_BlitBlock(x, y, width, height, bitmap);
 }
 
 /**
@@ -585,15 +1440,232 @@ void Gui_DrawIcon(uint16_t x, uint16_t y, uint16_t size, const uint16_t *icon_da
     Gui_DrawBitmap(x, y, size, size, icon_data);
 }
 
+// 图片解码：正在填充的流水线缓冲区，满一块就提交，解码下一块时DMA发送这一块；
+// 图片部分在裁剪区外时v为可见部分（相对图片左上角），窗口只开可见部分
+static struct {
+    uint16_t *buf;
+    uint32_t n;
+    uint16_t width;
+    GUI_Rect_t v;
+    uint16_t col, row;      // 行程编码裁剪时下一个像素的位置
+} gui_img;
+
+static inline void Gui_ImagePut(uint16_t color)
+{
+    if(gui_img.n == 0) gui_img.buf = Lcd_AcquirePixels();
+    gui_img.buf[gui_img.n++] = color;
+    if(gui_img.n == LCD_PIPE_BUF_PIXELS)
+    {
+        Lcd_CommitPixels(gui_img.buf, gui_img.n);
+        gui_img.n = 0;
+    }
+}
+
+static void Gui_ImageFill(uint16_t color, uint32_t count)
+{
+    uint32_t i, k;
+
+    while(count)
+    {
+        if(gui_img.n == 0) gui_img.buf = Lcd_AcquirePixels();
+        k = LCD_PIPE_BUF_PIXELS - gui_img.n;
+        if(k > count) k = count;
+        for(i = 0; i < k; i++) gui_img.buf[gui_img.n + i] = color;
+        gui_img.n += k;
+        count -= k;
+        if(gui_img.n == LCD_PIPE_BUF_PIXELS)
+        {
+            Lcd_CommitPixels(gui_img.buf, gui_img.n);
+            gui_img.n = 0;
+        }
+    }
+}
+
+static void Gui_ImageFlush(void)
+{
+    if(gui_img.n)
+    {
+        Lcd_CommitPixels(gui_img.buf, gui_img.n);
+        gui_img.n = 0;
+    }
+}
+
+/**
+ * @brief 行程编码裁剪时输出count个同色像素（可以跨行），只保留可见部分
+ */
+static void Gui_ImageClipFill(uint16_t color, uint32_t count)
+{
+    uint32_t n;
+    uint16_t a, b;
+
+    while(count)
+    {
+        n = gui_img.width - gui_img.col;
+        if(n > count) n = count;
+        if(gui_img.row >= gui_img.v.y0 && gui_img.row < gui_img.v.y1)
+        {
+            a = (gui_img.col > gui_img.v.x0) ? gui_img.col : gui_img.v.x0;
+            b = (gui_img.col + n < gui_img.v.x1) ? (uint16_t)(gui_img.col + n) : gui_img.v.x1;
+            if(a < b) Gui_ImageFill(color, b - a);
+        }
+        gui_img.col += n;
+        count -= n;
+        if(gui_img.col == gui_img.width)
+        {
+            gui_img.col = 0;
+            gui_img.row++;
+        }
+    }
+}
+
+// 读一个RGB565颜色，be=1时高字节在前
+#define GUI_RD16(p, be)     ((uint16_t)((be) ? (((p)[0] << 8) | (p)[1]) : ((p)[0] | ((p)[1] << 8))))
+// 调色板第i个颜色
+#define GUI_PAL(pal, i, be) GUI_RD16((pal) + 2 * (i), be)
+
+/**
+ * @brief 原始RGB565像素
+ * @note  高字节在前的数据与总线顺序相同，不经转换直接发送
+ */
+static void Gui_DecodeRaw(const uint8_t *src, uint32_t total, uint8_t be)
+{
+    uint32_t i, n;
+
+    if(be)
+    {
+        Lcd_WritePixelBytes(src, total);
+        return;
+    }
+
+    // 按缓冲区大小分段转换字节序，转换下一段时DMA发送上一段
+    while(total)
+    {
+        n = (total > LCD_PIPE_BUF_PIXELS) ? LCD_PIPE_BUF_PIXELS : total;
+        gui_img.buf = Lcd_AcquirePixels();
+        for(i = 0; i < n; i++)
+        {
+            gui_img.buf[i] = src[0] | (src[1] << 8);
+            src += 2;
+        }
+        Lcd_CommitPixels(gui_img.buf, n);
+        total -= n;
+    }
+}
+
+/**
+ * @brief 原始像素的可见部分：跳过裁掉的行，每行从可见的第一列开始
+ */
+static void Gui_DecodeRawClip(const uint8_t *src, uint8_t be)
+{
+    uint16_t vw = gui_img.v.x1 - gui_img.v.x0;
+    uint16_t row;
+
+    src += ((uint32_t)gui_img.v.y0 * gui_img.width + gui_img.v.x0) * 2;
+    for(row = gui_img.v.y0; row < gui_img.v.y1; row++)
+    {
+        Gui_DecodeRaw(src, vw, be);
+        src += (uint32_t)gui_img.width * 2;
+    }
+}
+
+/**
+ * @brief 调色板索引像素，每行从新的字节开始
+ * @note  每行可以直接定位，裁掉的行和列不解码
+ */
+static void Gui_DecodeIndexed(const uint8_t *image)
+{
+    uint8_t bpp = image[1];
+    uint8_t be = image[0] & GUI_IMAGE_BIG_ENDIAN;
+    uint8_t mask = (uint8_t)((1u << bpp) - 1);
+    const uint8_t *pal = image + 9;
+    uint16_t stride = (uint16_t)((gui_img.width * bpp + 7) / 8);
+    const uint8_t *row = pal + 2 * (image[8] + 1) + (uint32_t)gui_img.v.y0 * stride;
+    uint16_t col, row_n;
+    uint8_t byte, shift;
+
+    if(bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return;
+
+    for(row_n = gui_img.v.y0; row_n < gui_img.v.y1; row_n++)
+    {
+        col = gui_img.v.x0;
+        byte = row[col * bpp / 8];
+        shift = 8 - (col * bpp) % 8;
+        for(; col < gui_img.v.x1; col++)
+        {
+            if(shift == 0)
+            {
+                byte = row[col * bpp / 8];
+                shift = 8;
+            }
+            shift -= bpp;
+            Gui_ImagePut(GUI_PAL(pal, (byte >> shift) & mask, be));
+        }
+        row += stride;
+    }
+    Gui_ImageFlush();
+}
+
+/**
+ * @brief 行程编码像素（RGB565或8位调色板索引），包可以跨行
+ * @param clip 1=图片部分在裁剪区外：必须顺序解码，只输出可见的像素，过了最后一个可见行就停止
+ * @note  重复包直接填充缓冲区，不再逐像素读取数据
+ */
+static void Gui_DecodeRle(const uint8_t *image, uint32_t total, uint8_t clip)
+{
+    const uint8_t *pal = NULL;
+    const uint8_t *src = image + 8;
+    uint8_t be = image[0] & GUI_IMAGE_BIG_ENDIAN;
+    uint32_t n;
+    uint16_t color;
+
+    gui_img.col = 0;
+    gui_img.row = 0;
+
+    if(image[1] == 8)
+    {
+        pal = image + 9;
+        src = pal + 2 * (image[8] + 1);
+    }
+
+    while(total && !(clip && gui_img.row >= gui_img.v.y1))
+    {
+        n = (*src & 0x80) ? (uint32_t)(*src - 0x7F) : (uint32_t)(*src + 1);
+        if(n > total) n = total;    // 数据比图片大时截断
+        total -= n;
+
+        if(*src++ & 0x80)
+        {
+            color = pal ? GUI_PAL(pal, src[0], be) : GUI_RD16(src, be);
+            src += pal ? 1 : 2;
+            if(clip) Gui_ImageClipFill(color, n);
+            else Gui_ImageFill(color, n);
+        }
+        else
+        {
+            while(n--)
+            {
+                color = pal ? GUI_PAL(pal, src[0], be) : GUI_RD16(src, be);
+                src += pal ? 1 : 2;
+                if(clip) Gui_ImageClipFill(color, 1);
+                else Gui_ImagePut(color);
+            }
+        }
+    }
+    Gui_ImageFlush();
+}
+
 /**
  * @brief 显示带头信息的图片数据
  * @details 显示包含头信息的图片数据，自动解析图片尺寸和格式
- *          支持常见的图片转换工具生成的数据格式
+ *          支持Image2Lcd生成的原始RGB565数据，以及调色板、行程编码压缩格式（见GUI.h中的GUI_IMAGE_*）
  * @param x 显示起始X坐标（左上角）
  * @param y 显示起始Y坐标（左上角）
  * @param image_data 指向图片数据的指针，包含头信息和像素数据
- * @note 图片数据格式：前8字节为头信息，后续为RGB565像素数据
+ * @note 图片数据格式：前8字节为头信息，第8字节（[7]）为数据格式，后续为像素数据
  * @note 头信息包含：格式标识、宽度、高度、颜色深度等
+ * @note 解码结果直接分段写入一个窗口，不需要整幅图片大小的缓冲区
+ * @note 窗口只开裁剪区内的部分：原始和调色板格式直接跳过裁掉的行和列，
+ *       行程编码顺序解码、丢弃裁掉的像素，过了最后一个可见行就停止
  * @example Gui_DrawImage(10, 10, gImage_weather);
  */
 void Gui_DrawImage(uint16_t x, uint16_t y, const uint8_t *image_data)
@@ -601,25 +1673,29 @@ void Gui_DrawImage(uint16_t x, uint16_t y, const uint8_t *image_data)
     // 解析图片头信息
     uint16_t width = image_data[2] | (image_data[3] << 8);   // 小端序读取宽度
     uint16_t height = image_data[4] | (image_data[5] << 8);  // 小端序读取高度
-    
-    // 跳过8字节头信息，指向实际像素数据
-    const uint8_t *pixel_data = image_data + 8;
-    
-    uint16_t i, j;
-    uint16_t color;
-    
-    // 逐像素绘制图片
-    for(i = 0; i < height; i++)
+    uint32_t total = (uint32_t)width * height;
+    GUI_Rect_t v;
+    uint8_t clip;
+
+    if(!Gui_ClipBox(x, y, width, height, &v)) return;     // 完全在裁剪区外，不解码
+    clip = (v.x1 - v.x0 != width || v.y1 - v.y0 != height);
+
+    // 可见部分一个窗口
+    Lcd_BeginWindow(v.x0, v.y0, v.x1 - 1, v.y1 - 1);
+    gui_img.n = 0;
+    gui_img.width = width;
+    gui_img.v.x0 = v.x0 - x;
+    gui_img.v.y0 = v.y0 - y;
+    gui_img.v.x1 = v.x1 - x;
+    gui_img.v.y1 = v.y1 - y;
+    switch(image_data[7])
     {
-        for(j = 0; j < width; j++)
-        {
-            // 从字节数据中读取16位颜色值（小端序）
-            uint16_t pixel_index = (i * width + j) * 2;
-            color = pixel_data[pixel_index] | (pixel_data[pixel_index + 1] << 8);
-            
-            Gui_DrawPoint(x + j, y + i, color);
-        }
+        case GUI_IMAGE_INDEXED: Gui_DecodeIndexed(image_data); break;
+        case GUI_IMAGE_RLE:     Gui_DecodeRle(image_data, total, clip); break;
+        default:    // 跳过8字节头信息
+            if(clip) Gui_DecodeRawClip(image_data + 8, image_data[0] & GUI_IMAGE_BIG_ENDIAN);
+            else Gui_DecodeRaw(image_data + 8, total, image_data[0] & GUI_IMAGE_BIG_ENDIAN);
+            break;
     }
+    Lcd_EndWindow();
 }
-
-
@@ -0,0 +1,289 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Chart.c
+ * @brief          : 历史曲线控件实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 第col列只由该列和前一列（环形）的采样决定：折线画成从前一个值到本列值的竖线，
+ * 面积从本列值向下填充到底。新采样写在游标列，游标前进一列，原来最老的一列变成新游标（空白），
+ * 新游标后面那一列失去了前一个采样，折线的竖线要去掉，所以一次Push只需重画3列。
+ * ST7735的硬件滚动只能沿面板的长边（本屏的行方向）移动，图表横向滚动无法利用，
+ * 整体左移又等于整个图重发，因此采用扫描式。
+ ******************************************************************************
+ */
+
+#include "GUI_Chart.h"
+#include "GUI.h"
+#include "lcd_Driver.h"
+#include <string.h>
+
+#define CHART_ROW_NONE  0xFF            // 该列没有采样
+
+/**
+ * @brief 一列中一条曲线占用的行
+ */
+typedef struct
+{
+    uint8_t top;                        /**< 本列值所在行，面积从这里向下；CHART_ROW_NONE=无采样 */
+    uint8_t lo, hi;                     /**< 折线竖线的行范围 */
+} Chart_Seg_t;
+
+static Chart_Seg_t chart_seg[GUI_CHART_W_MAX][GUI_CHART_SERIES_MAX];
+static uint16_t chart_px[GUI_CHART_W_MAX];
+
+/*---------------------------------------------------坐标----------------------------------------------------*/
+
+// 向下取整的除法（温度可能为负）
+static int16_t Chart_FloorDiv(int16_t v, int16_t d)
+{
+    return (int16_t)((v >= 0) ? v / d : -((-v + d - 1) / d));
+}
+
+/**
+ * @brief  第col列是否有采样
+ * @note   最新的采样在head-1列，往前count个
+ */
+static uint8_t Chart_Valid(const GUI_Chart_t *c, uint8_t col)
+{
+    return (uint8_t)(((c->head + c->w - 1 - col) % c->w) < c->count);
+}
+
+/**
+ * @brief  值v在纵轴范围[lo, hi)中对应的行（0为顶部）
+ */
+static uint8_t Chart_Row(const GUI_Chart_t *c, const GUI_ChartSeries_t *s, int16_t v)
+{
+    int32_t span = s->hi - s->lo;
+
+    return (uint8_t)((c->h - 1) - ((int32_t)(v - s->lo) * (c->h - 1) + span / 2) / span);
+}
+
+/**
+ * @brief  按缓冲区内的采样重新计算每条曲线的纵轴范围
+ * @return 1=有曲线的范围变化了
+ */
+static uint8_t Chart_Range(GUI_Chart_t *c)
+{
+    GUI_ChartSeries_t *s;
+    int16_t vmin, vmax, v, lo, hi;
+    uint8_t i, k, changed = 0;
+
+    if(c->count == 0) return 0;
+
+    for(k = 0; k < c->series; k++)
+    {
+        s = &c->s[k];
+        vmin = INT16_MAX;
+        vmax = INT16_MIN;
+        for(i = 1; i <= c->count; i++)
+        {
+            v = s->data[(c->head + c->w - i) % c->w];
+            if(v < vmin) vmin = v;
+            if(v > vmax) vmax = v;
+        }
+
+        lo = (int16_t)(Chart_FloorDiv(vmin, s->step) * s->step);
+        hi = (int16_t)((Chart_FloorDiv(vmax, s->step) + 1) * s->step);
+        if(lo != s->lo || hi != s->hi)
+        {
+            s->lo = lo;
+            s->hi = hi;
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+/**
+ * @brief  计算第col列各曲线占用的行
+ */
+static void Chart_Column(const GUI_Chart_t *c, uint8_t col, Chart_Seg_t *seg)
+{
+    uint8_t prev = (uint8_t)((col + c->w - 1) % c->w), k, p;
+    uint8_t valid = Chart_Valid(c, col), prev_valid = Chart_Valid(c, prev);
+
+    for(k = 0; k < c->series; k++)
+    {
+        if(!valid)
+        {
+            seg[k].top = CHART_ROW_NONE;
+            continue;
+        }
+        seg[k].top = seg[k].lo = seg[k].hi = Chart_Row(c, &c->s[k], c->s[k].data[col]);
+        if(prev_valid)
+        {
+            p = Chart_Row(c, &c->s[k], c->s[k].data[prev]);
+            if(p < seg[k].lo) seg[k].lo = p;
+            if(p > seg[k].hi) seg[k].hi = p;
+        }
+    }
+}
+
+/**
+ * @brief  第row行的像素颜色：折线在面积之上，后加入的曲线在上
+ */
+static uint16_t Chart_Pixel(const GUI_Chart_t *c, const Chart_Seg_t *seg, uint8_t row)
+{
+    int8_t k;
+
+    for(k = (int8_t)c->series - 1; k >= 0; k--)
+    {
+        if(seg[k].top != CHART_ROW_NONE && row >= seg[k].lo && row <= seg[k].hi) return c->s[k].color;
+    }
+    for(k = (int8_t)c->series - 1; k >= 0; k--)
+    {
+        if(seg[k].top != CHART_ROW_NONE && row >= seg[k].top && c->s[k].fill != c->bg) return c->s[k].fill;
+    }
+    return c->bg;
+}
+
+/*---------------------------------------------------绘制----------------------------------------------------*/
+
+/**
+ * @brief  重画第col0列起的n列（不回绕），裁剪后一个窗口
+ */
+static void Chart_DrawColumns(const GUI_Chart_t *c, uint8_t col0, uint8_t n)
+{
+    const GUI_Rect_t *clip = Gui_GetClip();
+    int x0 = c->x + col0, x1 = c->x + col0 + n, y0 = c->y, y1 = c->y + c->h;
+    int x, y;
+
+    if(x0 < clip->x0) x0 = clip->x0;
+    if(y0 < clip->y0) y0 = clip->y0;
+    if(x1 > clip->x1) x1 = clip->x1;
+    if(y1 > clip->y1) y1 = clip->y1;
+    if(x0 >= x1 || y0 >= y1) return;
+
+    for(x = x0; x < x1; x++) Chart_Column(c, (uint8_t)(x - c->x), chart_seg[x - x0]);
+
+    Lcd_BeginWindow(x0, y0, x1 - 1, y1 - 1);
+    for(y = y0; y < y1; y++)
+    {
+        for(x = x0; x < x1; x++) chart_px[x - x0] = Chart_Pixel(c, chart_seg[x - x0], (uint8_t)(y - c->y));
+        Lcd_WritePixels(chart_px, (uint32_t)(x1 - x0));
+    }
+    Lcd_EndWindow();
+}
+
+/*---------------------------------------------------接口----------------------------------------------------*/
+
+/**
+ * @brief  初始化图表
+ * @param  c: 图表
+ * @param  x: 左上角X坐标
+ * @param  y: 左上角Y坐标
+ * @param  w: 宽度（3~GUI_CHART_W_MAX，保存w-1个采样）
+ * @param  h: 高度（至少2）
+ * @param  bg: 背景色
+ */
+void GUI_Chart_Init(GUI_Chart_t *c, uint16_t x, uint16_t y, uint8_t w, uint8_t h, uint16_t bg)
+{
+    memset(c, 0, sizeof(*c));
+    if(w < 3) w = 3;
+    if(w > GUI_CHART_W_MAX) w = GUI_CHART_W_MAX;
+    if(h < 2) h = 2;
+
+    c->x = x;
+    c->y = y;
+    c->w = w;
+    c->h = h;
+    c->bg = bg;
+}
+
+/**
+ * @brief  添加一条曲线
+ * @param  color: 折线颜色
+ * @param  fill: 折线以下的填充色，等于背景色时不填充
+ * @param  step: 纵轴范围取整单位，范围为step的整数倍，采样在同一格内变化时不重画整个图
+ * @return 曲线编号（GUI_Chart_Push的values下标），曲线已满时返回-1
+ * @example
+ *          GUI_Chart_AddSeries(&chart, BLUE, GRAY0, 10);   // 湿度：蓝线灰色填充，范围按10%取整
+ */
+int8_t GUI_Chart_AddSeries(GUI_Chart_t *c, uint16_t color, uint16_t fill, int16_t step)
+{
+    GUI_ChartSeries_t *s;
+
+    if(c->series >= GUI_CHART_SERIES_MAX) return -1;
+    if(step < 1) step = 1;
+
+    s = &c->s[c->series];
+    s->color = color;
+    s->fill = fill;
+    s->step = step;
+    s->lo = 0;
+    s->hi = step;
+    c->drawn = 0;
+    return (int8_t)c->series++;
+}
+
+/**
+ * @brief  加入一组采样
+ * @param  values: 每条曲线一个值
+ * @note   缓冲区满时覆盖最老的采样
+ */
+void GUI_Chart_Push(GUI_Chart_t *c, const int16_t *values)
+{
+    uint8_t k;
+
+    for(k = 0; k < c->series; k++) c->s[k].data[c->head] = values[k];
+    c->head = (uint8_t)((c->head + 1) % c->w);
+    if(c->count < c->w - 1) c->count++;
+    if(c->pending < c->w) c->pending++;
+}
+
+/**
+ * @brief  清空采样，下次Update画出空白图表
+ */
+void GUI_Chart_Clear(GUI_Chart_t *c)
+{
+    c->head = 0;
+    c->count = 0;
+    c->pending = 0;
+    c->drawn = 0;
+}
+
+/**
+ * @brief  标记屏幕内容已失效，下次Update整个图重画
+ */
+void GUI_Chart_Invalidate(GUI_Chart_t *c)
+{
+    c->drawn = 0;
+}
+
+/**
+ * @brief  把变化画到屏幕
+ * @return 1=有绘制，0=没有新采样
+ * @note   纵轴范围变化、第一次绘制、或积压的采样接近一整屏时整个图重画，
+ *         否则只画新采样所在的列、游标列和游标后一列（跨过右边界时分两个窗口）
+ */
+uint8_t GUI_Chart_Update(GUI_Chart_t *c)
+{
+    uint8_t col, n;
+
+    if(c->drawn && c->pending == 0) return 0;
+
+    if(Chart_Range(c) || !c->drawn || c->pending + 2 >= c->w)
+    {
+        Chart_DrawColumns(c, 0, c->w);
+    }
+    else
+    {
+        col = (uint8_t)((c->head + c->w - c->pending) % c->w);
+        n = (uint8_t)(c->pending + 2);
+        if(col + n > c->w)
+        {
+            Chart_DrawColumns(c, col, (uint8_t)(c->w - col));
+            Chart_DrawColumns(c, 0, (uint8_t)(col + n - c->w));
+        }
+        else
+        {
+            Chart_DrawColumns(c, col, n);
+        }
+    }
+
+    c->pending = 0;
+    c->drawn = 1;
+    return 1;
+}
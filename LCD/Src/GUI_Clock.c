@@ -0,0 +1,459 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Clock.c
+ * @brief          : 指针式时钟控件实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 每个像素的颜色由"层"决定：中心圆 > 秒针 > 分针 > 时针 > 表盘，表盘颜色按到圆心的距离
+ * 和刻度点位置算出。指针是凸四边形，每行与四条边求交得到一段区间（Q8定点，无浮点）。
+ * 更新时对变化了的指针，在旧位置和新位置覆盖的行内逐像素比较新旧两套指针算出的层，
+ * 只发送层不同的像素；相邻的小段合并成一个窗口，减少窗口设置命令。
+ * 秒针走1°时每行只有一两个像素变化，一次更新只有几百字节SPI数据。
+ ******************************************************************************
+ */
+
+#include "GUI_Clock.h"
+#include "GUI.h"
+#include "lcd_Driver.h"
+#include <string.h>
+
+// 同一行两段之间不超过这么多像素时合并发送（重发的像素比一次窗口设置命令便宜）
+#define CLOCK_RUN_GAP       3
+
+enum
+{
+    CLOCK_LAYER_FACE = 0,   // 1~3 为 GUI_CLOCK_HOUR+1 ~ GUI_CLOCK_SECOND+1
+    CLOCK_LAYER_HUB = GUI_CLOCK_HANDS + 1
+};
+
+/**
+ * @brief 指针多边形（相对圆心，Q8），顶点顺序：尾左、尖左、尖右、尾右
+ */
+typedef struct
+{
+    int16_t x[4], y[4];
+    int16_t y0, y1;         // 覆盖的行（相对圆心）
+} Clock_Poly_t;
+
+/**
+ * @brief 一行内的像素区间（相对圆心），x0 > x1 表示该行没有像素
+ */
+typedef struct
+{
+    int16_t x0, x1;
+} Clock_Span_t;
+
+static uint16_t clock_row[2 * GUI_CLOCK_R_MAX + 1];
+
+/*---------------------------------------------------几何----------------------------------------------------*/
+
+// Q8向下/向上取整到整数像素（负数也正确）
+static int Clock_Floor8(int32_t v)
+{
+    return (v >= 0) ? (int)(v >> 8) : -(int)((255 - v) >> 8);
+}
+
+static int Clock_Ceil8(int32_t v)
+{
+    return -Clock_Floor8(-v);
+}
+
+/**
+ * @brief  按表盘半径算出外圈、刻度点和指针尺寸
+ */
+static void Clock_Layout(GUI_Clock_t *c)
+{
+    int16_t r = c->r, rm, in;
+    uint8_t i;
+
+    c->rim = (r >= 20) ? 2 : 1;
+    c->hub = (r >= 32) ? 3 : 2;
+    c->mark_r[0] = (r >= 24) ? 2 : 1;
+    c->mark_r[1] = (r >= 24) ? 1 : 0;
+
+    rm = r - c->rim - 3;
+    for(i = 0; i < GUI_CLOCK_MARKS; i++)
+    {
+        c->mark_x[i] = (int8_t)(((int32_t)Gui_SinQ15(i * 30) * rm + 16384) >> 15);
+        c->mark_y[i] = (int8_t)(((int32_t)-Gui_CosQ15(i * 30) * rm + 16384) >> 15);
+    }
+    in = rm - c->mark_r[0] - 1;
+    c->mark_in2 = (uint16_t)(in * in);
+
+    // 时针到半径一半，分针3/4，秒针伸进刻度圈；宽度随半径缩放但不小于1像素
+    c->shape[GUI_CLOCK_HOUR].len    = r * 128;
+    c->shape[GUI_CLOCK_HOUR].tail   = r * 26;
+    c->shape[GUI_CLOCK_HOUR].base_w = (r * 20 > 256) ? r * 20 : 256;
+    c->shape[GUI_CLOCK_HOUR].tip_w  = 192;
+
+    c->shape[GUI_CLOCK_MINUTE].len    = r * 192;
+    c->shape[GUI_CLOCK_MINUTE].tail   = r * 26;
+    c->shape[GUI_CLOCK_MINUTE].base_w = (r * 14 > 192) ? r * 14 : 192;
+    c->shape[GUI_CLOCK_MINUTE].tip_w  = 128;
+
+    c->shape[GUI_CLOCK_SECOND].len    = r * 220;
+    c->shape[GUI_CLOCK_SECOND].tail   = r * 52;
+    c->shape[GUI_CLOCK_SECOND].base_w = 128;
+    c->shape[GUI_CLOCK_SECOND].tip_w  = 128;
+}
+
+/**
+ * @brief  指针在角度deg时的四边形
+ * @note   方向u=(sin, -cos)，法向n=(cos, sin)，顶点 = a*u + b*n
+ */
+static void Clock_HandPoly(const GUI_ClockShape_t *s, int16_t deg, Clock_Poly_t *p)
+{
+    int32_t ux = Gui_SinQ15(deg), uy = -Gui_CosQ15(deg);
+    int32_t a[4], b[4], ymin = INT16_MAX, ymax = INT16_MIN;
+    uint8_t i;
+
+    a[0] = -s->tail;    b[0] = -s->base_w;
+    a[1] = s->len;      b[1] = -s->tip_w;
+    a[2] = s->len;      b[2] = s->tip_w;
+    a[3] = -s->tail;    b[3] = s->base_w;
+
+    for(i = 0; i < 4; i++)
+    {
+        p->x[i] = (int16_t)((a[i] * ux - b[i] * uy) >> 15);
+        p->y[i] = (int16_t)((a[i] * uy + b[i] * ux) >> 15);
+        if(p->y[i] < ymin) ymin = p->y[i];
+        if(p->y[i] > ymax) ymax = p->y[i];
+    }
+    p->y0 = (int16_t)Clock_Ceil8(ymin);
+    p->y1 = (int16_t)Clock_Floor8(ymax);
+}
+
+/**
+ * @brief  四边形在第dy行（像素中心）覆盖的像素区间
+ * @note   取中心落在交线段内的像素；交线段比一个像素窄时取离中点最近的一个，细指针斜着也不断开
+ */
+static void Clock_PolyRow(const Clock_Poly_t *p, int dy, Clock_Span_t *sp)
+{
+    int32_t y = (int32_t)dy * 256, lo = INT32_MAX, hi = INT32_MIN, x;
+    int32_t xa, ya, xb, yb;
+    uint8_t i;
+    int x0, x1;
+
+    sp->x0 = 1;
+    sp->x1 = 0;
+    if(dy < p->y0 || dy > p->y1) return;
+
+    for(i = 0; i < 4; i++)
+    {
+        xa = p->x[i];           ya = p->y[i];
+        xb = p->x[(i + 1) & 3]; yb = p->y[(i + 1) & 3];
+        if((y < ya && y < yb) || (y > ya && y > yb)) continue;
+
+        if(ya == yb)
+        {
+            if(xa < lo) lo = xa;
+            if(xa > hi) hi = xa;
+            x = xb;
+        }
+        else
+        {
+            x = xa + (y - ya) * (xb - xa) / (yb - ya);
+        }
+        if(x < lo) lo = x;
+        if(x > hi) hi = x;
+    }
+    if(lo > hi) return;
+
+    x0 = Clock_Ceil8(lo);
+    x1 = Clock_Floor8(hi);
+    if(x0 > x1) x0 = x1 = Clock_Floor8((lo + hi) / 2 + 128);
+    sp->x0 = (int16_t)x0;
+    sp->x1 = (int16_t)x1;
+}
+
+/*---------------------------------------------------像素----------------------------------------------------*/
+
+/**
+ * @brief  表盘（不含指针）在(dx,dy)处的颜色
+ * @note   取到圆心距离小于r+0.5的像素，与Gui_FillCircle一致
+ */
+static uint16_t Clock_FaceColor(const GUI_Clock_t *c, int dx, int dy)
+{
+    int32_t d2 = dx * dx + dy * dy, r = c->r, ri = r - c->rim, mr;
+    int mx, my;
+    uint8_t i;
+
+    if(d2 > r * r + r) return c->bg;
+    if(d2 > ri * ri + ri) return c->rim_color;
+    if(d2 >= c->mark_in2)
+    {
+        for(i = 0; i < GUI_CLOCK_MARKS; i++)
+        {
+            mx = dx - c->mark_x[i];
+            my = dy - c->mark_y[i];
+            mr = c->mark_r[(i % 3) ? 1 : 0];
+            if(mx * mx + my * my <= mr * mr + mr) return c->mark;
+        }
+    }
+    return c->face;
+}
+
+/**
+ * @brief  (dx,dy)处最上面的一层
+ * @param  sp: 该行各指针的区间
+ */
+static uint8_t Clock_Layer(const GUI_Clock_t *c, const Clock_Span_t *sp, int dx, int dy)
+{
+    int k;
+
+    if(dx * dx + dy * dy <= c->hub * c->hub + c->hub) return CLOCK_LAYER_HUB;
+    for(k = GUI_CLOCK_HANDS - 1; k >= 0; k--)
+    {
+        if(dx >= sp[k].x0 && dx <= sp[k].x1) return (uint8_t)(k + 1);
+    }
+    return CLOCK_LAYER_FACE;
+}
+
+static uint16_t Clock_Color(const GUI_Clock_t *c, uint8_t layer, int dx, int dy)
+{
+    if(layer == CLOCK_LAYER_FACE) return Clock_FaceColor(c, dx, dy);
+    if(layer == CLOCK_LAYER_HUB) return c->hand_color[GUI_CLOCK_SECOND];
+    return c->hand_color[layer - 1];
+}
+
+/*---------------------------------------------------绘制----------------------------------------------------*/
+
+/**
+ * @brief  整个表盘：外接正方形（裁剪后）一个窗口，逐行算颜色
+ */
+static void Clock_Paint(GUI_Clock_t *c)
+{
+    const GUI_Rect_t *clip = Gui_GetClip();
+    Clock_Poly_t hp[GUI_CLOCK_HANDS];
+    Clock_Span_t sp[GUI_CLOCK_HANDS];
+    int x0 = c->cx - c->r, y0 = c->cy - c->r, x1 = c->cx + c->r + 1, y1 = c->cy + c->r + 1;
+    int x, y, k;
+
+    if(x0 < clip->x0) x0 = clip->x0;
+    if(y0 < clip->y0) y0 = clip->y0;
+    if(x1 > clip->x1) x1 = clip->x1;
+    if(y1 > clip->y1) y1 = clip->y1;
+    if(x0 >= x1 || y0 >= y1) return;
+
+    for(k = 0; k < GUI_CLOCK_HANDS; k++) Clock_HandPoly(&c->shape[k], c->angle[k], &hp[k]);
+
+    Lcd_BeginWindow(x0, y0, x1 - 1, y1 - 1);
+    for(y = y0; y < y1; y++)
+    {
+        for(k = 0; k < GUI_CLOCK_HANDS; k++) Clock_PolyRow(&hp[k], y - c->cy, &sp[k]);
+        for(x = x0; x < x1; x++)
+        {
+            clock_row[x - x0] = Clock_Color(c, Clock_Layer(c, sp, x - c->cx, y - c->cy), x - c->cx, y - c->cy);
+        }
+        Lcd_WritePixels(clock_row, (uint32_t)(x1 - x0));
+    }
+    Lcd_EndWindow();
+}
+
+static void Clock_Flush(const GUI_Clock_t *c, int dx, int dy, int n)
+{
+    if(n == 0) return;
+    Lcd_BeginWindow(c->cx + dx, c->cy + dy, c->cx + dx + n - 1, c->cy + dy);
+    Lcd_WritePixels(clock_row, (uint32_t)n);
+    Lcd_EndWindow();
+}
+
+/**
+ * @brief  更新一行：只发送新旧两套指针算出的层不同的像素
+ * @param  np: 新指针
+ * @param  op: 屏幕上的指针
+ * @param  changed: 变化了的指针（bit k = GUI_ClockHand_t k）
+ */
+static void Clock_UpdateRow(const GUI_Clock_t *c, const Clock_Poly_t *np, const Clock_Poly_t *op, uint8_t changed, int dy)
+{
+    const GUI_Rect_t *clip = Gui_GetClip();
+    Clock_Span_t ns[GUI_CLOCK_HANDS], os[GUI_CLOCK_HANDS];
+    int lo = INT16_MAX, hi = INT16_MIN, dx, k, start = 0, last = 0, n = 0;
+    uint8_t layer;
+
+    if(c->cy + dy < clip->y0 || c->cy + dy >= clip->y1) return;
+
+    for(k = 0; k < GUI_CLOCK_HANDS; k++)
+    {
+        Clock_PolyRow(&np[k], dy, &ns[k]);
+        if(!(changed & (1u << k)))
+        {
+            os[k] = ns[k];
+            continue;
+        }
+        Clock_PolyRow(&op[k], dy, &os[k]);
+        if(ns[k].x0 <= ns[k].x1)
+        {
+            if(ns[k].x0 < lo) lo = ns[k].x0;
+            if(ns[k].x1 > hi) hi = ns[k].x1;
+        }
+        if(os[k].x0 <= os[k].x1)
+        {
+            if(os[k].x0 < lo) lo = os[k].x0;
+            if(os[k].x1 > hi) hi = os[k].x1;
+        }
+    }
+    if(lo < clip->x0 - c->cx) lo = clip->x0 - c->cx;
+    if(hi > clip->x1 - 1 - c->cx) hi = clip->x1 - 1 - c->cx;
+
+    for(dx = lo; dx <= hi; dx++)
+    {
+        layer = Clock_Layer(c, ns, dx, dy);
+        if(layer == Clock_Layer(c, os, dx, dy)) continue;
+
+        if(n && dx - last <= CLOCK_RUN_GAP + 1)
+        {
+            // 中间没变的像素按现在的颜色重发
+            for(k = last + 1; k < dx; k++) clock_row[n++] = Clock_Color(c, Clock_Layer(c, ns, k, dy), k, dy);
+        }
+        else
+        {
+            Clock_Flush(c, start, dy, n);
+            start = dx;
+            n = 0;
+        }
+        clock_row[n++] = Clock_Color(c, layer, dx, dy);
+        last = dx;
+    }
+    Clock_Flush(c, start, dy, n);
+}
+
+/*---------------------------------------------------接口----------------------------------------------------*/
+
+/**
+ * @brief  初始化时钟
+ * @param  c: 时钟
+ * @param  cx: 圆心X坐标
+ * @param  cy: 圆心Y坐标
+ * @param  r: 表盘半径（GUI_CLOCK_R_MIN~GUI_CLOCK_R_MAX，超出时取边界值）
+ * @note   时间为12:00:00；画到屏幕要调用GUI_Clock_Update
+ */
+void GUI_Clock_Init(GUI_Clock_t *c, uint16_t cx, uint16_t cy, uint8_t r)
+{
+    memset(c, 0, sizeof(*c));
+    c->bg = WHITE;
+    c->face = WHITE;
+    c->rim_color = BLACK;
+    c->mark = BLACK;
+    c->hand_color[GUI_CLOCK_HOUR] = BLACK;
+    c->hand_color[GUI_CLOCK_MINUTE] = BLACK;
+    c->hand_color[GUI_CLOCK_SECOND] = RED;
+    GUI_Clock_Move(c, cx, cy, r);
+}
+
+/**
+ * @brief  修改位置和大小
+ * @note   只重画新位置，旧位置由调用方擦除
+ */
+void GUI_Clock_Move(GUI_Clock_t *c, uint16_t cx, uint16_t cy, uint8_t r)
+{
+    if(r < GUI_CLOCK_R_MIN) r = GUI_CLOCK_R_MIN;
+    if(r > GUI_CLOCK_R_MAX) r = GUI_CLOCK_R_MAX;
+
+    c->cx = (int16_t)cx;
+    c->cy = (int16_t)cy;
+    c->r = r;
+    Clock_Layout(c);
+    c->drawn = 0;
+}
+
+/**
+ * @brief  修改表盘颜色
+ * @param  bg: 外接正方形内表盘以外的颜色（一般为所在区域的背景色）
+ * @param  face: 表盘
+ * @param  rim: 外圈
+ * @param  mark: 刻度点
+ */
+void GUI_Clock_SetColors(GUI_Clock_t *c, uint16_t bg, uint16_t face, uint16_t rim, uint16_t mark)
+{
+    if(c->bg == bg && c->face == face && c->rim_color == rim && c->mark == mark) return;
+
+    c->bg = bg;
+    c->face = face;
+    c->rim_color = rim;
+    c->mark = mark;
+    c->drawn = 0;
+}
+
+/**
+ * @brief  修改指针颜色（中心圆与秒针同色）
+ */
+void GUI_Clock_SetHandColors(GUI_Clock_t *c, uint16_t hour, uint16_t minute, uint16_t second)
+{
+    if(c->hand_color[GUI_CLOCK_HOUR] == hour && c->hand_color[GUI_CLOCK_MINUTE] == minute &&
+       c->hand_color[GUI_CLOCK_SECOND] == second) return;
+
+    c->hand_color[GUI_CLOCK_HOUR] = hour;
+    c->hand_color[GUI_CLOCK_MINUTE] = minute;
+    c->hand_color[GUI_CLOCK_SECOND] = second;
+    c->drawn = 0;
+}
+
+/**
+ * @brief  修改时间
+ * @param  hour: 时（0~23）
+ * @param  min: 分（0~59）
+ * @param  sec: 秒（0~59）
+ * @param  ms: 毫秒（0~999），秒针按1°（1/6秒）前进；只有整秒时间时传0
+ * @note   时针每2分钟、分针每10秒走1°
+ * @example
+ *          GUI_Clock_SetTime(&clock, 11, 20, 1, 500);    // 秒针指向6°+3°
+ */
+void GUI_Clock_SetTime(GUI_Clock_t *c, uint8_t hour, uint8_t min, uint8_t sec, uint16_t ms)
+{
+    if(ms > 999) ms = 999;
+    c->angle[GUI_CLOCK_HOUR] = (int16_t)((hour % 12) * 30 + min / 2);
+    c->angle[GUI_CLOCK_MINUTE] = (int16_t)(min * 6 + sec / 10);
+    c->angle[GUI_CLOCK_SECOND] = (int16_t)(sec * 6 + ms * 6 / 1000);
+}
+
+/**
+ * @brief  标记屏幕内容已失效，下次Update整个表盘重画
+ */
+void GUI_Clock_Invalidate(GUI_Clock_t *c)
+{
+    c->drawn = 0;
+}
+
+/**
+ * @brief  把变化画到屏幕
+ * @return 1=有绘制，0=指针没有变化
+ */
+uint8_t GUI_Clock_Update(GUI_Clock_t *c)
+{
+    Clock_Poly_t np[GUI_CLOCK_HANDS], op[GUI_CLOCK_HANDS];
+    int y0 = INT16_MAX, y1 = INT16_MIN, dy, k;
+    uint8_t changed = 0;
+
+    if(!c->drawn)
+    {
+        Clock_Paint(c);
+        memcpy(c->shown, c->angle, sizeof(c->shown));
+        c->drawn = 1;
+        return 1;
+    }
+
+    for(k = 0; k < GUI_CLOCK_HANDS; k++)
+    {
+        if(c->angle[k] != c->shown[k]) changed |= (uint8_t)(1u << k);
+    }
+    if(!changed) return 0;
+
+    for(k = 0; k < GUI_CLOCK_HANDS; k++)
+    {
+        Clock_HandPoly(&c->shape[k], c->angle[k], &np[k]);
+        Clock_HandPoly(&c->shape[k], c->shown[k], &op[k]);
+        if(!(changed & (1u << k))) continue;
+        if(np[k].y0 < y0) y0 = np[k].y0;
+        if(op[k].y0 < y0) y0 = op[k].y0;
+        if(np[k].y1 > y1) y1 = np[k].y1;
+        if(op[k].y1 > y1) y1 = op[k].y1;
+    }
+
+    for(dy = y0; dy <= y1; dy++) Clock_UpdateRow(c, np, op, changed, dy);
+
+    memcpy(c->shown, c->angle, sizeof(c->shown));
+    return 1;
+}
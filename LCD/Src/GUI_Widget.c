@@ -0,0 +1,277 @@
+/**
+ ******************************************************************************
+ * @file           : GUI_Widget.c
+ * @brief          : 保留模式控件实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 每个控件保存"绑定值"和"屏幕上当前的内容"两份状态，
+ * GUI_Widget_Update 比较两者，相同则直接返回，不同才调用GUI.c的绘图函数。
+ * 标签按字符格比较，只重画变化的格子，秒数跳动时只发送一个字符。
+ * 标签变短、图标变小时，只擦除旧内容超出新内容的部分，避免整块闪烁。
+ ******************************************************************************
+ */
+
+#include "GUI_Widget.h"
+#include "GUI.h"
+#include "lcd_Driver.h"
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------初始化----------------------------------------------------*/
+
+/**
+ * @brief  初始化标签
+ * @param  w: 控件
+ * @param  x: 左上角X坐标
+ * @param  y: 左上角Y坐标
+ * @param  max_chars: 最多显示的字符数（决定擦除边界，超出的字符被截掉）
+ * @param  font: 字体
+ * @param  fc: 前景色
+ * @param  bc: 背景色（必须与fc不同）
+ */
+void GUI_Label_Init(GUI_Widget_t *w, uint16_t x, uint16_t y, uint8_t max_chars, GUI_Font_t font, uint16_t fc, uint16_t bc)
+{
+    uint16_t adv = (font == GUI_FONT_NUM32) ? 32 : 8;
+
+    memset(w, 0, sizeof(*w));
+    if(max_chars > GUI_WIDGET_TEXT_MAX - 1) max_chars = GUI_WIDGET_TEXT_MAX - 1;
+
+    w->type = GUI_WIDGET_LABEL;
+    w->font = font;
+    w->x = x;
+    w->y = y;
+    w->w = max_chars * adv;
+    w->h = (font == GUI_FONT_NUM32) ? 32 : 16;
+    w->fc = fc;
+    w->bc = bc;
+}
+
+/**
+ * @brief  初始化图标
+ * @param  bc: 图标换小或清空时用来擦除的背景色
+ */
+void GUI_Icon_Init(GUI_Widget_t *w, uint16_t x, uint16_t y, const uint8_t *image, uint16_t bc)
+{
+    memset(w, 0, sizeof(*w));
+    w->type = GUI_WIDGET_ICON;
+    w->x = x;
+    w->y = y;
+    w->bc = bc;
+    w->image = image;
+}
+
+/**
+ * @brief  初始化空心圆点
+ * @param  cx: 圆心X坐标
+ * @param  cy: 圆心Y坐标
+ * @param  r: 半径
+ */
+void GUI_Dot_Init(GUI_Widget_t *w, uint16_t cx, uint16_t cy, uint16_t r, uint16_t fc)
+{
+    memset(w, 0, sizeof(*w));
+    w->type = GUI_WIDGET_DOT;
+    w->x = cx;
+    w->y = cy;
+    w->w = r;
+    w->fc = fc;
+}
+
+/*---------------------------------------------------绑定值----------------------------------------------------*/
+
+static uint16_t Label_Advance(const GUI_Widget_t *w)
+{
+    return (w->font == GUI_FONT_NUM32) ? 32 : 8;
+}
+
+/**
+ * @brief  设置标签文字（按边界截断后保存）
+ */
+void GUI_Widget_SetText(GUI_Widget_t *w, const char *text)
+{
+    size_t max = w->w / Label_Advance(w);
+
+    if(text == NULL) text = "";
+    strncpy(w->text, text, max);
+    w->text[max] = '\0';
+}
+
+/**
+ * @brief  设置数值（格式化为文字，值不变时文字不变，Update不会重画）
+ * @param  fmt: printf格式，含一个int转换，例如 "%d%%"
+ */
+void GUI_Widget_SetInt(GUI_Widget_t *w, int32_t value, const char *fmt)
+{
+    char buf[GUI_WIDGET_TEXT_MAX];
+
+    snprintf(buf, sizeof(buf), fmt ? fmt : "%d", (int)value);
+    GUI_Widget_SetText(w, buf);
+}
+
+void GUI_Widget_SetColor(GUI_Widget_t *w, uint16_t fc, uint16_t bc)
+{
+    w->fc = fc;
+    w->bc = bc;
+}
+
+void GUI_Widget_SetImage(GUI_Widget_t *w, const uint8_t *image)
+{
+    w->image = image;
+}
+
+void GUI_Widget_Invalidate(GUI_Widget_t *w)
+{
+    w->drawn = 0;
+}
+
+/*---------------------------------------------------绘制----------------------------------------------------*/
+
+/**
+ * @brief  画标签的一个字符格（不可显示的字符画成背景色）
+ */
+static void Label_DrawCell(const GUI_Widget_t *w, uint16_t x, char c)
+{
+    if(w->font == GUI_FONT_NUM32)
+    {
+        if(c >= '0' && c <= '9')
+            Gui_DrawFont_Num32(x, w->y, w->fc, w->bc, c - '0');
+        else
+            Lcd_FillRect(x, w->y, 32, 32, w->bc);
+    }
+    else
+    {
+        if(c >= 0x20 && c <= 0x7E)
+            Gui_DrawAsciiChar(x, w->y, w->fc, w->bc, c);
+        else
+            Lcd_FillRect(x, w->y, 8, 16, w->bc);
+    }
+}
+
+/**
+ * @brief  标签逐字符格比较：颜色没变时只重画字符变化的格子
+ * @note   "11:20:01" -> "11:20:02" 只发送最后一格；
+ *         新文字比旧文字短时擦掉多出的格子（"10%" -> "9%"），长时新增的格子照常画出；
+ *         8x16字体的文字每一格都要重画时整串画出（可命中字符串缓存）
+ */
+static uint8_t Label_Update(GUI_Widget_t *w)
+{
+    uint16_t adv = Label_Advance(w);
+    uint16_t len, old_len, new_w, i, n;
+    uint8_t full, printable;
+
+    // 颜色变化或从未画过：所有字符格都要重画
+    full = !w->drawn || w->fc != w->shown_fc || w->bc != w->shown_bc;
+    if(!full && strcmp(w->text, w->shown) == 0)
+        return 0;
+
+    len = (uint16_t)strlen(w->text);
+    old_len = full ? 0 : (uint16_t)strlen(w->shown);
+    for(i = 0; i < len && i < old_len && w->text[i] != w->shown[i]; i++);
+    for(printable = 1, n = 0; n < len; n++)
+        if(w->text[n] < 0x20 || w->text[n] > 0x7E) printable = 0;
+
+    if(w->font != GUI_FONT_NUM32 && printable && i == (len < old_len ? len : old_len))
+    {
+        // 每一格都变了（"Sunny" -> "Cloudy"）：整串画出，经过字符串缓存一次开窗发送
+        Gui_DrawAsciiString(w->x, w->y, w->fc, w->bc, w->text);
+    }
+    else
+    {
+        for(i = 0; i < len; i++)
+        {
+            if(i < old_len && w->text[i] == w->shown[i])
+                continue;
+            Label_DrawCell(w, w->x + i * adv, w->text[i]);
+        }
+    }
+
+    // 旧文字比新文字长：擦掉多出的字符格
+    new_w = len * adv;
+    if(w->drawn && w->shown_w > new_w)
+        Lcd_FillRect(w->x + new_w, w->y, w->shown_w - new_w, w->h, w->bc);
+
+    memcpy(w->shown, w->text, sizeof(w->shown));
+    w->shown_w = new_w;
+    w->shown_h = w->h;
+    return 1;
+}
+
+static uint8_t Icon_Update(GUI_Widget_t *w)
+{
+    uint16_t nw = 0, nh = 0;
+
+    if(w->drawn && w->image == w->shown_image)
+        return 0;
+
+    if(w->image != NULL)
+    {
+        nw = w->image[2] | (w->image[3] << 8);
+        nh = w->image[4] | (w->image[5] << 8);
+        Gui_DrawImage(w->x, w->y, w->image);
+    }
+
+    // 新图标覆盖不到的旧区域：右侧一条 + 下方一条
+    if(w->drawn)
+    {
+        if(w->shown_w > nw)
+            Lcd_FillRect(w->x + nw, w->y, w->shown_w - nw, w->shown_h, w->bc);
+        if(w->shown_h > nh)
+            Lcd_FillRect(w->x, w->y + nh, (nw < w->shown_w) ? nw : w->shown_w, w->shown_h - nh, w->bc);
+    }
+
+    w->shown_image = w->image;
+    w->shown_w = nw;
+    w->shown_h = nh;
+    return 1;
+}
+
+static uint8_t Dot_Update(GUI_Widget_t *w)
+{
+    if(w->drawn && w->fc == w->shown_fc)
+        return 0;
+
+    Gui_Circle(w->x, w->y, w->w, w->fc);
+    return 1;
+}
+
+/**
+ * @brief  把控件的变化画到屏幕
+ * @param  w: 控件
+ * @return 1=有绘制，0=与屏幕内容相同，没有发送任何数据
+ */
+uint8_t GUI_Widget_Update(GUI_Widget_t *w)
+{
+    uint8_t drew;
+
+    switch(w->type)
+    {
+        case GUI_WIDGET_LABEL: drew = Label_Update(w); break;
+        case GUI_WIDGET_ICON:  drew = Icon_Update(w); break;
+        case GUI_WIDGET_DOT:   drew = Dot_Update(w); break;
+        default:               drew = 0; break;
+    }
+
+    if(drew)
+    {
+        w->shown_fc = w->fc;
+        w->shown_bc = w->bc;
+        w->drawn = 1;
+    }
+    return drew;
+}
+
+/**
+ * @brief  按顺序更新一组控件（后面的控件画在前面的之上）
+ * @return 有绘制的控件个数
+ */
+uint8_t GUI_Widget_UpdateAll(GUI_Widget_t *const *list, uint8_t count)
+{
+    uint8_t i, n = 0;
+
+    for(i = 0; i < count; i++)
+    {
+        n += GUI_Widget_Update(list[i]);
+    }
+    return n;
+}
@@ -1,609 +1,82 @@
 /**
  ******************************************************************************
  * @file    font.c
- * @brief   字体数据定义文件 - 包含ASCII字符和中文字符的字模数据实现
- * @details 本文件包含了LCD显示用的所有字体数据定义
+ * @brief   字库查找 - 码点二分查找和UTF-8解码
+ * @details 字模数据本身由构建时生成的 font_assets.c 提供（见 assets/assets.txt），
+ *          这里只负责按码点在 FNT_Font_t 中定位字形
  * @author  Chipdriver
- * @date    2024年
+ * @date    2025-01-10
  * @version V1.0
  ******************************************************************************
  */
 
+#include <stddef.h>
 #include "font.h"
 
 /**
- * @brief 完整ASCII字符字模数据数组 (8x16像素)
- * @details 包含从空格(0x20)到波浪号(0x7E)共95个可打印ASCII字符
- *          每个字符占用16字节，支持完整的字母、数字、符号显示
+ * @brief  在字库中查找码点对应的字形
+ * @param  font: 字库
+ * @param  code: Unicode码点
+ * @return 字形点阵（font->glyph_bytes字节），字库中没有时返回NULL
+ * @note   codes[]升序排列，二分查找，3500个常用汉字最多12次比较
  */
-const unsigned char ascii_font[95][16] = {
-    // 0x20 空格 ' '
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x21 感叹号 '!'
-    {0x00,0x00,0x18,0x3C,0x3C,0x3C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x22 双引号 '"'
-    {0x00,0x66,0x66,0x66,0x24,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x23 井号 '#'
-    {0x00,0x00,0x00,0x6C,0x6C,0xFE,0x6C,0x6C,0x6C,0xFE,0x6C,0x6C,0x00,0x00,0x00,0x00},
-    // 0x24 美元符号 '$'
-    {0x18,0x18,0x7C,0xC6,0xC2,0xC0,0x7C,0x06,0x06,0x86,0xC6,0x7C,0x18,0x18,0x00,0x00},
-    // 0x25 百分号 '%'
-    {0x00,0x00,0x00,0x00,0xC2,0xC6,0x0C,0x18,0x30,0x60,0xC6,0x86,0x00,0x00,0x00,0x00},
-    // 0x26 & 符号 '&'
-    {0x00,0x00,0x38,0x6C,0x6C,0x38,0x76,0xDC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 0x27 单引号 '''
-    {0x00,0x30,0x30,0x30,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x28 左括号 '('
-    {0x00,0x00,0x0C,0x18,0x30,0x30,0x30,0x30,0x30,0x30,0x18,0x0C,0x00,0x00,0x00,0x00},
-    // 0x29 右括号 ')'
-    {0x00,0x00,0x30,0x18,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x18,0x30,0x00,0x00,0x00,0x00},
-    // 0x2A 星号 '*'
-    {0x00,0x00,0x00,0x00,0x00,0x66,0x3C,0xFF,0x3C,0x66,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2B 加号 '+'
-    {0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x7E,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2C 逗号 ','
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x18,0x30,0x00,0x00,0x00},
-    // 0x2D 减号 '-'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFE,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x2E 句号 '.'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x2F 斜杠 '/'
-    {0x00,0x00,0x00,0x00,0x02,0x06,0x0C,0x18,0x30,0x60,0xC0,0x80,0x00,0x00,0x00,0x00},
-    // 0x30 数字 '0'
-    {0x00,0x00,0x3C,0x66,0xC3,0xC3,0xDB,0xDB,0xC3,0xC3,0x66,0x3C,0x00,0x00,0x00,0x00},
-    // 0x31 数字 '1'
-    {0x00,0x00,0x18,0x38,0x78,0x18,0x18,0x18,0x18,0x18,0x18,0x7E,0x00,0x00,0x00,0x00},
-    // 0x32 数字 '2'
-    {0x00,0x00,0x7C,0xC6,0x06,0x0C,0x18,0x30,0x60,0xC0,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // 0x33 数字 '3'
-    {0x00,0x00,0x7C,0xC6,0x06,0x06,0x3C,0x06,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x34 数字 '4'
-    {0x00,0x00,0x0C,0x1C,0x3C,0x6C,0xCC,0xFE,0x0C,0x0C,0x0C,0x1E,0x00,0x00,0x00,0x00},
-    // 0x35 数字 '5'
-    {0x00,0x00,0xFE,0xC0,0xC0,0xC0,0xFC,0x06,0x06,0x06,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x36 数字 '6'
-    {0x00,0x00,0x38,0x60,0xC0,0xC0,0xFC,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x37 数字 '7'
-    {0x00,0x00,0xFE,0xC6,0x06,0x06,0x0C,0x18,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00},
-    // 0x38 数字 '8'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7C,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x39 数字 '9'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0x7E,0x06,0x06,0x06,0x0C,0x78,0x00,0x00,0x00,0x00},
-    // 0x3A 冒号 ':'
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x00,0x00},
-    // 0x3B 分号 ';'
-    {0x00,0x00,0x00,0x00,0x18,0x18,0x00,0x00,0x00,0x18,0x18,0x30,0x00,0x00,0x00,0x00},
-    // 0x3C 小于号 '<'
-    {0x00,0x00,0x00,0x06,0x0C,0x18,0x30,0x60,0x30,0x18,0x0C,0x06,0x00,0x00,0x00,0x00},
-    // 0x3D 等于号 '='
-    {0x00,0x00,0x00,0x00,0x00,0x7E,0x00,0x00,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x3E 大于号 '>'
-    {0x00,0x00,0x00,0x60,0x30,0x18,0x0C,0x06,0x0C,0x18,0x30,0x60,0x00,0x00,0x00,0x00},
-    // 0x3F 问号 '?'
-    {0x00,0x00,0x7C,0xC6,0xC6,0x0C,0x18,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x40 @ 符号 '@'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xDE,0xDE,0xDE,0xDC,0xC0,0x7C,0x00,0x00,0x00,0x00,0x00},
-    // 0x41 大写字母 'A'
-    {0x00,0x00,0x10,0x38,0x6C,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x42 大写字母 'B'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x66,0x66,0x66,0x66,0xFC,0x00,0x00,0x00,0x00},
-    // 0x43 大写字母 'C'
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xC0,0xC0,0xC2,0x66,0x3C,0x00,0x00,0x00,0x00},
-    // 0x44 大写字母 'D'
-    {0x00,0x00,0xF8,0x6C,0x66,0x66,0x66,0x66,0x66,0x66,0x6C,0xF8,0x00,0x00,0x00,0x00},
-    // 0x45 大写字母 'E'
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00},
-    // 0x46 大写字母 'F'
-    {0x00,0x00,0xFE,0x66,0x62,0x68,0x78,0x68,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 0x47 大写字母 'G'
-    {0x00,0x00,0x3C,0x66,0xC2,0xC0,0xC0,0xDE,0xC6,0xC6,0x66,0x3A,0x00,0x00,0x00,0x00},
-    // 0x48 大写字母 'H'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xFE,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x49 大写字母 'I'
-    {0x00,0x00,0x3C,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 0x4A 大写字母 'J'
-    {0x00,0x00,0x1E,0x0C,0x0C,0x0C,0x0C,0x0C,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00},
-    // 0x4B 大写字母 'K'
-    {0x00,0x00,0xE6,0x66,0x66,0x6C,0x78,0x78,0x6C,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 0x4C 大写字母 'L'
-    {0x00,0x00,0xF0,0x60,0x60,0x60,0x60,0x60,0x60,0x62,0x66,0xFE,0x00,0x00,0x00,0x00},
-    // 0x4D 大写字母 'M'
-    {0x00,0x00,0xC6,0xEE,0xFE,0xFE,0xD6,0xC6,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x4E 大写字母 'N'
-    {0x00,0x00,0xC6,0xE6,0xF6,0xFE,0xDE,0xCE,0xC6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x4F 大写字母 'O'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x50 大写字母 'P'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 0x51 大写字母 'Q'
-    {0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xD6,0xDE,0x7C,0x0C,0x0E,0x00,0x00},
-    // 0x52 大写字母 'R'
-    {0x00,0x00,0xFC,0x66,0x66,0x66,0x7C,0x6C,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 0x53 大写字母 'S'
-    {0x00,0x00,0x7C,0xC6,0xC6,0x60,0x38,0x0C,0x06,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x54 大写字母 'T'
-    {0x00,0x00,0x7E,0x7E,0x5A,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 0x55 大写字母 'U'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x56 大写字母 'V'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x10,0x00,0x00,0x00,0x00},
-    // 0x57 大写字母 'W'
-    {0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0xEE,0x6C,0x00,0x00,0x00,0x00},
-    // 0x58 大写字母 'X'
-    {0x00,0x00,0xC6,0xC6,0x6C,0x7C,0x38,0x38,0x7C,0x6C,0xC6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x59 大写字母 'Y'
-    {0x00,0x00,0x66,0x66,0x66,0x66,0x3C,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 0x5A 大写字母 'Z'
-    {0x00,0x00,0xFE,0xC6,0x86,0x0C,0x18,0x30,0x60,0xC2,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // 0x5B 左方括号 '['
-    {0x00,0x00,0x3C,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x3C,0x00,0x00,0x00,0x00},
-    // 0x5C 反斜杠 '\'
-    {0x00,0x00,0x00,0x80,0xC0,0xE0,0x70,0x38,0x1C,0x0E,0x06,0x02,0x00,0x00,0x00,0x00},
-    // 0x5D 右方括号 ']'
-    {0x00,0x00,0x3C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x3C,0x00,0x00,0x00,0x00},
-    // 0x5E 脱字符 '^'
-    {0x10,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x5F 下划线 '_'
-    {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,0x00},
-    // 0x60 反引号 '`'
-    {0x30,0x30,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
-    // 0x61 小写字母 'a'
-    {0x00,0x00,0x00,0x00,0x00,0x78,0x0C,0x7C,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 0x62 小写字母 'b'
-    {0x00,0x00,0xE0,0x60,0x60,0x78,0x6C,0x66,0x66,0x66,0x66,0x7C,0x00,0x00,0x00,0x00},
-    // 0x63 小写字母 'c'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC0,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x64 小写字母 'd'
-    {0x00,0x00,0x1C,0x0C,0x0C,0x3C,0x6C,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 0x65 小写字母 'e'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xFE,0xC0,0xC0,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x66 小写字母 'f'
-    {0x00,0x00,0x38,0x6C,0x64,0x60,0xF0,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 0x67 小写字母 'g'
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0xCC,0x78,0x00},
-    // 0x68 小写字母 'h'
-    {0x00,0x00,0xE0,0x60,0x60,0x6C,0x76,0x66,0x66,0x66,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 0x69 小写字母 'i'
-    {0x00,0x00,0x18,0x18,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 0x6A 小写字母 'j'
-    {0x00,0x00,0x06,0x06,0x00,0x0E,0x06,0x06,0x06,0x06,0x06,0x06,0x66,0x66,0x3C,0x00},
-    // 0x6B 小写字母 'k'
-    {0x00,0x00,0xE0,0x60,0x60,0x66,0x6C,0x78,0x78,0x6C,0x66,0xE6,0x00,0x00,0x00,0x00},
-    // 0x6C 小写字母 'l'
-    {0x00,0x00,0x38,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00},
-    // 0x6D 小写字母 'm'
-    {0x00,0x00,0x00,0x00,0x00,0xEC,0xFE,0xD6,0xD6,0xD6,0xD6,0xC6,0x00,0x00,0x00,0x00},
-    // 0x6E 小写字母 'n'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00},
-    // 0x6F 小写字母 'o'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0xC6,0xC6,0xC6,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x70 小写字母 'p'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x66,0x66,0x66,0x66,0x66,0x7C,0x60,0x60,0xF0,0x00},
-    // 0x71 小写字母 'q'
-    {0x00,0x00,0x00,0x00,0x00,0x76,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0x0C,0x1E,0x00},
-    // 0x72 小写字母 'r'
-    {0x00,0x00,0x00,0x00,0x00,0xDC,0x76,0x66,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00},
-    // 0x73 小写字母 's'
-    {0x00,0x00,0x00,0x00,0x00,0x7C,0xC6,0x60,0x38,0x0C,0xC6,0x7C,0x00,0x00,0x00,0x00},
-    // 0x74 小写字母 't'
-    {0x00,0x00,0x10,0x30,0x30,0xFC,0x30,0x30,0x30,0x30,0x36,0x1C,0x00,0x00,0x00,0x00},
-    // 0x75 小写字母 'u'
-    {0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00},
-    // 0x76 小写字母 'v'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0x6C,0x38,0x00,0x00,0x00,0x00},
-    // 0x77 小写字母 'w'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xD6,0xD6,0xD6,0xFE,0x6C,0x00,0x00,0x00,0x00},
-    // 0x78 小写字母 'x'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0x6C,0x38,0x38,0x38,0x6C,0xC6,0x00,0x00,0x00,0x00},
-    // 0x79 小写字母 'y'
-    {0x00,0x00,0x00,0x00,0x00,0xC6,0xC6,0xC6,0xC6,0xC6,0xC6,0x7E,0x06,0x0C,0xF8,0x00},
-    // 0x7A 小写字母 'z'
-    {0x00,0x00,0x00,0x00,0x00,0xFE,0xCC,0x18,0x30,0x60,0xC6,0xFE,0x00,0x00,0x00,0x00},
-    // 0x7B 左花括号 '{'
-    {0x00,0x00,0x0E,0x18,0x18,0x18,0x70,0x18,0x18,0x18,0x18,0x0E,0x00,0x00,0x00,0x00},
-    // 0x7C 竖线 '|'
-    {0x00,0x00,0x18,0x18,0x18,0x18,0x00,0x18,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00},
-    // 0x7D 右花括号 '}'
-    {0x00,0x00,0x70,0x18,0x18,0x18,0x0E,0x18,0x18,0x18,0x18,0x70,0x00,0x00,0x00,0x00},
-    // 0x7E 波浪号 '~'
-    {0x00,0x00,0x76,0xDC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}
-};
+const uint8_t *FNT_FindGlyph(const FNT_Font_t *font, uint32_t code)
+{
+    uint32_t lo = 0, hi = font->count, mid;
+    uint16_t c;
 
-/**
- * @brief 32x32像素数字字体数据数组 (0-9)
- * @details 包含0-9数字的32x32像素字模数据，用于大号数字显示
- */
-const unsigned char sz32[]={
-#if USE_ONCHIP_FLASH_FONT
-//"0",
-0x00,0x00,0x00,0x00,0x00,0x1F,0xE0,0x00,0x00,0x3F,0xF0,0x00,0x00,0x3F,0xF0,0x00,0x00,0x1F,0xE0,0x00,0x01,0x80,0x06,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x00,0x03,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x03,0xC0,0x0F,0x00,0x01,0x80,0x06,0x00,0x00,0x1F,0xE0,0x00,0x00,0x3F,0xF0,0x00,0x00,0x3F,0xF0,0x00,0x00,0x1F,0xE0,0x00,
-//"1",
-0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0x00,0x00,0x01,0x80,0x00,0x00,0x03,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x01,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x07,0x80,0x00,0x00,0x03,0x80,0x00,0x00,0x01,0x80,0x00,0x00,0x00,0x80,0x00,0x00,0x00,0x00,0x00,
-#endif
-0x00,
-};
+    if(code > 0xFFFF) return NULL;      // 码点表只有16位
 
-/**
- * @brief 16x16中文字符字模数据数组
- * @details 存储16x16像素中文字符的字模数据
- */
-const struct typFNT_GB162 hz16[] = {
-#if USE_ONCHIP_FLASH_FONT
-{"孙", {0x00,0x20,0x7E,0x20,0x02,0x20,0x04,0x20,0x08,0x20,0x08,0xA8,0x0A,0xA4,0x0C,0xA4,0x39,0x22,0xC9,0x22,0x0A,0x22,0x08,0x20,0x08,0x20,0x08,0x20,0x28,0xA0,0x10,0x40}},
-{"涵", {0x00,0x00,0x23,0xF8,0x10,0x10,0x10,0x20,0x84,0x44,0x45,0x54,0x44,0xE4,0x14,0x44,0x14,0xE4,0x25,0x54,0xE6,0x4C,0x25,0x44,0x24,0x84,0x24,0x04,0x27,0xFC,0x00,0x04}},
-{"晴", {0x00,0x20,0x00,0x20,0x7B,0xFE,0x48,0x20,0x49,0xFC,0x48,0x20,0x4B,0xFE,0x78,0x00,0x08,0x20,0x08,0x20,0x3F,0xFC,0x20,0x20,0x23,0xE8,0x22,0x28,0x23,0xE8,0x22,0x08}},
-#endif
-{"", {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}}
-};
+    while(lo < hi)
+    {
+        mid = (lo + hi) >> 1;
+        c = font->codes[mid];
+        if(c == code)
+            return font->bitmaps + mid * font->glyph_bytes;
+        if(c < code)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return NULL;
+}
 
 /**
- * @brief 24x24中文字符字模数据数组
- * @details 存储24x24像素中文字符的字模数据
+ * @brief  从UTF-8字符串中取出一个码点并前进
+ * @param  s: 字符串指针的地址，返回后指向下一个字符
+ * @return Unicode码点；字节序列不合法时返回FNT_CODE_INVALID并跳过不合法的字节
+ * @note   调用前保证**s不是结束符；残缺的多字节序列不会越过结束符
  */
-const struct typFNT_GB242 hz24[] = {
-#if USE_ONCHIP_FLASH_FONT
-{"霖",{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0x0F,0xFF,0xE0,0x00,0x10,0x00,0x1F,0xFF,0xF8,0x10,0x10,0x08,0x37,0xD3,0xD0,0x20,0x10,0x00,0x07,0xD3,0xC0,0x02,0x11,0x00,0x01,0x01,0x80,0x01,0x01,0x00,0x3F,0xFF,0xF8,0x03,0x03,0x80,0x03,0x83,0x40,0x07,0x67,0x40,0x05,0x25,0x20,0x09,0x09,0x10,0x11,0x11,0x0C,0x21,0x21,0x04,0x41,0x41,0x00,0x01,0x00,0x00,0x00,0x00,0x00}},  /* "霖"字字模 */
-#endif
-{"",{0x00}}  /* 数组结束标记 */
-};
-
-
-const unsigned char gImage_humo_nei[768] = { 0X00,0X10,0X13,0X00,0X14,0X00,0X01,0X1B,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XBB,0X14,0XDB,0X1C,0XFF,0XFF,0XFD,0X75,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XBB,0X14,0X9C,0X55,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X5E,0XCF,
-0XBB,0X14,0XBB,0X14,0X7F,0XDF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBE,0XA6,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XBB,0X14,0XBB,0X14,0X5D,0X86,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XDB,0X1C,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBE,0X9E,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X1B,0X35,0XBB,0X14,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFD,0X6D,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0X1D,0X76,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,
-0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XDB,0X1C,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XBB,0X14,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XBB,0X14,0XDC,0X65,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XBC,0X55,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,
-0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X1E,0XBF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBF,0XEF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X1B,0X2D,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,
-0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBF,0XEF,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0X7F,0XDF,};
-
-
-
-
-const unsigned char gImage_temp_nei[728] = { 0X00,0X10,0X14,0X00,0X12,0X00,0X01,0X1B,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFB,0X24,0X9C,0X4D,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0X1B,0X2D,0XBB,0X14,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0X1E,0XBF,0XFF,0XFF,0XFF,0XFF,0X7C,0X4D,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBF,0XEF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X5D,0X86,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0X7F,0XDF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X1D,0X7E,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0X5C,0X3D,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X1D,0X7E,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,
-0X5D,0X86,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X1D,0X7E,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X1D,0X7E,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X1D,0X7E,0XFF,0XFF,0XFF,0XFF,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDB,0X1C,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X1B,0X2D,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XBF,0XEF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X1E,0XBF,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0X1E,0XBF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-};
+uint32_t FNT_Utf8Next(const char **s)
+{
+    const uint8_t *p = (const uint8_t *)*s;
+    uint32_t code = p[0];
+    uint8_t n, i;
 
+    if(code < 0x80)
+    {
+        *s += 1;
+        return code;
+    }
 
-const unsigned char gImage_temp_wai[768] = { 0X00,0X10,0X13,0X00,0X14,0X00,0X01,0X1B,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XBB,0X14,0X9D,0X96,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBF,0XEF,0XBB,0X14,0XFD,0X6D,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDB,0X1C,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0X3D,0X7E,0XBB,0X14,0X9F,0XE7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XDB,0X1C,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0X5D,0X86,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0X9D,0X96,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFB,0X24,0XBB,0X14,0X9F,0XE7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X9D,0X96,0XBB,0X14,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0X3D,0X86,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0X3D,0X86,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFB,0X24,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0X7D,0X96,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDF,0XEF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XBE,0XA6,0XBB,0X14,0XFF,0XFF,0X5C,0X45,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDE,0XAE,0XBB,0X14,0XFF,0XFF,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XFF,0XFF,
-0XFF,0XFF,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XBB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XBF,0XEF,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XDB,0X14,0XBB,0X14,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0X7C,0X4D,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XDF,0XF7,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,0XBB,0X14,
-0XBB,0X14,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,
-0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,0XFF,};
+    if((code & 0xE0) == 0xC0)      { n = 1; code &= 0x1F; }
+    else if((code & 0xF0) == 0xE0) { n = 2; code &= 0x0F; }
+    else if((code & 0xF8) == 0xF0) { n = 3; code &= 0x07; }
+    else
+    {
+        *s += 1;                    // 单独的后续字节或非法首字节
+        return FNT_CODE_INVALID;
+    }
 
-const unsigned char gImage_1[3288] = { 0X00,0X10,0X28,0X00,0X29,0X00,0X01,0X1B,
-0X60,0X20,0XA7,0XD4,0X67,0XD4,0X26,0XD4,0X07,0XD4,0X06,0XD4,0XC6,0XCB,0XF1,0XE5,
-0X06,0XDC,0X87,0XDC,0X47,0XDC,0XC8,0XE4,0XC8,0XE4,0X09,0XF5,0X69,0XF5,0XA8,0XF5,
-0XE8,0XF5,0X29,0XEE,0X68,0XEE,0X89,0XEE,0XD4,0XF6,0XBC,0XFF,0XDE,0XFF,0XFF,0XFF,
-0XDF,0XFF,0X54,0XAD,0X74,0XAD,0X74,0XAD,0X75,0XB5,0X74,0XB5,0X74,0XB5,0X33,0XAD,
-0X8D,0X73,0XAE,0X73,0X13,0XA5,0X33,0XAD,0X34,0XAD,0X34,0XAD,0X54,0XAD,0X54,0XAD,
-0X0A,0X9C,0XA7,0XD4,0X67,0XD4,0X67,0XDC,0X27,0XDC,0X07,0XD4,0XE6,0XD3,0X27,0XDC,
-0XC6,0XD3,0XC6,0XD3,0X67,0XDC,0XE8,0XE4,0X09,0XED,0XC8,0XE4,0X28,0XF5,0XC9,0XF5,
-0XE9,0XF5,0X08,0XEE,0X28,0XEE,0X48,0XEE,0XDC,0XFF,0X3B,0XF7,0X3B,0XF7,0X8D,0XD5,
-0X2B,0XE6,0X6D,0XC5,0XB5,0XBD,0XB5,0XB5,0XB5,0XBD,0XD6,0XBD,0XB5,0XBD,0X95,0XB5,
-0X89,0X4A,0XAD,0X73,0X95,0XB5,0X95,0XB5,0X95,0XB5,0X95,0XBD,0X94,0XBD,0X16,0XCE,
-0X58,0XCE,0X08,0XD5,0X47,0XD4,0X67,0XD4,0X26,0XD4,0X07,0XD4,0X06,0XDC,0XE6,0XD3,
-0XC6,0XD3,0X07,0XDC,0X46,0XDC,0X29,0XF5,0XE8,0XEC,0X29,0XF5,0X89,0XF5,0X89,0XF5,
-0X89,0XF5,0X88,0XED,0XC9,0XF5,0X29,0XF6,0X08,0XF6,0X7C,0XFF,0X37,0XD6,0XB8,0XE6,
-0X88,0XEE,0XA9,0XF6,0X49,0XF6,0XCA,0XE6,0XB5,0XB5,0XF5,0XBD,0XF5,0XBD,0XF6,0XBD,
-0XB6,0XB5,0XD6,0XBD,0X37,0XC6,0X16,0XBE,0XD5,0XBD,0XF6,0XBD,0XF6,0XC5,0X37,0XCE,
-0XD6,0XBD,0XD5,0XC5,0X87,0XD4,0X67,0XD4,0X27,0XD4,0X07,0XD4,0XE6,0XD3,0X07,0XDC,
-0XE6,0XD3,0X06,0XDC,0XA8,0XE4,0X08,0XF5,0X28,0XF5,0X48,0XF5,0X28,0XED,0X89,0XF5,
-0XC8,0XF5,0X47,0XDC,0X67,0XE4,0X08,0XED,0X69,0XF5,0XC8,0XE4,0X78,0XDE,0X12,0XAD,
-0XF8,0XEE,0X29,0XEE,0XA9,0XEE,0XE8,0XED,0X69,0XEE,0XAA,0XEE,0X15,0XC6,0XF6,0XC5,
-0XF6,0XC5,0XF6,0XC5,0X16,0XC6,0XF6,0XCD,0X16,0XCE,0X16,0XCE,0X37,0XCE,0X57,0XD6,
-0XD6,0XBD,0XD6,0XBD,0XC7,0XD4,0XA7,0XD4,0XE6,0XCB,0X06,0XD4,0X07,0XD4,0XA5,0XC3,
-0X06,0XD4,0XC8,0XEC,0X08,0XED,0X29,0XF5,0X08,0XED,0X08,0XF5,0X08,0XED,0XC8,0XF5,
-0X6A,0XF6,0X0B,0XEE,0XA9,0XEC,0X87,0XE4,0X87,0XE4,0X29,0XF5,0X09,0XED,0X16,0XCE,
-0X5B,0XF7,0XF9,0XEE,0XC8,0XED,0X89,0XF6,0X2C,0XEF,0XE9,0XE5,0X29,0XEE,0XF2,0XEE,
-0X56,0XD6,0X36,0XCE,0X36,0XCE,0X37,0XCE,0X37,0XD6,0X37,0XCE,0X37,0XCE,0X57,0XD6,
-0XD6,0XBD,0XF7,0XC5,0XE9,0XCC,0XA7,0XD4,0X27,0XD4,0X27,0XD4,0XE6,0XCB,0XC6,0XCB,
-0X28,0XED,0XE8,0XEC,0XE8,0XEC,0XE7,0XE4,0X29,0XF5,0X49,0XF5,0X68,0XF5,0XC9,0XED,
-0X08,0XF6,0X68,0XEE,0XAA,0XEE,0X67,0XE4,0X47,0XE4,0X88,0XE4,0XA8,0XE4,0X6B,0XC4,
-0X74,0XBD,0X5B,0XFF,0X58,0XFF,0X89,0XF5,0X08,0XEE,0XE9,0XEE,0XD2,0XEE,0XE9,0XED,
-0X48,0XEE,0XD5,0XC5,0X57,0XD6,0X57,0XD6,0X57,0XD6,0X57,0XD6,0X57,0XD6,0X37,0XCE,
-0XF7,0XC5,0X17,0XC6,0XD1,0XD5,0XA7,0XDC,0X67,0XD4,0X27,0XD4,0X67,0XD4,0X27,0XD4,
-0X29,0XED,0X49,0XF5,0X28,0XED,0X08,0XF5,0XC8,0XEC,0X08,0XED,0X08,0XF5,0X48,0XF5,
-0XE9,0XF5,0X28,0XEE,0X89,0XEE,0X89,0XE6,0XC6,0XD3,0X27,0XDC,0X67,0XE4,0X47,0XDC,
-0X9A,0XFF,0X38,0XFF,0X28,0XED,0X49,0XF5,0XA9,0XF5,0XE9,0XED,0XC9,0XEE,0XF0,0XEE,
-0X74,0XFF,0X07,0XEE,0XAC,0XE6,0X98,0XDE,0X98,0XDE,0X77,0XD6,0XF6,0XBD,0XB2,0X94,
-0X37,0XCE,0X38,0XCE,0XB1,0XCD,0X87,0XD4,0X67,0XD4,0X27,0XCC,0X4A,0XED,0X67,0XDC,
-0X28,0XF5,0X48,0XF5,0X08,0XED,0XE8,0XF4,0XA6,0XD3,0X67,0XE4,0XC8,0XEC,0X08,0XED,
-0X69,0XF5,0XA8,0XF5,0X09,0XF6,0X89,0XF6,0X70,0XFF,0X24,0XB3,0XE6,0XD3,0X07,0XD4,
-0X47,0XDC,0X67,0XE4,0XC8,0XEC,0XA8,0XEC,0X09,0XED,0X69,0XF5,0XE8,0XED,0XA9,0XEE,
-0XCD,0XEE,0XF3,0XF6,0X0B,0XE6,0X68,0XEE,0X16,0XE7,0X78,0XD6,0XD8,0XD6,0X18,0XE7,
-0X58,0XCE,0X58,0XD6,0X47,0XCC,0XA8,0XDC,0X27,0XD4,0X06,0XCC,0X47,0XD4,0X28,0XED,
-0X49,0XF5,0X69,0XF5,0XC8,0XEC,0X47,0XE4,0X27,0XCC,0XE6,0XD3,0X47,0XDC,0XA7,0XE4,
-0X28,0XF5,0X28,0XF5,0X48,0XF5,0X09,0XF6,0X48,0XEE,0X89,0XEE,0X23,0X7A,0XC6,0XC3,
-0X27,0XDC,0X27,0XDC,0X67,0XE4,0X47,0XDC,0X67,0XDC,0X87,0XE4,0X29,0XF5,0X68,0XED,
-0X28,0XEE,0X0C,0XF7,0X6F,0XE6,0XF3,0XEE,0X48,0XEE,0XA9,0XEE,0X97,0XD6,0X53,0XAD,
-0X78,0XD6,0X15,0XD6,0X06,0XC4,0X07,0XCC,0XC6,0XCB,0X87,0XDC,0X09,0XED,0XC8,0XEC,
-0X49,0XF5,0X49,0XF5,0XE8,0XEC,0X68,0XDC,0X86,0XA3,0XEA,0XD4,0XA7,0XD4,0X47,0XDC,
-0XA8,0XE4,0X08,0XF5,0X49,0XF5,0XC8,0XF5,0X08,0XEE,0XC9,0XEE,0X72,0XF7,0X00,0X10,
-0X45,0X9B,0XE6,0XC3,0X47,0XDC,0X47,0XDC,0X06,0XD4,0X67,0XE4,0X87,0XE4,0XE8,0XEC,
-0X88,0XED,0XC8,0XED,0X0C,0XF7,0XCE,0XE5,0X75,0XFF,0X94,0XFF,0X89,0XEE,0XD5,0XBD,
-0X99,0XDE,0XA6,0XCC,0X07,0XCC,0XA6,0XCB,0XA6,0XCB,0X09,0XDD,0X28,0XED,0XE8,0XEC,
-0XC8,0XE4,0XA8,0XEC,0XA8,0XE4,0XE8,0XEC,0X09,0XAC,0XE0,0X40,0X28,0XBC,0X47,0XD4,
-0X88,0XE4,0XA8,0XEC,0XE8,0XEC,0X49,0XF5,0XA8,0XF5,0X49,0XF6,0X89,0XEE,0XE0,0X28,
-0X20,0X08,0XE2,0X30,0XC6,0XB3,0X06,0XCC,0XA6,0XCB,0X07,0XD4,0X67,0XDC,0X67,0XE4,
-0XA8,0XEC,0X89,0XFD,0XC9,0XF5,0XCB,0XF6,0X0E,0XEE,0XD2,0XF6,0X13,0XF7,0XA8,0XEE,
-0XD9,0XDE,0X87,0XD4,0X07,0XCC,0XC6,0XCB,0X85,0XC3,0X08,0XDD,0X28,0XE5,0XE8,0XEC,
-0X87,0XE4,0X88,0XE4,0XA7,0XE4,0X09,0XED,0X86,0X6A,0X00,0X00,0X20,0X10,0X2D,0XD5,
-0XA8,0XDC,0X67,0XDC,0X87,0XE4,0XA8,0XEC,0XE8,0XEC,0X88,0XF5,0X28,0XEE,0XA9,0XEE,
-0X80,0X18,0X20,0X08,0X00,0X00,0X47,0X8B,0XC6,0XC3,0XE7,0XD3,0X27,0XD4,0X67,0XDC,
-0X47,0XDC,0XA8,0XEC,0X49,0XF5,0XC9,0XF5,0X89,0XEE,0X8C,0XE5,0X95,0XFF,0XD3,0XEE,
-0XC8,0XC4,0X67,0XD4,0X07,0XD4,0XC6,0XD3,0X85,0XBB,0XE7,0XDC,0XC8,0XE4,0XA8,0XE4,
-0X47,0XDC,0X87,0XE4,0X67,0XDC,0XA8,0XD4,0X00,0X08,0X00,0X00,0X20,0X08,0X40,0X28,
-0X2C,0XD5,0X0A,0XDD,0X67,0XDC,0X88,0XE4,0XE8,0XEC,0X49,0XF5,0XA8,0XF5,0X69,0XF6,
-0XC9,0XEE,0X60,0X10,0X20,0X00,0X00,0X00,0XA4,0X49,0X6A,0XCC,0XC6,0XD3,0X47,0XDC,
-0X67,0XDC,0X67,0XDC,0X87,0XE4,0XE8,0XEC,0X68,0XED,0XCC,0XF6,0XED,0XE5,0XF4,0XEE,
-0XE8,0XD4,0X67,0XDC,0X06,0XD4,0XA6,0XCB,0XA9,0XD4,0XA7,0XD4,0X47,0XDC,0X67,0XE4,
-0X67,0XE4,0X87,0XE4,0X47,0XDC,0XEB,0XCC,0X00,0X00,0X81,0X20,0XC5,0X51,0XA8,0X82,
-0XA5,0X82,0X8E,0XDD,0XAD,0XDD,0X06,0XDC,0X87,0XE4,0XC8,0XEC,0X29,0XF5,0X88,0XED,
-0X08,0XEE,0XCB,0XEE,0X20,0X10,0X20,0X00,0X00,0X00,0X40,0X10,0XA7,0XA3,0X06,0XCC,
-0XE6,0XCB,0XA8,0XE4,0X47,0XDC,0X26,0XDC,0XE8,0XEC,0X28,0XED,0XA9,0XD5,0X70,0XF6,
-0X87,0XD4,0X67,0XDC,0X07,0XD4,0XA6,0XD3,0XCB,0XCC,0XA7,0XDC,0XA8,0XE4,0X87,0XE4,
-0X88,0XE4,0X06,0XD4,0X88,0XDC,0X63,0X39,0X40,0X18,0XE5,0X59,0X09,0X93,0X8B,0XA3,
-0XAB,0XAB,0XCA,0XAB,0X4D,0XD5,0X8D,0XDD,0X87,0XE4,0X67,0XE4,0XC8,0XE4,0X28,0XED,
-0X89,0XF5,0X08,0XEE,0X52,0XF7,0X20,0X08,0X00,0X00,0X00,0X00,0X00,0X00,0X6C,0XB4,
-0X26,0XCC,0XA6,0XC3,0XA5,0XCB,0XC8,0XEC,0XC8,0XE4,0XC7,0XE4,0X08,0XEE,0X72,0XF6,
-0X87,0XDC,0X67,0XDC,0X06,0XD4,0XC6,0XD3,0XAA,0XC4,0X87,0XD4,0XC8,0XE4,0X87,0XE4,
-0X47,0XDC,0X67,0XDC,0X67,0XD4,0X80,0X20,0XA0,0X28,0XE9,0X92,0XCC,0XAB,0XEC,0XB3,
-0X2D,0XBC,0XEC,0XB3,0X89,0XA3,0X6D,0XDD,0XAE,0XE5,0X67,0XDC,0X67,0XE4,0XC7,0XE4,
-0XA9,0XF5,0XA8,0XED,0X69,0XF6,0X21,0X31,0X20,0X08,0X00,0X00,0X00,0X00,0X61,0X10,
-0XAB,0X8B,0XE6,0XC3,0X85,0XC3,0X27,0XDC,0XC8,0XEC,0X26,0XDC,0XC8,0XEC,0X4B,0XD5,
-0X87,0XDC,0X47,0XDC,0XE6,0XDB,0XA6,0XCB,0X49,0XB4,0X67,0XD4,0X87,0XDC,0X67,0XDC,
-0X47,0XDC,0XA8,0XE4,0XC8,0XDC,0XD0,0XAC,0XE1,0X38,0X09,0X9B,0XCC,0XB3,0X4E,0XBC,
-0X2E,0XBC,0X4E,0XBC,0XEC,0XB3,0XCA,0XA3,0XAE,0XDD,0X8D,0XDD,0X67,0XE4,0X88,0XE4,
-0XA7,0XE4,0X89,0XF5,0XA9,0XF5,0X08,0XEE,0X20,0X10,0X00,0X00,0X00,0X00,0X60,0X08,
-0XBC,0XF7,0X6B,0XB4,0X26,0XCC,0XE6,0XCB,0XC8,0XE4,0X67,0XE4,0XC8,0XEC,0XAA,0XED,
-0X47,0XD4,0X27,0XD4,0XE6,0XD3,0XA6,0XCB,0XC8,0XA3,0XA8,0XDC,0X67,0XDC,0X67,0XDC,
-0X47,0XDC,0XC9,0XE4,0X09,0XDD,0X40,0X10,0X22,0X41,0X09,0X9B,0XEC,0XB3,0X4E,0XBC,
-0X4E,0XC4,0X0D,0XBC,0XC9,0X8A,0X26,0X6A,0XAF,0XDD,0X8E,0XDD,0XAF,0XE5,0X47,0XDC,
-0XA8,0XE4,0X29,0XF5,0X08,0XED,0XA8,0XED,0X8A,0XE6,0X60,0X10,0X20,0X08,0X40,0X10,
-0XBC,0XF7,0X16,0XCE,0XC9,0XD4,0X47,0XDC,0XE9,0XEC,0X87,0XE4,0X67,0XE4,0XCA,0XF5,
-0X26,0XD4,0X27,0XDC,0XE6,0XD3,0XA6,0XCB,0XE9,0XAB,0XA7,0XDC,0X67,0XDC,0X67,0XDC,
-0XA8,0XE4,0XC8,0XEC,0XC8,0XD4,0X60,0X18,0XE2,0X38,0XC5,0X59,0X09,0X93,0X2E,0XBC,
-0X4E,0XC4,0X4E,0XC4,0XCC,0XAB,0XED,0XB3,0XED,0XB3,0X6D,0XD5,0X8E,0XDD,0XAF,0XE5,
-0X67,0XDC,0XA8,0XEC,0X08,0XED,0X28,0XED,0X08,0XEE,0XC7,0X62,0X40,0X10,0X61,0X18,
-0X9D,0XF7,0XB9,0XD6,0XE9,0XA3,0X88,0XDC,0XC8,0XE4,0XA5,0XCB,0XC7,0XD3,0XA7,0XE4,
-0X47,0XDC,0X07,0XD4,0XE6,0XD3,0XE6,0XCB,0XE9,0XAB,0XA7,0XD4,0X47,0XDC,0X67,0XE4,
-0X67,0XE4,0X88,0XE4,0X88,0XCC,0X72,0XC5,0X26,0X6A,0X6A,0X9B,0X8B,0XAB,0XCC,0XB3,
-0X6E,0XC4,0X2E,0XBC,0XED,0XB3,0XE9,0X8A,0XC6,0X51,0XE5,0X69,0X4E,0XD5,0XAF,0XDD,
-0XAD,0XED,0X67,0XDC,0XA8,0XE4,0XE8,0XE4,0X89,0XF5,0X8A,0XEE,0X83,0X49,0X61,0X18,
-0X78,0XCE,0XD6,0XBD,0X10,0XB5,0X47,0XD4,0X88,0XE4,0X46,0XDC,0X06,0XD4,0XA7,0XE4,
-0X67,0XDC,0X07,0XDC,0XE7,0XD3,0XC6,0XC3,0XA8,0X9B,0XA7,0XD4,0X67,0XDC,0X47,0XDC,
-0X47,0XDC,0XA8,0XE4,0XE9,0XD4,0XAD,0XAC,0XE4,0X61,0XC1,0X38,0X20,0X20,0XAC,0XAB,
-0X2D,0XBC,0X0D,0XBC,0XCC,0XAB,0X0E,0XA4,0X24,0X41,0X67,0X82,0XE7,0X92,0X6F,0XDD,
-0XAF,0XE5,0X09,0XE5,0XC8,0XEC,0X09,0XF5,0X48,0XED,0XC8,0XED,0X90,0XC5,0X61,0X18,
-0XF6,0XC5,0XB5,0XC5,0X0B,0X9C,0X09,0XE5,0X46,0XD4,0X88,0XE4,0X67,0XE4,0XA7,0XDC,
-0X26,0XD4,0X27,0XDC,0XC6,0XD3,0X07,0XCC,0XA9,0X9B,0XA7,0XD4,0XA7,0XDC,0XA8,0XE4,
-0X06,0XD4,0XA8,0XE4,0X2A,0XDD,0X4F,0XCD,0X26,0X72,0X47,0X62,0XC2,0X28,0XEC,0XB3,
-0XCC,0XB3,0XCC,0XB3,0XED,0XB3,0X2E,0XBC,0X0D,0XBC,0XED,0XBB,0X0D,0XC4,0X70,0XDD,
-0XD0,0XE5,0XD0,0XE5,0XA8,0XE4,0X09,0XED,0XE8,0XE4,0X88,0XED,0X29,0XEE,0X40,0X10,
-0X68,0X52,0X52,0XB5,0X0E,0XC5,0X46,0XDC,0XC8,0XEC,0XC5,0XD3,0X09,0XF5,0X28,0XED,
-0X67,0XDC,0X26,0XDC,0XC6,0XD3,0X07,0XC4,0XA9,0X9B,0X08,0XDD,0XC7,0XDC,0XA7,0XE4,
-0X68,0XDC,0X87,0XDC,0XE8,0XDC,0X32,0XE6,0XA3,0X59,0X2A,0XA3,0XAB,0XAB,0XAC,0XAB,
-0X2E,0XBC,0XAC,0XB3,0XCC,0XB3,0X2E,0XBC,0X2E,0XBC,0X2D,0XC4,0X0D,0XC4,0XCB,0XBB,
-0X90,0XDD,0XD0,0XE5,0XEF,0XDD,0XC8,0XE4,0XE8,0XE4,0X69,0XF5,0XC8,0XED,0X61,0X18,
-0X68,0X5A,0X11,0XBD,0XEF,0XE5,0X8A,0XFD,0X89,0XF5,0X68,0XE4,0XE8,0XEC,0XA9,0XED,
-0X87,0XDC,0X47,0XD4,0XC6,0XCB,0XEC,0XD4,0X0A,0XAC,0X08,0XD5,0X47,0XDC,0XE6,0XD3,
-0X67,0XE4,0X67,0XDC,0XC8,0XDC,0X2E,0XCD,0X05,0X7A,0X8B,0XB3,0XCC,0XBB,0X8B,0XAB,
-0X8F,0XCC,0XCC,0XB3,0XED,0XBB,0X4E,0XC4,0X4E,0XC4,0X4E,0XC4,0X2D,0XC4,0XEC,0XBB,
-0X49,0XA3,0XF0,0XE5,0X11,0XEE,0X30,0XF6,0XE7,0XE4,0X49,0XF5,0XA8,0XED,0X81,0X39,
-0X47,0X5A,0X31,0XEE,0X8E,0XF6,0X27,0XE5,0X48,0XE5,0X29,0XED,0X66,0XD4,0XC5,0XAB,
-0X67,0XDC,0X47,0XDC,0XA6,0XCB,0X2E,0XDD,0XE7,0X8A,0X8D,0XDD,0X87,0XDC,0X47,0XDC,
-0X47,0XDC,0X67,0XE4,0X87,0XDC,0XAF,0XDD,0X25,0X7A,0XEC,0XBB,0X0D,0XC4,0XAC,0XB3,
-0X8F,0XD4,0X4F,0XCC,0X8B,0XB3,0X0D,0XBC,0X8F,0XCC,0X8F,0XCC,0X6E,0XCC,0XEC,0XC3,
-0X49,0XAB,0X6F,0XDD,0X10,0XE6,0X10,0XE6,0X08,0XED,0X49,0XF5,0XA9,0XF5,0XC8,0X8B,
-0X10,0XE6,0XF1,0XF6,0XE8,0XED,0XA8,0XED,0XA9,0XF5,0X69,0XF5,0X49,0XED,0XCB,0XCC,
-0X88,0XDC,0X27,0XD4,0XA5,0XCB,0XAC,0XBC,0XC7,0X82,0X48,0XAB,0XA7,0XDC,0X67,0XDC,
-0X67,0XDC,0X67,0XDC,0X87,0XDC,0X4D,0XDD,0X10,0XCD,0X0D,0XC4,0X4E,0XC4,0X4E,0XCC,
-0XED,0XC3,0X02,0X61,0XED,0XC3,0X0E,0XBC,0X8F,0XCC,0XAF,0XCC,0X8E,0XCC,0XEC,0XC3,
-0X6A,0XAB,0X6F,0XD5,0XEC,0XC4,0X10,0XE6,0X0A,0XDD,0X48,0XED,0X89,0XED,0X2C,0XC5,
-0X32,0XF7,0X48,0XEE,0X09,0XF6,0XC9,0XF5,0XAA,0XF5,0XA9,0XF5,0X28,0XB4,0X6E,0XDD,
-0X88,0XE4,0X47,0XDC,0X85,0XCB,0X2E,0XCD,0XAF,0XCC,0X09,0XAB,0X87,0XD4,0X87,0XDC,
-0X46,0XAB,0X6E,0XC4,0XEC,0XCB,0XEB,0XDC,0X54,0XEE,0XCB,0XBB,0X8E,0XCC,0XCC,0XB3,
-0XED,0XB3,0XED,0XBB,0XB0,0XC4,0X8F,0XC4,0X8F,0XC4,0X8E,0XCC,0X4D,0XC4,0XEC,0XBB,
-0X6A,0XAB,0X8F,0XD5,0XF0,0XE5,0XB0,0XDD,0XEF,0XED,0XC8,0XE4,0XA9,0XD4,0X12,0XEF,
-0X6A,0XEE,0XC8,0XF5,0XC8,0XF5,0X69,0XF5,0X47,0XDC,0X4A,0XE5,0X0D,0XCD,0X8F,0XD5,
-0X67,0XDC,0XE6,0XD3,0X24,0XBB,0XEF,0XCC,0XAF,0XCC,0X51,0XCD,0X4A,0XC4,0X72,0XDD,
-0XD0,0XD4,0X49,0XB3,0XA6,0XD3,0X88,0XE4,0XAF,0XDD,0X2D,0XB4,0X6D,0XC4,0XED,0XBB,
-0XB0,0XD4,0X0E,0XCC,0X90,0XD4,0X8F,0XC4,0X6E,0XC4,0X6E,0XC4,0X2D,0XC4,0XCC,0XBB,
-0X29,0XAB,0X4B,0XBC,0XD0,0XE5,0XCA,0XCC,0XA9,0XB3,0X07,0XAB,0X55,0XF7,0XF1,0XF6,
-0X68,0XED,0X48,0XED,0X08,0XE5,0X29,0XED,0X6E,0XD4,0X0D,0XCD,0X6E,0XD5,0XAF,0XDD,
-0X67,0XDC,0X67,0XDC,0X07,0XD4,0XB2,0XDD,0XCB,0XB3,0X10,0XC5,0X92,0XDD,0XB3,0XDD,
-0XB3,0XE5,0XD0,0XDC,0X6C,0XDC,0X27,0XDC,0XA8,0XD4,0X2F,0XD5,0XAB,0XAB,0XCC,0XBB,
-0X89,0XB2,0XC2,0X68,0X07,0XB2,0X8C,0XBB,0X6F,0XC4,0X6E,0XCC,0X4D,0XC4,0XAB,0XB3,
-0X66,0X92,0X69,0XAB,0X88,0XAB,0XEC,0XD4,0X8A,0XCC,0X0D,0XCC,0XD1,0XE5,0XE8,0XE4,
-0X28,0XED,0X28,0XE5,0X08,0XE5,0X6E,0XD4,0XED,0XCC,0X6E,0XD5,0XB0,0XDD,0X5A,0XF7,
-0X87,0XDC,0X07,0XD4,0XA6,0XC3,0X31,0XD5,0X0D,0XB4,0X31,0XCD,0XD4,0XED,0X10,0XDD,
-0XE7,0XAA,0XC5,0XB2,0XE7,0XDB,0X67,0XE4,0XA8,0XE4,0X8E,0XDD,0XCB,0XAB,0X0C,0XC4,
-0X68,0XAA,0X28,0XB2,0X8C,0XCB,0X8F,0XCC,0X8F,0XC4,0X6E,0XC4,0XEC,0XBB,0X08,0XA3,
-0XCF,0XCC,0X2E,0XCC,0X8F,0XCC,0XCF,0XCC,0XCA,0XB3,0X65,0XC3,0X6B,0XC4,0X0C,0XDD,
-0X86,0XAB,0XCA,0XB3,0X4D,0XC4,0X2F,0XD5,0X6E,0XCD,0XD0,0XD5,0XFD,0XFF,0XDE,0XFF,
-0X07,0XD4,0X85,0XCB,0X45,0XBB,0X11,0XD5,0X8F,0XCC,0XF0,0XCC,0XEF,0XDC,0XF5,0XED,
-0XD4,0XED,0XCF,0XD4,0XA6,0XCB,0X27,0XD4,0X47,0XDC,0X67,0XD4,0X8C,0XC4,0X69,0XA3,
-0X2C,0XBC,0X4D,0XBC,0X8F,0XC4,0XAF,0XCC,0XAF,0XCC,0X4D,0XC4,0X49,0XA3,0X2E,0XD5,
-0XAB,0XC4,0XCC,0XC4,0XAF,0XD4,0X4E,0XC4,0X31,0XDD,0X10,0XD5,0XC2,0X61,0XCF,0XD4,
-0X51,0XE5,0X49,0XAB,0X30,0XD5,0X6F,0XD5,0X4F,0XCD,0X1A,0XE7,0XDE,0XF7,0XDE,0XFF,
-0X47,0XDC,0X64,0XC3,0X67,0XDC,0X6B,0XCC,0XCF,0XCC,0XF0,0XD4,0X92,0XE5,0XB3,0XED,
-0XCF,0XD4,0XE4,0XAA,0X65,0XC3,0XC6,0XD3,0X47,0XDC,0X87,0XDC,0X48,0XC4,0XA5,0X51,
-0X69,0XAB,0X4E,0XC4,0X8E,0XC4,0XAF,0XC4,0X8E,0XCC,0XEC,0XBB,0X4F,0XD5,0X8F,0XDD,
-0X2D,0XCD,0XAF,0XDD,0XCE,0XD4,0XB3,0XED,0X72,0XE5,0X6E,0XCC,0XC7,0X82,0X2D,0XC4,
-0X51,0XDD,0XAF,0XCC,0X2F,0XCD,0X04,0X6A,0X8F,0XD4,0XBD,0XFF,0XDE,0XFF,0XBD,0XF7,
-0X06,0XD4,0XE6,0XCB,0X67,0XDC,0X07,0XCC,0XAF,0XC4,0XD0,0XC4,0XD0,0XD4,0X11,0XDD,
-0X29,0X9B,0X81,0X71,0X45,0XBB,0X85,0XCB,0X27,0XDC,0X47,0XD4,0X26,0XCC,0X43,0X41,
-0X40,0X10,0X4A,0XA3,0X4D,0XC4,0X4D,0XC4,0X0C,0XB4,0XC7,0X92,0X8F,0XDD,0XAF,0XDD,
-0XD0,0XDD,0X0C,0XDD,0X45,0XBB,0X11,0XDD,0XB3,0XED,0XCF,0XD4,0X46,0X82,0X10,0XDD,
-0X10,0XD5,0XCF,0XC4,0X23,0X31,0X81,0X10,0XD4,0XD5,0XDE,0XFF,0XDE,0XFF,0XDE,0XFF,
-0XE6,0XCB,0XC5,0XCB,0X67,0XDC,0X27,0XD4,0XEF,0XCC,0X8F,0XC4,0XAF,0XCC,0X31,0XDD,
-0X4A,0XA3,0X67,0X92,0X66,0XBB,0X65,0XC3,0XC6,0XCB,0XE6,0XCB,0X47,0XCC,0X41,0X49,
-0X23,0X39,0X20,0X10,0X46,0X7A,0XC4,0X69,0XE3,0X71,0XEE,0XCC,0XD0,0XDD,0XD0,0XDD,
-0X47,0XD4,0X85,0XC3,0X04,0XB3,0XCF,0XD4,0X31,0XDD,0XD0,0XD4,0XCF,0XD4,0X2F,0XDD,
-0XA1,0X20,0X61,0X10,0XA1,0X20,0XE2,0X20,0XA1,0X20,0X1B,0XE7,0XFB,0XE6,0XFB,0XE6,
-0XA8,0XDC,0X27,0XD4,0XE6,0XCB,0X06,0XD4,0X4B,0XC4,0XAF,0XC4,0XD0,0XCC,0X31,0XDD,
-0XD0,0XD4,0X2A,0XAB,0X02,0X82,0X85,0XC3,0XC7,0XD3,0XC6,0XCB,0XC4,0X92,0XE4,0X59,
-0X66,0X6A,0X46,0XB3,0X65,0XBB,0XE7,0XCB,0X65,0XB3,0X4E,0XD5,0XAF,0XDD,0X67,0XD4,
-0X27,0XCC,0XE4,0XB2,0X11,0XDD,0X51,0XE5,0X11,0XDD,0XF0,0XD4,0X10,0XD5,0X0A,0X7B,
-0X24,0X31,0X50,0X8C,0XAE,0X7B,0X44,0X29,0X45,0X29,0X0F,0X84,0X79,0XD6,0X79,0XDE,
-0XA7,0XDC,0XC6,0XCB,0XE6,0XCB,0XC6,0XCB,0X45,0XC3,0XAF,0XC4,0XD0,0XCC,0X31,0XD5,
-0X31,0XDD,0X6B,0XAB,0X65,0X8A,0X86,0XBB,0X65,0XB3,0X83,0X9A,0X45,0XB3,0XC6,0XCB,
-0XA6,0XCB,0X86,0XD3,0X86,0XD3,0XA6,0XCB,0XA6,0XBB,0X4F,0XD5,0XC8,0XD4,0X65,0XC3,
-0X04,0XAB,0XF1,0XDC,0X51,0XDD,0X31,0XDD,0X30,0XD5,0X10,0XD5,0X31,0XCD,0X2F,0X94,
-0X07,0X4A,0X07,0X4A,0X13,0XAD,0X71,0X94,0X69,0X52,0XA6,0X39,0X12,0XB5,0XF5,0XD5,
-0XAC,0XBC,0XC7,0XDC,0X47,0XDC,0XC6,0XD3,0XA6,0XCB,0XD0,0XCC,0XF0,0XCC,0X31,0XD5,
-0X51,0XD5,0XAF,0XCC,0X68,0XAB,0X63,0X9A,0X05,0XBB,0X85,0XCB,0X66,0XCB,0X86,0XD3,
-0XE6,0XDB,0XE6,0XD3,0XC6,0XCB,0X06,0XCC,0X66,0X82,0X6A,0XA3,0X66,0XC4,0XA6,0XBB,
-0XF0,0XD4,0X32,0XD5,0X72,0XDD,0XF0,0XCC,0X10,0XCD,0X10,0XCD,0X8D,0X7B,0XAA,0X5A,
-0XAE,0X7B,0XAA,0X5A,0X13,0XAD,0X6D,0X73,0X89,0X5A,0X50,0X9C,0X74,0XC5,0XD5,0XCD,
-0X0A,0XD5,0X08,0XDD,0X87,0XD4,0XC6,0XCB,0X65,0XC3,0XCD,0XDC,0X11,0XCD,0X31,0XD5,
-0X72,0XD5,0X31,0XD5,0XEA,0XB3,0X65,0XC3,0X86,0XCB,0XA6,0XD3,0XE6,0XD3,0X27,0XDC,
-0X06,0XDC,0X06,0XD4,0X47,0XCC,0XC5,0X61,0XA8,0X8A,0X6A,0XA3,0X69,0XA3,0XAD,0XCC,
-0X52,0XD5,0X72,0XD5,0X51,0XD5,0X10,0XCD,0X10,0XCD,0X90,0XA4,0X94,0XC5,0X4F,0X94,
-0XAE,0X83,0X89,0X5A,0X14,0XAD,0X14,0XB5,0XAD,0X83,0X53,0XBD,0XF5,0XCD,0X98,0XE6,
-0XEF,0X83,0X8F,0XDD,0X2C,0XD5,0XE8,0XE4,0X47,0XD4,0X07,0XD4,0X11,0XCD,0X31,0XCD,
-0X52,0XD5,0X72,0XD5,0X8E,0XCC,0X45,0XC3,0XA6,0XCB,0XE6,0XD3,0X27,0XDC,0X26,0XD4,
-0X88,0XD4,0XCE,0XC4,0X0D,0XA4,0XC5,0X59,0X88,0X82,0X09,0X93,0X29,0X9B,0X31,0XCD,
-0X72,0XD5,0X72,0XD5,0X31,0XD5,0X10,0XD5,0XB3,0XCD,0X33,0XB5,0X2F,0X94,0X2F,0X94,
-0XD6,0XC5,0X0F,0X8C,0X0F,0X94,0XD5,0XC5,0XB4,0XC5,0XF6,0XD5,0XB9,0XEE,0X1B,0XF7,
-0XF0,0X83,0XF0,0X83,0X10,0X84,0XCF,0XC4,0X2B,0XDD,0XE6,0XCB,0X11,0XCD,0X31,0XCD,
-0X52,0XD5,0X72,0XD5,0XD0,0XCC,0X65,0XC3,0XE6,0XCB,0X47,0XDC,0X26,0XCC,0XAE,0XBC,
-0X93,0XD5,0XB4,0XD5,0X93,0XCD,0X6C,0X8B,0X26,0X72,0XE9,0X8A,0XD0,0XCC,0X52,0XD5,
-0X72,0XD5,0X51,0XD5,0X10,0XCD,0X50,0XD5,0XF4,0XD5,0XF5,0XD5,0XD6,0XCD,0X99,0XDE,
-0X1B,0XEF,0X37,0XD6,0X98,0XE6,0X32,0XBD,0X16,0XD6,0X98,0XE6,0X98,0XE6,0X57,0XDE,
-0XF0,0X83,0XF0,0X83,0XEF,0X83,0XD0,0XC4,0X8F,0XBC,0X6D,0XAC,0XF0,0XC4,0X31,0XCD,
-0X52,0XD5,0X52,0XD5,0XCF,0XD4,0XE7,0XC3,0X47,0XA3,0X2C,0XAC,0XCF,0XB4,0X72,0XCD,
-0XB3,0XCD,0XF4,0XD5,0X93,0XCD,0XB4,0XD5,0X88,0X72,0X53,0XC5,0X31,0XD5,0X72,0XDD,
-0X31,0XCD,0X11,0XCD,0X10,0XCD,0XB3,0XD5,0X57,0XE6,0X16,0XD6,0X58,0XDE,0XF6,0XCD,
-0X16,0XCE,0XB5,0XC5,0XF5,0XCD,0XF5,0XD5,0XB8,0XEE,0X1B,0XEF,0X73,0XBD,0X3A,0XF7,
-};
+    for(i = 1; i <= n; i++)
+    {
+        if((p[i] & 0xC0) != 0x80)
+        {
+            *s += i;                // 序列不完整：停在下一个非后续字节（可能是结束符）
+            return FNT_CODE_INVALID;
+        }
+        code = (code << 6) | (p[i] & 0x3F);
+    }
+    *s += n + 1;
+    return code;
+}
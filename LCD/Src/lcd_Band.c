@@ -0,0 +1,465 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Band.c
+ * @brief          : 条带光栅化显示缓冲（低内存）
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 只在 LCD_FB_MODE == LCD_FB_BAND 时编译，实现与lcd_Framebuffer.c相同的LCD_FB_*接口。
+ *
+ * 绘图时只记录操作：
+ *   每个操作 = 一个窗口（与CASET/RASET相同，未裁剪）+ 窗口内的像素序号区间 [start, start+count)
+ *            + 纯色，或在arena中的像素数据
+ * Lcd_Flush 时：
+ *   按LCD_BAND_LINES行一条带，把与该条带相交的操作按记录顺序画进条带缓冲，同时记录覆盖位图；
+ *   没有操作相交的条带不发送；
+ *   覆盖区域逐行拆成水平段，上下相邻且x范围相同的段合并成矩形，每个矩形一次开窗发送。
+ * 内存：条带缓冲 16*128*2 = 4KB，覆盖位图 256B，arena 4KB，操作表 64*20B
+ ******************************************************************************
+ */
+
+#include "lcd_Framebuffer.h"
+#include "lcd_Driver.h"
+#include <string.h>
+
+#if (LCD_FB_MODE == LCD_FB_BAND)
+
+#define BAND_COV_BYTES      ((X_MAX_PIXEL + 7) / 8)
+#define BAND_SOLID          0xFFFFU     // Op.data取此值表示纯色操作
+#define BAND_OPEN_MAX       16          // 条带内同时延伸的矩形数上限
+
+/**
+ * @brief 一个记录的绘图操作
+ */
+typedef struct
+{
+    uint16_t wx0, wy0, wx1, wy1;    /**< 窗口（闭区间，未裁剪） */
+    uint32_t start;                 /**< 窗口内起始像素序号 */
+    uint32_t count;                 /**< 像素数（不跨越窗口末尾） */
+    uint16_t color;                 /**< 纯色操作的颜色 */
+    uint16_t data;                  /**< 像素数据在arena中的偏移，BAND_SOLID=纯色 */
+} Band_Op_t;
+
+static Band_Op_t band_ops[LCD_BAND_OPS_MAX];
+static uint8_t band_op_count = 0;
+static uint16_t band_arena[LCD_BAND_ARENA];
+static uint16_t band_arena_used = 0;
+
+static uint16_t band_px[LCD_BAND_LINES][X_MAX_PIXEL];  // 条带缓冲
+static uint8_t band_cov[LCD_BAND_LINES][BAND_COV_BYTES]; // 覆盖位图
+
+static LCD_FB_Stats_t fb_stats;
+
+// 当前窗口和写指针（窗口内像素序号）
+static uint16_t fb_wx0, fb_wy0, fb_wx1, fb_wy1;
+static uint32_t fb_idx, fb_area;
+static uint8_t fb_win_open = 0;
+
+static void Band_Render(void);
+
+/*---------------------------------------------------操作记录----------------------------------------------------*/
+
+/**
+ * @brief  窗口是否与屏幕有交集（完全在屏幕外的窗口不记录）
+ */
+static uint8_t Band_WindowVisible(void)
+{
+    return (fb_wx0 < X_MAX_PIXEL && fb_wy0 < Y_MAX_PIXEL);
+}
+
+/**
+ * @brief  取得可以追加count个像素的操作
+ * @param  solid: 1=纯色操作
+ * @param  color: 纯色操作的颜色
+ * @return 操作指针；返回前保证操作表有空位（必要时先光栅化发送已记录的操作）
+ * @note   与上一个操作是同一窗口、序号连续、类型（和颜色）相同时直接延伸上一个操作
+ */
+static Band_Op_t *Band_OpFor(uint8_t solid, uint16_t color)
+{
+    Band_Op_t *op;
+
+    if(band_op_count)
+    {
+        op = &band_ops[band_op_count - 1];
+        if(op->wx0 == fb_wx0 && op->wy0 == fb_wy0 && op->wx1 == fb_wx1 && op->wy1 == fb_wy1
+           && op->start + op->count == fb_idx)
+        {
+            if(solid && op->data == BAND_SOLID && op->color == color)
+                return op;
+            if(!solid && op->data != BAND_SOLID && op->data + op->count == band_arena_used)
+                return op;
+        }
+    }
+
+    if(band_op_count == LCD_BAND_OPS_MAX)
+    {
+        Band_Render();
+        fb_stats.early_flushes++;
+    }
+
+    op = &band_ops[band_op_count++];
+    op->wx0 = fb_wx0;
+    op->wy0 = fb_wy0;
+    op->wx1 = fb_wx1;
+    op->wy1 = fb_wy1;
+    op->start = fb_idx;
+    op->count = 0;
+    op->color = color;
+    op->data = solid ? BAND_SOLID : band_arena_used;
+    return op;
+}
+
+/**
+ * @brief  写指针前进n个像素，窗口写满后回到起点（与LCD显存行为一致）
+ */
+static void Band_Advance(uint32_t n)
+{
+    fb_idx += n;
+    if(fb_idx >= fb_area)
+        fb_idx = 0;
+}
+
+void LCD_FB_BeginWindow(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    fb_wx0 = x_start;
+    fb_wy0 = y_start;
+    fb_wx1 = x_end;
+    fb_wy1 = y_end;
+    fb_idx = 0;
+    fb_area = (uint32_t)(x_end - x_start + 1) * (y_end - y_start + 1);
+    fb_win_open = 1;
+}
+
+void LCD_FB_WritePixels(const uint16_t *colors, uint32_t count)
+{
+    Band_Op_t *op;
+    uint32_t n;
+
+    if(!fb_win_open) return;
+    if(!Band_WindowVisible())
+    {
+        fb_idx = (fb_idx + count) % fb_area;
+        return;
+    }
+
+    while(count)
+    {
+        if(band_arena_used == LCD_BAND_ARENA)
+        {
+            Band_Render();
+            fb_stats.early_flushes++;
+        }
+
+        op = Band_OpFor(0, 0);
+        n = fb_area - fb_idx;
+        if(n > count) n = count;
+        if(n > (uint32_t)(LCD_BAND_ARENA - band_arena_used)) n = LCD_BAND_ARENA - band_arena_used;
+
+        memcpy(&band_arena[band_arena_used], colors, n * sizeof(uint16_t));
+        band_arena_used += n;
+        op->count += n;
+        colors += n;
+        count -= n;
+        Band_Advance(n);
+    }
+}
+
+void LCD_FB_FillPixels(uint16_t Color, uint32_t count)
+{
+    Band_Op_t *op;
+    uint32_t n;
+
+    if(!fb_win_open) return;
+    if(!Band_WindowVisible())
+    {
+        fb_idx = (fb_idx + count) % fb_area;
+        return;
+    }
+
+    while(count)
+    {
+        op = Band_OpFor(1, Color);
+        n = fb_area - fb_idx;
+        if(n > count) n = count;
+        op->count += n;
+        count -= n;
+        Band_Advance(n);
+    }
+}
+
+void LCD_FB_EndWindow(void)
+{
+    fb_win_open = 0;
+}
+
+void LCD_FB_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Color)
+{
+    LCD_FB_BeginWindow(x, y, x + w - 1, y + h - 1);
+    LCD_FB_FillPixels(Color, (uint32_t)w * h);
+    LCD_FB_EndWindow();
+}
+
+void LCD_FB_SetPixel(uint16_t x, uint16_t y, uint16_t Color)
+{
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return;
+    LCD_FB_FillRect(x, y, 1, 1, Color);
+}
+
+/**
+ * @brief  读取本次Flush之前记录的像素（后记录的操作优先），没有记录返回0
+ */
+uint16_t LCD_FB_GetPixel(uint16_t x, uint16_t y)
+{
+    int16_t i;
+    const Band_Op_t *op;
+    uint32_t idx;
+
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return 0;
+
+    for(i = band_op_count - 1; i >= 0; i--)
+    {
+        op = &band_ops[i];
+        if(x < op->wx0 || x > op->wx1 || y < op->wy0 || y > op->wy1) continue;
+        idx = (uint32_t)(y - op->wy0) * (op->wx1 - op->wx0 + 1) + (x - op->wx0);
+        if(idx < op->start || idx >= op->start + op->count) continue;
+        return (op->data == BAND_SOLID) ? op->color : band_arena[op->data + idx - op->start];
+    }
+    return 0;
+}
+
+/**
+ * @brief  条带模式不保存屏幕内容，无法重发，空操作
+ */
+void LCD_FB_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    (void)x;
+    (void)y;
+    (void)w;
+    (void)h;
+}
+
+/**
+ * @brief  条带模式不保存屏幕内容，Flush之后没有需要移动的数据，空操作
+ */
+void LCD_FB_Scroll(uint16_t y, uint16_t h, uint16_t lines)
+{
+    (void)y;
+    (void)h;
+    (void)lines;
+}
+
+/*---------------------------------------------------条带光栅化----------------------------------------------------*/
+
+/**
+ * @brief  把一个操作落在屏幕行[by0, by1]内的部分画进条带缓冲
+ * @return 1=有像素落入条带
+ */
+static uint8_t Band_DrawOp(const Band_Op_t *op, uint16_t by0, uint16_t by1)
+{
+    uint32_t ww = op->wx1 - op->wx0 + 1;
+    uint32_t r0 = op->start / ww;                       // 操作覆盖的窗口内行号
+    uint32_t r1 = (op->start + op->count - 1) / ww;
+    uint32_t r, i0, i1;
+    int32_t y, x0, x1, x;
+    uint16_t *dst;
+    uint8_t *cov;
+    const uint16_t *src;
+    uint8_t hit = 0;
+
+    if(op->count == 0) return 0;
+    if((uint32_t)op->wy0 + r1 < by0 || (uint32_t)op->wy0 + r0 > by1) return 0;
+
+    for(r = r0; r <= r1; r++)
+    {
+        y = op->wy0 + r;
+        if(y < by0) continue;
+        if(y > by1) break;
+
+        i0 = r * ww;
+        i1 = i0 + ww;
+        if(i0 < op->start) i0 = op->start;
+        if(i1 > op->start + op->count) i1 = op->start + op->count;
+
+        x0 = op->wx0 + (i0 - r * ww);
+        x1 = x0 + (int32_t)(i1 - i0) - 1;
+        if(x1 >= X_MAX_PIXEL) x1 = X_MAX_PIXEL - 1;
+        if(x0 > x1) continue;
+
+        dst = band_px[y - by0];
+        cov = band_cov[y - by0];
+        if(op->data == BAND_SOLID)
+        {
+            for(x = x0; x <= x1; x++)
+            {
+                dst[x] = op->color;
+                cov[x >> 3] |= (uint8_t)(1U << (x & 7));
+            }
+        }
+        else
+        {
+            src = &band_arena[op->data + (i0 - op->start)] - x0;
+            for(x = x0; x <= x1; x++)
+            {
+                dst[x] = src[x];
+                cov[x >> 3] |= (uint8_t)(1U << (x & 7));
+            }
+        }
+        hit = 1;
+    }
+    return hit;
+}
+
+/**
+ * @brief  从覆盖位图的一行中取下一个覆盖段
+ * @param  row: 条带内行号
+ * @param  x: 输入起始搜索位置，输出段起点
+ * @param  x_end: 输出段终点（闭区间）
+ * @return 1=找到
+ */
+static uint8_t Band_NextSpan(uint16_t row, uint16_t *x, uint16_t *x_end)
+{
+    uint16_t i = *x;
+    const uint8_t *cov = band_cov[row];
+
+    while(i < X_MAX_PIXEL && !(cov[i >> 3] & (1U << (i & 7))))
+    {
+        if((i & 7) == 0 && cov[i >> 3] == 0)
+            i += 8;                     // 整个字节为空，跳过8列
+        else
+            i++;
+    }
+    if(i >= X_MAX_PIXEL) return 0;
+
+    *x = i;
+    while(i < X_MAX_PIXEL && (cov[i >> 3] & (1U << (i & 7))))
+        i++;
+    *x_end = i - 1;
+    return 1;
+}
+
+/**
+ * @brief  发送条带内的一个矩形
+ */
+static void Band_Push(uint16_t by0, uint16_t x0, uint16_t x1, uint16_t row0, uint16_t row1)
+{
+    Lcd_PushRect(x0, by0 + row0, x1 - x0 + 1, row1 - row0 + 1, &band_px[row0][x0], X_MAX_PIXEL);
+    fb_stats.rects++;
+    fb_stats.pixels += (uint32_t)(x1 - x0 + 1) * (row1 - row0 + 1);
+}
+
+/**
+ * @brief  发送条带中被覆盖的像素
+ * @note   上一行的段与本行的段x范围相同时继续向下延伸，否则结束并发送
+ */
+static void Band_Emit(uint16_t by0, uint16_t lines)
+{
+    struct { uint16_t x0, x1, row0; uint8_t alive; } open[BAND_OPEN_MAX];
+    uint8_t open_count = 0;
+    uint16_t row, x, x_end;
+    uint8_t i, n;
+
+    for(row = 0; row < lines; row++)
+    {
+        for(i = 0; i < open_count; i++)
+            open[i].alive = 0;
+
+        x = 0;
+        while(Band_NextSpan(row, &x, &x_end))
+        {
+            for(i = 0; i < open_count; i++)
+            {
+                if(open[i].x0 == x && open[i].x1 == x_end)
+                {
+                    open[i].alive = 1;
+                    break;
+                }
+            }
+            if(i == open_count)
+            {
+                if(open_count < BAND_OPEN_MAX)
+                {
+                    open[open_count].x0 = x;
+                    open[open_count].x1 = x_end;
+                    open[open_count].row0 = row;
+                    open[open_count].alive = 2;     // 本行新建，下面不参与结束判断
+                    open_count++;
+                }
+                else
+                {
+                    Band_Push(by0, x, x_end, row, row);
+                }
+            }
+            x = x_end + 1;
+        }
+
+        // 本行没有延续的矩形到上一行为止
+        n = 0;
+        for(i = 0; i < open_count; i++)
+        {
+            if(open[i].alive == 0)
+                Band_Push(by0, open[i].x0, open[i].x1, open[i].row0, row - 1);
+            else
+                open[n++] = open[i];
+        }
+        open_count = n;
+    }
+
+    for(i = 0; i < open_count; i++)
+        Band_Push(by0, open[i].x0, open[i].x1, open[i].row0, lines - 1);
+}
+
+/**
+ * @brief  光栅化并发送所有已记录的操作，然后清空记录（当前窗口状态保留）
+ */
+static void Band_Render(void)
+{
+    uint16_t by0, lines;
+    uint8_t i, hit;
+
+    if(band_op_count == 0) return;
+
+    for(by0 = 0; by0 < Y_MAX_PIXEL; by0 += LCD_BAND_LINES)
+    {
+        lines = (Y_MAX_PIXEL - by0 < LCD_BAND_LINES) ? (Y_MAX_PIXEL - by0) : LCD_BAND_LINES;
+
+        memset(band_cov, 0, sizeof(band_cov));
+        hit = 0;
+        for(i = 0; i < band_op_count; i++)
+            hit |= Band_DrawOp(&band_ops[i], by0, by0 + lines - 1);
+
+        if(!hit)
+        {
+            fb_stats.bands_skipped++;
+            continue;
+        }
+        fb_stats.bands++;
+        Band_Emit(by0, lines);
+    }
+
+    band_op_count = 0;
+    band_arena_used = 0;
+}
+
+/*---------------------------------------------------发送----------------------------------------------------*/
+
+void LCD_FB_Flush(void)
+{
+    LCD_FB_EndWindow();
+    if(band_op_count == 0) return;
+
+    Band_Render();
+    fb_stats.flushes++;
+}
+
+const LCD_FB_Stats_t *LCD_FB_GetStats(void)
+{
+    return &fb_stats;
+}
+
+void LCD_FB_ResetStats(void)
+{
+    memset(&fb_stats, 0, sizeof(fb_stats));
+}
+
+#endif /* LCD_FB_MODE == LCD_FB_BAND */
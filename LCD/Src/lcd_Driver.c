@@ -9,10 +9,12 @@
  ******************************************************************************
  * 主要功能：
  * - GPIO硬件初始化
- * - 软件SPI通信实现
+ * - 传输层选择（软件SPI / 硬件SPI1+DMA，见lcd_Transport.c）
  * - ST7735芯片初始化和配置
  * - 基础显示操作（清屏、画点、区域设置）
  * - 背光和显示控制
+ * - 可选显示缓冲（LCD_FB_MODE，见lcd_Framebuffer.h），绘图进RAM、Lcd_Flush统一发送
+ * - 硬件垂直滚动区（VSCRDEF/VSCSAD），滚动区内的绘图坐标由驱动换算成显存行
  * - 为上层GUI提供底层硬件接口
  ******************************************************************************
  */
@@ -20,6 +22,13 @@
 #include "lcd_Driver.h"  
 #include "stm32f4xx_hal.h"
 #include "LCD_Config.h"
+#include "lcd_Transport.h"
+#include "lcd_Framebuffer.h"
+#include "lcd_Pipe.h"
+#include <string.h>
+#if LCD_HW_SPI_ENABLE
+#include "spi.h"
+#endif
 
 /*========================底层通信必须函数（硬件直接操作），最基础的函数，所有其他功能都依赖它们=========================*/
 
@@ -54,29 +63,234 @@ void LCD_GPIO_Init(void)
     LCD_BLK_SET;     // 背光开启
 }
 
-/*---------------------------------------------------SPI通信核心----------------------------------------------------*/
+/*---------------------------------------------------传输层选择----------------------------------------------------*/
+
+static void LCD_StreamEnd(void);
+static void LCD_WinInvalidate(void);
+
+// 当前使用的传输层，由LCD_Config.h中的LCD_TRANSPORT决定上电默认值
+#if (LCD_TRANSPORT == LCD_TRANSPORT_HW_SPI) && LCD_HW_SPI_ENABLE
+static const LCD_Transport_t *lcd_transport = &LCD_Transport_HwSPI;
+#else
+static const LCD_Transport_t *lcd_transport = &LCD_Transport_SoftSPI;
+#endif
+
 /**
- * @brief  软件SPI发送8位数据
- * @param  Data: 要发送的8位数据
+ * @brief  切换LCD传输层
+ * @param  transport: 传输层（LCD_Transport_SoftSPI / LCD_Transport_HwSPI / LCD_Transport_Mock）
  * @return 无
- * @note   使用软件模拟SPI协议，MSB先发送
+ * @note   切换后立即调用新传输层的Init，可在Lcd_Init之后随时切换（例如硬件SPI异常时退回软件SPI）
  */
-void SPI_WriteData(uint8_t Data)
+void LCD_SetTransport(const LCD_Transport_t *transport)
 {
-    unsigned char i=0;
-    
-    for(i = 8; i > 0; i--) //MSB，高位优先
+    if(transport == NULL) return;
+
+    LCD_Pipe_Drain();           // 流水线中的像素先用旧传输层发完
+    LCD_StreamEnd();
+    lcd_transport->Deselect();  // 结束旧传输层上未完成的发送
+#if LCD_HW_SPI_ENABLE
+    if(lcd_transport == &LCD_Transport_HwSPI && transport != &LCD_Transport_HwSPI)
+        MX_SPI1_DeInit();       // 释放PA5/PA7给GPIO
+#endif
+    lcd_transport = transport;
+    lcd_transport->Init();
+    LCD_WinInvalidate();        // 新传输层后面不一定是同一块屏
+}
+
+/**
+ * @brief  获取当前LCD传输层
+ * @return 当前传输层指针
+ */
+const LCD_Transport_t *LCD_GetTransport(void)
+{
+    return lcd_transport;
+}
+
+/*---------------------------------------------------发送通道（统计唯一入口）----------------------------------------------------*/
+
+static LCD_Stats_t lcd_stats;           // 发送统计
+static uint8_t lcd_stream_open = 0;     // 像素流窗口是否打开（CS保持选中）
+static uint32_t lcd_frame_saved_mark;   // 本帧开始时的saved_bytes
+
+/**
+ * @brief LCD控制器当前的地址窗口和显存写指针（驱动侧镜像）
+ * @note  CASET/RASET设置后一直有效；RAMWR之后每个像素使写指针在窗口内按行优先前进，
+ *        CS拉高不会中断写入（原有的Lcd_SetRegion + LCD_WriteData_16Bit就依赖这一点）
+ */
+static struct
+{
+    uint8_t x_valid;        // xs/xe与控制器一致
+    uint8_t y_valid;        // ys/ye与控制器一致
+    uint8_t ramwr;          // 控制器处于RAMWR状态，cx/cy为下一个像素的位置
+    uint16_t xs, xe, ys, ye;
+    uint16_t cx, cy;
+} lcd_win;
+
+/**
+ * @brief 硬件垂直滚动区（VSCRDEF/VSCSAD），h=0表示未启用
+ * @note  滚动区内容上移offset行后，屏幕逻辑行y显示的是显存中逻辑行LCD_ScrollRow(y)的内容，
+ *        画图时按同样的映射把逻辑行换成显存行，上层GUI不需要知道滚动
+ */
+static struct
+{
+    uint16_t y, h;          // 逻辑行[y, y+h)
+    uint16_t tfa;           // 滚动区在控制器显存中的起始行（VSCRDEF的TFA）
+    uint16_t offset;        // 内容上移的行数（0~h-1）
+} lcd_scroll;
+
+/**
+ * @brief 像素流窗口跨过滚动区边界或回绕点时，分成几段显存行连续的子窗口依次发送
+ */
+static struct
+{
+    uint8_t  split;         // 1=当前像素流分段发送
+    uint16_t xs, xe;        // 列范围
+    uint16_t ys, ye;        // 整个窗口的逻辑行范围
+    uint16_t y_end;         // 当前段最后一行（逻辑行）
+    uint32_t left;          // 当前段还能写入的像素数
+} lcd_seg;
+
+static uint32_t LCD_SegTake(uint32_t count);
+
+/**
+ * @brief  窗口缓存失效（发送了驱动不跟踪的命令/数据、复位或切换传输层后调用）
+ */
+static void LCD_WinInvalidate(void)
+{
+    lcd_win.x_valid = 0;
+    lcd_win.y_valid = 0;
+    lcd_win.ramwr = 0;
+}
+
+/**
+ * @brief  写入count个像素后推进写指针（窗口写满后回到起点，与控制器一致）
+ */
+static void LCD_WinAdvance(uint32_t count)
+{
+    uint32_t w, area, idx;
+
+    if(!lcd_win.ramwr) return;
+
+    w = lcd_win.xe - lcd_win.xs + 1;
+    area = w * (lcd_win.ye - lcd_win.ys + 1);
+    idx = (uint32_t)(lcd_win.cy - lcd_win.ys) * w + (lcd_win.cx - lcd_win.xs);
+    idx = (idx + count) % area;
+    lcd_win.cx = lcd_win.xs + idx % w;
+    lcd_win.cy = lcd_win.ys + idx / w;
+}
+
+/**
+ * @brief  以下LCD_Tx*是驱动访问传输层的唯一通道，所有字节统计都在这里完成
+ * @note   每个入口先等待流水线（lcd_Pipe.c）中排队的像素发完，保证字节顺序
+ */
+static void LCD_TxSelect(void)
+{
+    LCD_Pipe_Drain();
+    if(lcd_stream_open)             // 有未关闭的像素流时先结束它
     {
-        LCD_SCL_CLR;      //时钟下降沿，准备数据（数据在 SDA 上必须稳定）
-        if(Data & 0x80)
-            LCD_SDA_SET;  //如果最高位是1，输出高电平
-        else 
-            LCD_SDA_CLR;  //如果最高位是0，输出低电平
-        
-        LCD_SCL_SET;      //时钟上升沿，从机采样数据（屏幕此刻读取 SDA）
-        Data <<= 1;       //数据左移1位，准备发送下一位
+        lcd_transport->Deselect();
+        lcd_stream_open = 0;
+        lcd_seg.split = 0;
+    }
+    lcd_stats.selects++;
+    lcd_transport->Select();
+}
+
+static void LCD_TxDeselect(void)
+{
+    LCD_Pipe_Drain();
+    lcd_transport->Deselect();
+}
+
+/**
+ * @brief  在当前片选内发送一条命令及其参数
+ * @param  cmd: 命令字节（DC=0）
+ * @param  param: 参数（DC=1），可为NULL
+ * @param  len: 参数字节数
+ */
+static void LCD_TxCommand(uint8_t cmd, const uint8_t *param, uint8_t len)
+{
+    LCD_Pipe_Drain();
+    lcd_transport->SetDC(0);
+    lcd_transport->Write(&cmd, 1);
+    lcd_stats.commands++;
+    lcd_stats.cmd_bytes++;
+
+    if(len)
+    {
+        lcd_transport->SetDC(1);
+        lcd_transport->Write(param, len);
+        lcd_stats.param_bytes += len;
+    }
+}
+
+static void LCD_TxPixels(const uint16_t *px, uint32_t count)
+{
+    uint32_t n;
+
+    LCD_Pipe_Drain();
+    while(count)
+    {
+        n = LCD_SegTake(count);     // 窗口分段时每段单独开窗，否则一次发完
+        lcd_transport->Write16(px, n);
+        lcd_stats.pixel_bytes += n * 2;
+        LCD_WinAdvance(n);
+        px += n;
+        count -= n;
+    }
+}
+
+#if (LCD_FB_MODE == LCD_FB_NONE)
+// 已经是高字节在前的像素字节，不经转换直接发送
+static void LCD_TxPixelBytes(const uint8_t *data, uint32_t count)
+{
+    uint32_t n;
+
+    LCD_Pipe_Drain();
+    while(count)
+    {
+        n = LCD_SegTake(count);
+        lcd_transport->Write(data, n * 2);
+        lcd_stats.pixel_bytes += n * 2;
+        LCD_WinAdvance(n);
+        data += n * 2;
+        count -= n;
+    }
+}
+
+static void LCD_TxFill(uint16_t color, uint32_t count)
+{
+    uint32_t n;
+
+    LCD_Pipe_Drain();
+    while(count)
+    {
+        n = LCD_SegTake(count);
+        lcd_transport->Fill16(color, n);
+        lcd_stats.pixel_bytes += n * 2;
+        LCD_WinAdvance(n);
+        count -= n;
     }
 }
+#endif
+
+/**
+ * @brief  获取发送统计
+ * @return 统计结构体指针
+ */
+const LCD_Stats_t *LCD_GetStats(void)
+{
+    return &lcd_stats;
+}
+
+/**
+ * @brief  清零发送统计
+ */
+void LCD_ResetStats(void)
+{
+    memset(&lcd_stats, 0, sizeof(lcd_stats));
+    lcd_frame_saved_mark = 0;
+}
 
 /*---------------------------------------------------命令/数据发送----------------------------------------------------*/
 
@@ -89,10 +303,10 @@ void SPI_WriteData(uint8_t Data)
 void Lcd_WriteIndex(uint8_t Index)
 {
     // SPI 写命令时序开始
-    LCD_CS_CLR;        // 片选信号拉低，选中LCD设备
-    LCD_RS_CLR;        // DC=0 表示发送命令
-    SPI_WriteData(Index);  // 发送8位命令
-    LCD_CS_SET;        // 片选信号拉高，取消选中
+    LCD_TxSelect();                 // 片选信号拉低，选中LCD设备
+    LCD_TxCommand(Index, NULL, 0);  // DC=0 发送8位命令
+    LCD_TxDeselect();               // 片选信号拉高，取消选中
+    LCD_WinInvalidate();            // 任意命令都可能改变窗口/结束RAMWR
 }
 
 /**
@@ -103,10 +317,12 @@ void Lcd_WriteIndex(uint8_t Index)
  */
 void Lcd_WriteData(uint8_t Data)
 {
-    LCD_CS_CLR;        // 片选信号拉低，选中LCD设备
-    LCD_RS_SET;        // DC=1 表示发送数据
-    SPI_WriteData(Data);  // 发送8位数据
-    LCD_CS_SET;        // 片选信号拉高，取消选中
+    LCD_TxSelect();                 // 片选信号拉低，选中LCD设备
+    lcd_transport->SetDC(1);        // DC=1 表示发送数据
+    lcd_transport->Write(&Data, 1); // 发送8位数据
+    lcd_stats.param_bytes++;
+    LCD_TxDeselect();               // 片选信号拉高，取消选中
+    LCD_WinInvalidate();
 }
 
 /*---------------------------------------------------硬件控制----------------------------------------------------*/
@@ -119,6 +335,8 @@ void Lcd_WriteData(uint8_t Data)
  */
 void Lcd_Reset(void)
 {
+    LCD_WinInvalidate();
+    memset(&lcd_scroll, 0, sizeof(lcd_scroll));     // 复位后控制器退出滚动模式
     LCD_RST_CLR;       // 复位引脚拉低
     HAL_Delay(100);    // 保持低电平100ms
     LCD_RST_SET;       // 复位引脚拉高
@@ -157,11 +375,10 @@ void LCD_BacklightOff(void)
  */
 void LCD_WriteData_16Bit(uint16_t Data)
 {
-    LCD_CS_CLR;                 // 片选信号拉低，选中LCD设备
-    LCD_RS_SET;                 // DC=1 表示发送数据
-    SPI_WriteData(Data >> 8);   // 发送高8位数据
-    SPI_WriteData(Data & 0xFF); // 发送低8位数据
-    LCD_CS_SET;                 // 片选信号拉高，取消选中
+    LCD_TxSelect();                 // 片选信号拉低，选中LCD设备
+    lcd_transport->SetDC(1);        // DC=1 表示发送数据
+    LCD_TxPixels(&Data, 1);         // 发送16位数据（高8位先发）
+    LCD_TxDeselect();               // 片选信号拉高，取消选中
 }
 
 /**
@@ -178,6 +395,85 @@ void Lcd_WriteReg(uint8_t Index, uint8_t Data)
 
 /*---------------------------------------------------第2层组合：显示区域控制----------------------------------------------------*/
 
+/**
+ * @brief  判断新窗口能否直接沿用控制器当前的写入
+ * @note   写指针正好在新窗口起点，且之后的自增顺序与新窗口一致：
+ *         - 列范围相同、新窗口的行在旧窗口内（多行窗口向下接续）
+ *         - 单行窗口、在旧窗口的同一行内向右接续（连续画点/画水平段）
+ */
+static uint8_t LCD_WinContinues(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    if(!lcd_win.ramwr) return 0;
+    if(lcd_win.cx != x_start || lcd_win.cy != y_start) return 0;
+    if(y_end > lcd_win.ye) return 0;
+
+    if(x_start == lcd_win.xs && x_end == lcd_win.xe)
+        return 1;
+    if(y_start == y_end && x_end <= lcd_win.xe)
+        return 1;
+    return 0;
+}
+
+/**
+ * @brief  在当前片选内设置显存窗口并进入RAMWR
+ * @note   CASET/RASET参数为 高字节,低字节,高字节,低字节；X有+2、Y有+3的屏幕偏移
+ *         与控制器当前状态相同的轴不再发送；能接续当前写入时三条命令都省掉，
+ *         省下的字节计入lcd_stats.saved_bytes（CASET/RASET各5字节，RAMWR 1字节）
+ */
+static void LCD_SendRegion(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    uint8_t param[4];
+
+    lcd_stats.windows++;
+
+    if(LCD_WinContinues(x_start, y_start, x_end, y_end))
+    {
+        lcd_stats.saved_bytes += 11;
+        lcd_stats.continued++;
+        return;
+    }
+
+    // 设置列地址范围 (Column Address Set)
+    if(lcd_win.x_valid && lcd_win.xs == x_start && lcd_win.xe == x_end)
+    {
+        lcd_stats.saved_bytes += 5;
+    }
+    else
+    {
+        param[0] = 0x00;                // XS高字节
+        param[1] = x_start + LCD_COL_OFFSET;    // XS低字节 (+2是屏幕偏移)
+        param[2] = 0x00;                // XE高字节
+        param[3] = x_end + LCD_COL_OFFSET;      // XE低字节
+        LCD_TxCommand(0x2A, param, 4);
+        lcd_win.xs = x_start;
+        lcd_win.xe = x_end;
+        lcd_win.x_valid = 1;
+    }
+
+    // 设置行地址范围 (Row Address Set)
+    if(lcd_win.y_valid && lcd_win.ys == y_start && lcd_win.ye == y_end)
+    {
+        lcd_stats.saved_bytes += 5;
+    }
+    else
+    {
+        param[0] = 0x00;                // YS高字节
+        param[1] = y_start + LCD_ROW_OFFSET;    // YS低字节 (+3是屏幕偏移)
+        param[2] = 0x00;                // YE高字节
+        param[3] = y_end + LCD_ROW_OFFSET;      // YE低字节
+        LCD_TxCommand(0x2B, param, 4);
+        lcd_win.ys = y_start;
+        lcd_win.ye = y_end;
+        lcd_win.y_valid = 1;
+    }
+
+    // 准备写入显存 (Memory Write)，写指针回到窗口起点
+    LCD_TxCommand(0x2C, NULL, 0);
+    lcd_win.ramwr = 1;
+    lcd_win.cx = x_start;
+    lcd_win.cy = y_start;
+}
+
 /**
  * @brief  设置LCD显示区域
  * @param  x_start: 起始X坐标 (0-127)
@@ -188,23 +484,10 @@ void Lcd_WriteReg(uint8_t Index, uint8_t Data)
  * @note   设置后，在此区域写点数据会自动换行
  */
 void Lcd_SetRegion(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
-{		
-    // 设置列地址范围 (Column Address Set)
-    Lcd_WriteIndex(0x2A);           // CASET命令
-    Lcd_WriteData(0x00);            // XS高字节
-    Lcd_WriteData(x_start + 2);     // XS低字节 (+2是屏幕偏移)
-    Lcd_WriteData(0x00);            // XE高字节
-    Lcd_WriteData(x_end + 2);       // XE低字节
-
-    // 设置行地址范围 (Row Address Set)
-    Lcd_WriteIndex(0x2B);           // RASET命令
-    Lcd_WriteData(0x00);            // YS高字节
-    Lcd_WriteData(y_start + 3);     // YS低字节 (+3是屏幕偏移)
-    Lcd_WriteData(0x00);            // YE高字节
-    Lcd_WriteData(y_end + 3);       // YE低字节
-    
-    // 准备写入显存 (Memory Write)
-    Lcd_WriteIndex(0x2C);           // RAMWR命令
+{
+    LCD_TxSelect();
+    LCD_SendRegion(x_start, y_start, x_end, y_end);
+    LCD_TxDeselect();
 }
 
 /**
@@ -219,6 +502,415 @@ void Lcd_SetXY(uint16_t x, uint16_t y)
     Lcd_SetRegion(x, y, x, y);  // 设置单个像素区域
 }
 
+/*---------------------------------------------------第2层组合：硬件垂直滚动----------------------------------------------------*/
+
+/**
+ * @brief  逻辑行y对应的显存行（逻辑坐标）
+ * @note   滚动区内按偏移循环，滚动区外不变
+ */
+static uint16_t LCD_ScrollRow(uint16_t y)
+{
+    if(y < lcd_scroll.y || y >= lcd_scroll.y + lcd_scroll.h) return y;
+    return lcd_scroll.y + (y - lcd_scroll.y + lcd_scroll.offset) % lcd_scroll.h;
+}
+
+/**
+ * @brief  从逻辑行y开始、到y_end为止，显存行连续的最后一行
+ * @note   在滚动区边界和滚动区内的回绕点处断开
+ */
+static uint16_t LCD_ScrollRunEnd(uint16_t y, uint16_t y_end)
+{
+    uint16_t top = lcd_scroll.y, bottom = lcd_scroll.y + lcd_scroll.h;     // 滚动区[top, bottom)
+    uint16_t end, n;
+
+    if(lcd_scroll.h == 0 || y_end < top || y >= bottom) return y_end;
+
+    if(y < top)
+    {
+        end = top - 1;
+    }
+    else
+    {
+        n = bottom - LCD_ScrollRow(y);          // 显存行到滚动区底部为止，之后回绕到顶部
+        if(n > bottom - y) n = bottom - y;      // 逻辑行到滚动区底部为止，之后是滚动区下面的固定区
+        end = y + n - 1;
+    }
+    return (end < y_end) ? end : y_end;
+}
+
+/**
+ * @brief  打开从逻辑行y开始的一段子窗口
+ */
+static void LCD_SegOpen(uint16_t y)
+{
+    lcd_seg.y_end = LCD_ScrollRunEnd(y, lcd_seg.ye);
+    lcd_seg.left = (uint32_t)(lcd_seg.y_end - y + 1) * (lcd_seg.xe - lcd_seg.xs + 1);
+    LCD_SendRegion(lcd_seg.xs, LCD_ScrollRow(y), lcd_seg.xe, LCD_ScrollRow(lcd_seg.y_end));
+}
+
+/**
+ * @brief  按逻辑窗口设置显存窗口，显存行不连续时只打开第一段，其余段由LCD_SegTake依次打开
+ * @note   没有启用滚动时与直接LCD_SendRegion完全相同
+ */
+static void LCD_SegBegin(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    lcd_seg.xs = x_start;
+    lcd_seg.xe = x_end;
+    lcd_seg.ys = y_start;
+    lcd_seg.ye = y_end;
+    LCD_SegOpen(y_start);
+    lcd_seg.split = (uint8_t)(lcd_seg.y_end != y_end);
+}
+
+/**
+ * @brief  当前段还能写入的像素数（最多count），当前段写满时先打开下一段
+ * @note   整个窗口写满后回到第一段，与控制器窗口写满后回到起点一致
+ */
+static uint32_t LCD_SegTake(uint32_t count)
+{
+    if(!lcd_seg.split) return count;
+
+    if(lcd_seg.left == 0)
+    {
+        LCD_SegOpen((lcd_seg.y_end >= lcd_seg.ye) ? lcd_seg.ys : lcd_seg.y_end + 1);
+        lcd_transport->SetDC(1);
+    }
+    if(count > lcd_seg.left) count = lcd_seg.left;
+    lcd_seg.left -= count;
+    return count;
+}
+
+/**
+ * @brief  发送VSCSAD（滚动起始地址）
+ * @note   显示行TFA处显示显存行SSA；MY=1时逻辑行向下对应显存行向上，
+ *         内容上移offset行即SSA = TFA + (h - offset) % h
+ */
+static void LCD_ScrollSend(void)
+{
+    uint16_t ssa = lcd_scroll.tfa + (lcd_scroll.h - lcd_scroll.offset) % lcd_scroll.h;
+    uint8_t param[2];
+
+    param[0] = (uint8_t)(ssa >> 8);
+    param[1] = (uint8_t)ssa;
+    LCD_TxSelect();
+    LCD_TxCommand(0x37, param, 2);      // VSCSAD
+    LCD_TxDeselect();
+    lcd_win.ramwr = 0;                  // 新命令结束了RAMWR，CASET/RASET仍然有效
+}
+
+/**
+ * @brief  设置硬件垂直滚动区
+ * @param  y: 滚动区第一行（逻辑坐标）
+ * @param  h: 滚动区行数，0=关闭滚动（NORON回到普通显示）
+ * @return 1=成功，0=区域超出屏幕
+ * @note   滚动区上下的行固定不动；原来有偏移时先滚回偏移0，设置后偏移为0。
+ *         之后所有绘图函数的坐标都是屏幕上看到的位置，驱动换算成显存行，
+ *         跨过滚动区边界或回绕点的窗口自动分段发送。
+ *         Lcd_SetRegion + LCD_WriteData_16Bit 的旧接口不做换算，滚动时不要用它们画滚动区
+ */
+uint8_t Lcd_ScrollArea(uint16_t y, uint16_t h)
+{
+    uint8_t param[6];
+    uint16_t tfa, bfa;
+
+    // 逻辑行y在显存中的行地址为y+LCD_ROW_OFFSET，MY=1时从显存底部向上数；
+    // LCD_Config.h保证LCD_GRAM_ROWS >= Y_MAX_PIXEL+LCD_ROW_OFFSET，屏幕内的区域TFA不会小于0
+    if(h != 0 && (y >= Y_MAX_PIXEL || h > Y_MAX_PIXEL - y)) return 0;
+    tfa = (uint16_t)(LCD_GRAM_ROWS - LCD_ROW_OFFSET - y - h);
+
+    Lcd_ScrollTo(0);                    // 先滚回设置时的位置，换算关系变化前显存与屏幕顺序一致
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_Flush();                     // 已记录的绘图按原来的换算发送
+#endif
+
+    if(h == 0)
+    {
+        if(lcd_scroll.h == 0) return 1;
+        lcd_scroll.h = 0;
+        LCD_TxSelect();
+        LCD_TxCommand(0x13, NULL, 0);   // NORON：退出滚动模式
+        LCD_TxDeselect();
+        lcd_win.ramwr = 0;
+        return 1;
+    }
+
+    bfa = (uint16_t)(LCD_GRAM_ROWS - tfa - h);     // 至少LCD_ROW_OFFSET行
+    param[0] = (uint8_t)(tfa >> 8);     // TFA：滚动区上方（显存中）的固定行数
+    param[1] = (uint8_t)tfa;
+    param[2] = (uint8_t)(h >> 8);       // VSA：滚动区行数
+    param[3] = (uint8_t)h;
+    param[4] = (uint8_t)(bfa >> 8);     // BFA：滚动区下方的固定行数
+    param[5] = (uint8_t)bfa;
+    LCD_TxSelect();
+    LCD_TxCommand(0x33, param, 6);      // VSCRDEF
+    LCD_TxDeselect();
+
+    lcd_scroll.y = y;
+    lcd_scroll.h = h;
+    lcd_scroll.tfa = tfa;
+    lcd_scroll.offset = 0;
+    LCD_ScrollSend();                   // 进入滚动模式
+    return 1;
+}
+
+/**
+ * @brief  把滚动区内容滚动到指定偏移
+ * @param  offset: 内容相对设置滚动区时上移的行数（按滚动区高度取模）
+ * @note   只发送一条VSCSAD（3字节），显存不动；滚出顶部的行从底部出现，
+ *         调用方只需重画新露出的行。
+ *         显示缓冲模式下先把已记录的绘图发送出去；全屏显存同时把滚动区各行循环移动，保持与屏幕一致
+ * @example
+ *          Lcd_ScrollArea(112, 16);                        // 第112~127行为滚动区
+ *          Lcd_Scroll(1);                                  // 内容上移一行
+ *          Lcd_FillRect(0, 127, 128, 1, BLACK);            // 画新露出的最后一行
+ */
+void Lcd_ScrollTo(uint16_t offset)
+{
+    uint16_t lines;
+
+    if(lcd_scroll.h == 0) return;
+    offset %= lcd_scroll.h;
+    if(offset == lcd_scroll.offset) return;
+
+    lines = (uint16_t)((offset + lcd_scroll.h - lcd_scroll.offset) % lcd_scroll.h);
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_Flush();
+    LCD_FB_Scroll(lcd_scroll.y, lcd_scroll.h, lines);
+#else
+    (void)lines;
+#endif
+    lcd_scroll.offset = offset;
+    LCD_ScrollSend();
+}
+
+/**
+ * @brief  滚动区内容上移lines行（负数下移）
+ */
+void Lcd_Scroll(int16_t lines)
+{
+    int32_t offset;
+
+    if(lcd_scroll.h == 0) return;
+    offset = ((int32_t)lcd_scroll.offset + lines) % lcd_scroll.h;
+    if(offset < 0) offset += lcd_scroll.h;
+    Lcd_ScrollTo((uint16_t)offset);
+}
+
+/**
+ * @brief  获取滚动区当前偏移
+ * @return 内容上移的行数，未设置滚动区时为0
+ */
+uint16_t Lcd_ScrollOffset(void)
+{
+    return lcd_scroll.offset;
+}
+
+/*---------------------------------------------------第2层组合：像素流----------------------------------------------------*/
+
+/**
+ * @brief  直接向LCD打开/关闭像素流（不经过显示缓冲）
+ */
+static void LCD_StreamBegin(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    LCD_TxSelect();
+    LCD_SegBegin(x_start, y_start, x_end, y_end);   // 行坐标换成显存行，跨滚动区边界时只开第一段
+    lcd_transport->SetDC(1);        // 之后全部是像素数据
+    lcd_stream_open = 1;
+}
+
+static void LCD_StreamEnd(void)
+{
+    lcd_seg.split = 0;
+    if(!lcd_stream_open) return;
+    LCD_TxDeselect();
+    lcd_stream_open = 0;
+}
+
+/**
+ * @brief  打开一个像素流窗口
+ * @param  x_start: 起始X坐标 (0-127)
+ * @param  y_start: 起始Y坐标 (0-159)
+ * @param  x_end: 结束X坐标 (0-127)
+ * @param  y_end: 结束Y坐标 (0-159)
+ * @return 无
+ * @note   发送CASET/RASET/RAMWR后保持CS选中、DC=1，
+ *         之后用Lcd_WritePixel(s)/Lcd_FillPixels按行优先顺序写入像素，
+ *         最后必须调用Lcd_EndWindow释放片选；
+ *         显示缓冲模式下写入RAM，Lcd_Flush时才发送
+ * @example Lcd_BeginWindow(0, 0, 7, 15); Lcd_WritePixels(buf, 128); Lcd_EndWindow();
+ */
+void Lcd_BeginWindow(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_BeginWindow(x_start, y_start, x_end, y_end);
+#else
+    LCD_StreamBegin(x_start, y_start, x_end, y_end);
+#endif
+}
+
+/**
+ * @brief  向当前窗口写入一个像素
+ * @param  Color: 像素颜色 (RGB565格式)
+ */
+void Lcd_WritePixel(uint16_t Color)
+{
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_WritePixels(&Color, 1);
+#else
+    LCD_TxPixels(&Color, 1);
+#endif
+}
+
+/**
+ * @brief  向当前窗口写入一组像素
+ * @param  colors: 像素数组 (RGB565格式，按行优先)
+ * @param  count: 像素个数
+ */
+void Lcd_WritePixels(const uint16_t *colors, uint32_t count)
+{
+    if(count == 0) return;
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_WritePixels(colors, count);
+#else
+    LCD_TxPixels(colors, count);
+#endif
+}
+
+/**
+ * @brief  向当前窗口重复写入同一颜色
+ * @param  Color: 像素颜色 (RGB565格式)
+ * @param  count: 像素个数
+ */
+void Lcd_FillPixels(uint16_t Color, uint32_t count)
+{
+    if(count == 0) return;
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_FillPixels(Color, count);
+#else
+    LCD_TxFill(Color, count);
+#endif
+}
+
+/**
+ * @brief  向当前窗口写入高字节在前的像素字节（与总线上的顺序相同）
+ * @param  data: 像素字节，每像素2字节，高字节在前
+ * @param  count: 像素个数
+ * @note   直接模式下原样发送，省去逐像素的字节序转换（可以直接从Flash发送预先换好字节序的图片）；
+ *         显示缓冲模式下分段转换后写入RAM
+ */
+void Lcd_WritePixelBytes(const uint8_t *data, uint32_t count)
+{
+    if(count == 0) return;
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    uint16_t px[32];
+    uint32_t i, n;
+
+    while(count)
+    {
+        n = (count > 32) ? 32 : count;
+        for(i = 0; i < n; i++)
+        {
+            px[i] = (uint16_t)((data[0] << 8) | data[1]);
+            data += 2;
+        }
+        LCD_FB_WritePixels(px, n);
+        count -= n;
+    }
+#else
+    LCD_TxPixelBytes(data, count);
+#endif
+}
+
+/**
+ * @brief  取得一块像素缓冲区，填充后用Lcd_CommitPixels写入当前窗口
+ * @return 缓冲区指针，容量LCD_PIPE_BUF_PIXELS像素
+ * @note   共两块缓冲区轮流使用：一块在DMA发送时可以填充另一块，
+ *         两块都在发送中时等待其中一块发完
+ */
+uint16_t *Lcd_AcquirePixels(void)
+{
+    return LCD_Pipe_Acquire();
+}
+
+/**
+ * @brief  把Lcd_AcquirePixels取得的缓冲区写入当前窗口
+ * @param  buf: 缓冲区
+ * @param  count: 像素个数（<=LCD_PIPE_BUF_PIXELS）
+ * @note   直接模式下排队发送后立即返回（缓冲区归DMA所有，不能再写）；
+ *         显示缓冲模式下拷入RAM后立即归还
+ */
+void Lcd_CommitPixels(uint16_t *buf, uint32_t count)
+{
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_WritePixels(buf, count);
+    LCD_Pipe_Release(buf);
+#else
+    if(lcd_seg.split)
+    {
+        LCD_TxPixels(buf, count);   // 段边界要插入开窗命令，同步发送
+        LCD_Pipe_Release(buf);
+        return;
+    }
+    lcd_stats.pixel_bytes += count * 2;
+    LCD_WinAdvance(count);
+    LCD_Pipe_Submit(buf, count);
+#endif
+}
+
+/**
+ * @brief  结束像素流，释放片选
+ */
+void Lcd_EndWindow(void)
+{
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_EndWindow();
+#else
+    LCD_StreamEnd();
+#endif
+}
+
+/**
+ * @brief  把内存中的一块像素直接发送到LCD（一个窗口）
+ * @param  x, y: 左上角坐标
+ * @param  w, h: 宽高（调用方保证在屏幕内）
+ * @param  src: 左上角像素地址
+ * @param  stride: 源数据每行的像素数（>=w）
+ * @note   总是直接发送，显示缓冲的Lcd_Flush通过它把脏区域推到LCD
+ */
+void Lcd_PushRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *src, uint16_t stride)
+{
+    if(w == 0 || h == 0) return;
+
+    LCD_StreamBegin(x, y, x + w - 1, y + h - 1);
+    if(stride == w)
+    {
+        LCD_TxPixels(src, (uint32_t)w * h);     // 源数据连续，一次发完
+    }
+    else
+    {
+        while(h--)
+        {
+            LCD_TxPixels(src, w);
+            src += stride;
+        }
+    }
+    LCD_StreamEnd();
+}
+
+/**
+ * @brief  把显示缓冲中变化的区域发送到LCD
+ * @note   直接模式下为空操作，调用方可以无条件调用
+ */
+void Lcd_Flush(void)
+{
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_Flush();
+#endif
+    // 一次Flush为一帧，记录本帧省下的命令字节
+    lcd_stats.frame_saved_bytes = lcd_stats.saved_bytes - lcd_frame_saved_mark;
+    lcd_frame_saved_mark = lcd_stats.saved_bytes;
+}
+
 /*---------------------------------------------------第3层组合：像素操作----------------------------------------------------*/
 
 /**
@@ -230,28 +922,85 @@ void Lcd_SetXY(uint16_t x, uint16_t y)
  */
 void Gui_DrawPoint(uint16_t x, uint16_t y, uint16_t Data)
 {
-    Lcd_SetRegion(x, y, x+1, y+1);  // 设置一个像素的区域
-    LCD_WriteData_16Bit(Data);       // 写入颜色数据
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_SetPixel(x, y, Data);
+#else
+    // 窗口开到行尾：同一行向右连续画点时只发像素，同一列画点时CASET不变
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return;
+    LCD_StreamBegin(x, y, X_MAX_PIXEL - 1, y);
+    LCD_TxPixels(&Data, 1);
+    LCD_StreamEnd();
+#endif
 }    
 
+/**
+ * @brief  填充矩形区域
+ * @param  x: 左上角X坐标 (0-127)
+ * @param  y: 左上角Y坐标 (0-159)
+ * @param  w: 宽度（像素）
+ * @param  h: 高度（像素）
+ * @param  Color: 填充颜色 (RGB565格式)
+ * @return 无
+ * @note   只设置一次窗口，然后连续发送w*h个相同像素；
+ *         SPI字节数 = w*h*2 + 11（CASET/RASET各1+4字节，RAMWR 1字节）
+ *         超出屏幕的部分被裁掉
+ */
+void Lcd_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Color)
+{
+    if(w == 0 || h == 0) return;
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return;
+    if(w > X_MAX_PIXEL - x) w = X_MAX_PIXEL - x;
+    if(h > Y_MAX_PIXEL - y) h = Y_MAX_PIXEL - y;
+
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    LCD_FB_FillRect(x, y, w, h, Color);
+#else
+    LCD_StreamBegin(x, y, x + w - 1, y + h - 1);
+    LCD_TxFill(Color, (uint32_t)w * h);
+    LCD_StreamEnd();
+#endif
+}
+
+/**
+ * @brief  画水平线段
+ * @param  x: 起点X坐标
+ * @param  y: Y坐标
+ * @param  w: 长度（像素）
+ * @param  Color: 颜色 (RGB565格式)
+ */
+void Lcd_DrawHLine(uint16_t x, uint16_t y, uint16_t w, uint16_t Color)
+{
+    Lcd_FillRect(x, y, w, 1, Color);
+}
+
+/**
+ * @brief  画垂直线段
+ * @param  x: X坐标
+ * @param  y: 起点Y坐标
+ * @param  h: 长度（像素）
+ * @param  Color: 颜色 (RGB565格式)
+ */
+void Lcd_DrawVLine(uint16_t x, uint16_t y, uint16_t h, uint16_t Color)
+{
+    Lcd_FillRect(x, y, 1, h, Color);
+}
+
 /**
  * @brief  读取LCD某一点的颜色值
  * @param  x: X坐标 (0-127)
  * @param  y: Y坐标 (0-159)
  * @return 该点的颜色值 (RGB565格式)
- * @note   此函数未完全实现，需要配置SPI读取模式
+ * @note   显示缓冲模式下读取显存；直接模式下SDA为单向、没有接MISO，无法回读，返回0
  */
 unsigned int Lcd_ReadPoint(uint16_t x, uint16_t y)
 {
-    unsigned int Data;
-    Lcd_SetXY(x, y);  // 设置读取位置
-
-    // TODO: 需要实现SPI读取功能
-    // Lcd_ReadData(); // 丢掉第一个无用字节
-    // Data = Lcd_ReadData(); // 读取实际数据
-    
-    Lcd_WriteData(Data);  // 临时代码
-    return Data;
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    return LCD_FB_GetPixel(x, y);
+#else
+    (void)x;
+    (void)y;
+    return 0;
+#endif
 }
 
 /*---------------------------------------------------第4层组合：整屏操作----------------------------------------------------*/
@@ -264,22 +1013,8 @@ unsigned int Lcd_ReadPoint(uint16_t x, uint16_t y)
  */
 void Lcd_Clear(uint16_t Color)               
 {	
-    unsigned int i, m;
-    
-    // 设置全屏显示区域 (0,0) 到 (127,159)
-    Lcd_SetRegion(0, 0, X_MAX_PIXEL-1, Y_MAX_PIXEL-1);
-    
-    // 准备写入显存
-    Lcd_WriteIndex(0x2C);
-    
-    // 遍历所有像素点
-    for(i=0; i<X_MAX_PIXEL; i++)      // 列循环 (128次)
-    {
-        for(m=0; m<Y_MAX_PIXEL; m++)  // 行循环 (160次)
-        {	
-            LCD_WriteData_16Bit(Color);  // 写入颜色数据
-        }
-    }   
+    // 全屏一个窗口，一次片选内连续发送全部像素
+    Lcd_FillRect(0, 0, X_MAX_PIXEL, Y_MAX_PIXEL, Color);
 }
 
 /*---------------------------------------------------最高层：初始化----------------------------------------------------*/
@@ -292,8 +1027,9 @@ void Lcd_Clear(uint16_t Color)
  */
 void Lcd_Init(void)
 {    
-    LCD_GPIO_Init();   // 初始化GPIO引脚
-    Lcd_Reset();       // 硬件复位LCD
+    LCD_GPIO_Init();          // 初始化GPIO引脚
+    lcd_transport->Init();    // 初始化传输层（硬件SPI时把PA5/PA7切换到SPI1）
+    Lcd_Reset();              // 硬件复位LCD
 
     // ============ ST7735R初始化序列 ============
     
@@ -433,6 +1169,11 @@ void Lcd_Init(void)
     
     // 开启背光
     LCD_BacklightOn();
+
+#if (LCD_FB_MODE != LCD_FB_NONE)
+    // 复位后LCD显存内容未知，第一次Lcd_Flush发送整屏
+    LCD_FB_Invalidate(0, 0, X_MAX_PIXEL, Y_MAX_PIXEL);
+#endif
 }
 
 
@@ -0,0 +1,359 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Framebuffer.c
+ * @brief          : 全屏RGB565显存 + 脏矩形发送
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 只在 LCD_FB_MODE == LCD_FB_FULL 时编译。
+ * 显存按 [y][x] 存放本机字节序的RGB565，发送时由传输层按高字节先发。
+ * 每次窗口写入/填充只把"颜色发生变化"的像素的外接矩形加入脏矩形列表，
+ * 因此重画相同内容（例如每秒刷新的时间字符串中不变的数字）不产生SPI数据。
+ ******************************************************************************
+ */
+
+#include "lcd_Framebuffer.h"
+#include "lcd_Driver.h"
+#include <string.h>
+
+#if (LCD_FB_MODE == LCD_FB_FULL)
+
+static uint16_t lcd_fb[Y_MAX_PIXEL][X_MAX_PIXEL];      // 显存（40KB）
+
+static LCD_Rect_t fb_dirty[LCD_FB_DIRTY_MAX];           // 待发送区域
+static uint8_t fb_dirty_count = 0;
+static LCD_FB_Stats_t fb_stats;
+
+// 当前窗口（未裁剪，与LCD的CASET/RASET一致）和写指针
+static uint16_t fb_wx0, fb_wy0, fb_wx1, fb_wy1;
+static uint16_t fb_cx, fb_cy;
+static uint8_t fb_win_open = 0;
+
+// 当前窗口内颜色发生变化的像素的外接矩形
+static LCD_Rect_t fb_chg;
+static uint8_t fb_chg_any = 0;
+
+/*---------------------------------------------------脏矩形列表----------------------------------------------------*/
+
+static uint32_t FB_Area(const LCD_Rect_t *r)
+{
+    return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static LCD_Rect_t FB_Union(const LCD_Rect_t *a, const LCD_Rect_t *b)
+{
+    LCD_Rect_t u;
+
+    u.x0 = (a->x0 < b->x0) ? a->x0 : b->x0;
+    u.y0 = (a->y0 < b->y0) ? a->y0 : b->y0;
+    u.x1 = (a->x1 > b->x1) ? a->x1 : b->x1;
+    u.y1 = (a->y1 > b->y1) ? a->y1 : b->y1;
+    return u;
+}
+
+/**
+ * @brief  加入一个脏矩形
+ * @note   与已有矩形合并后多出的面积不超过LCD_FB_MERGE_SLACK时合并（相交的矩形一定满足），
+ *         合并后的矩形重新参与比较；列表已满时与"合并代价最小"的那个矩形合并
+ */
+static void FB_AddDirty(LCD_Rect_t r)
+{
+    uint8_t i, best;
+    uint32_t cost, best_cost;
+    LCD_Rect_t u;
+
+restart:
+    for(i = 0; i < fb_dirty_count; i++)
+    {
+        u = FB_Union(&fb_dirty[i], &r);
+        if(FB_Area(&u) <= FB_Area(&fb_dirty[i]) + FB_Area(&r) + LCD_FB_MERGE_SLACK)
+        {
+            r = u;
+            fb_dirty[i] = fb_dirty[--fb_dirty_count];
+            fb_stats.merges++;
+            goto restart;
+        }
+    }
+
+    if(fb_dirty_count == LCD_FB_DIRTY_MAX)
+    {
+        best = 0;
+        best_cost = 0xFFFFFFFFU;
+        for(i = 0; i < fb_dirty_count; i++)
+        {
+            u = FB_Union(&fb_dirty[i], &r);
+            cost = FB_Area(&u) - FB_Area(&fb_dirty[i]);
+            if(cost < best_cost)
+            {
+                best_cost = cost;
+                best = i;
+            }
+        }
+        r = FB_Union(&fb_dirty[best], &r);
+        fb_dirty[best] = fb_dirty[--fb_dirty_count];
+        fb_stats.merges++;
+        goto restart;
+    }
+
+    fb_dirty[fb_dirty_count++] = r;
+}
+
+/**
+ * @brief  记录一段变化的像素（同一行x0..x1）
+ */
+static void FB_MarkChanged(uint16_t x0, uint16_t x1, uint16_t y)
+{
+    if(!fb_chg_any)
+    {
+        fb_chg.x0 = x0;
+        fb_chg.x1 = x1;
+        fb_chg.y0 = y;
+        fb_chg.y1 = y;
+        fb_chg_any = 1;
+        return;
+    }
+    if(x0 < fb_chg.x0) fb_chg.x0 = x0;
+    if(x1 > fb_chg.x1) fb_chg.x1 = x1;
+    if(y < fb_chg.y0) fb_chg.y0 = y;
+    if(y > fb_chg.y1) fb_chg.y1 = y;
+}
+
+/*---------------------------------------------------窗口写入----------------------------------------------------*/
+
+void LCD_FB_BeginWindow(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    LCD_FB_EndWindow();
+
+    fb_wx0 = x_start;
+    fb_wy0 = y_start;
+    fb_wx1 = x_end;
+    fb_wy1 = y_end;
+    fb_cx = x_start;
+    fb_cy = y_start;
+    fb_chg_any = 0;
+    fb_win_open = 1;
+}
+
+/**
+ * @brief  写指针前进n个像素（n不超过当前行剩余像素），行尾换行，窗口末尾回到起点
+ */
+static void FB_Advance(uint16_t n)
+{
+    fb_cx += n;
+    if(fb_cx > fb_wx1)
+    {
+        fb_cx = fb_wx0;
+        if(++fb_cy > fb_wy1)
+            fb_cy = fb_wy0;
+    }
+}
+
+/**
+ * @brief  计算当前行本次可写的像素数及其在屏幕内的部分
+ * @param  count: 剩余像素数
+ * @param  n: 输出，本次前进的像素数
+ * @return 屏幕内的像素数（从写指针开始；0表示整段在屏幕外，右侧超出部分被裁掉）
+ */
+static uint16_t FB_Run(uint32_t count, uint16_t *n)
+{
+    uint16_t x1;
+
+    *n = fb_wx1 - fb_cx + 1;
+    if(*n > count) *n = (uint16_t)count;
+
+    if(fb_cy >= Y_MAX_PIXEL || fb_cx >= X_MAX_PIXEL) return 0;
+
+    x1 = fb_cx + *n - 1;
+    if(x1 >= X_MAX_PIXEL) x1 = X_MAX_PIXEL - 1;
+    return x1 - fb_cx + 1;
+}
+
+void LCD_FB_WritePixels(const uint16_t *colors, uint32_t count)
+{
+    uint16_t n, vis, i;
+    int16_t first, last;
+    uint16_t *dst;
+
+    if(!fb_win_open) return;
+
+    while(count)
+    {
+        vis = FB_Run(count, &n);
+        if(vis)
+        {
+            dst = &lcd_fb[fb_cy][fb_cx];
+            first = -1;
+            last = -1;
+            for(i = 0; i < vis; i++)
+            {
+                if(dst[i] != colors[i])
+                {
+                    dst[i] = colors[i];
+                    if(first < 0) first = i;
+                    last = i;
+                }
+            }
+            if(first >= 0)
+                FB_MarkChanged(fb_cx + first, fb_cx + last, fb_cy);
+        }
+        colors += n;
+        count -= n;
+        FB_Advance(n);
+    }
+}
+
+void LCD_FB_FillPixels(uint16_t Color, uint32_t count)
+{
+    uint16_t n, vis, i;
+    int16_t first, last;
+    uint16_t *dst;
+
+    if(!fb_win_open) return;
+
+    while(count)
+    {
+        vis = FB_Run(count, &n);
+        if(vis)
+        {
+            dst = &lcd_fb[fb_cy][fb_cx];
+            first = -1;
+            last = -1;
+            for(i = 0; i < vis; i++)
+            {
+                if(dst[i] != Color)
+                {
+                    dst[i] = Color;
+                    if(first < 0) first = i;
+                    last = i;
+                }
+            }
+            if(first >= 0)
+                FB_MarkChanged(fb_cx + first, fb_cx + last, fb_cy);
+        }
+        count -= n;
+        FB_Advance(n);
+    }
+}
+
+void LCD_FB_EndWindow(void)
+{
+    if(!fb_win_open) return;
+    fb_win_open = 0;
+    if(fb_chg_any)
+        FB_AddDirty(fb_chg);
+    fb_chg_any = 0;
+}
+
+/*---------------------------------------------------矩形/单点----------------------------------------------------*/
+
+void LCD_FB_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t Color)
+{
+    LCD_FB_BeginWindow(x, y, x + w - 1, y + h - 1);
+    LCD_FB_FillPixels(Color, (uint32_t)w * h);
+    LCD_FB_EndWindow();
+}
+
+void LCD_FB_SetPixel(uint16_t x, uint16_t y, uint16_t Color)
+{
+    LCD_Rect_t r;
+
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return;
+    if(lcd_fb[y][x] == Color) return;
+
+    lcd_fb[y][x] = Color;
+    r.x0 = r.x1 = x;
+    r.y0 = r.y1 = y;
+    FB_AddDirty(r);
+}
+
+uint16_t LCD_FB_GetPixel(uint16_t x, uint16_t y)
+{
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return 0;
+    return lcd_fb[y][x];
+}
+
+void LCD_FB_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    LCD_Rect_t r;
+
+    if(w == 0 || h == 0) return;
+    if(x >= X_MAX_PIXEL || y >= Y_MAX_PIXEL) return;
+    if(w > X_MAX_PIXEL - x) w = X_MAX_PIXEL - x;
+    if(h > Y_MAX_PIXEL - y) h = Y_MAX_PIXEL - y;
+
+    r.x0 = x;
+    r.y0 = y;
+    r.x1 = x + w - 1;
+    r.y1 = y + h - 1;
+    FB_AddDirty(r);
+}
+
+/**
+ * @brief  把显存第[y0, y1)行上下颠倒
+ */
+static void FB_ReverseRows(uint16_t y0, uint16_t y1)
+{
+    uint16_t tmp[X_MAX_PIXEL];
+
+    while(y0 + 1 < y1)
+    {
+        y1--;
+        memcpy(tmp, lcd_fb[y0], sizeof(tmp));
+        memcpy(lcd_fb[y0], lcd_fb[y1], sizeof(tmp));
+        memcpy(lcd_fb[y1], tmp, sizeof(tmp));
+        y0++;
+    }
+}
+
+/**
+ * @brief  [y, y+h)行循环上移lines行（三次颠倒，只用一行临时缓冲）
+ * @note   屏幕上的内容已由LCD硬件滚动移动，这里只移动行，不产生脏矩形
+ */
+void LCD_FB_Scroll(uint16_t y, uint16_t h, uint16_t lines)
+{
+    if(h == 0 || y >= Y_MAX_PIXEL || h > Y_MAX_PIXEL - y) return;
+    lines %= h;
+    if(lines == 0) return;
+
+    FB_ReverseRows(y, y + lines);
+    FB_ReverseRows(y + lines, y + h);
+    FB_ReverseRows(y, y + h);
+}
+
+/*---------------------------------------------------发送----------------------------------------------------*/
+
+/**
+ * @brief  把所有脏矩形发送到LCD，每个矩形一次开窗
+ */
+void LCD_FB_Flush(void)
+{
+    uint8_t i;
+    const LCD_Rect_t *r;
+
+    LCD_FB_EndWindow();
+    if(fb_dirty_count == 0) return;
+
+    for(i = 0; i < fb_dirty_count; i++)
+    {
+        r = &fb_dirty[i];
+        Lcd_PushRect(r->x0, r->y0, r->x1 - r->x0 + 1, r->y1 - r->y0 + 1,
+                     &lcd_fb[r->y0][r->x0], X_MAX_PIXEL);
+        fb_stats.rects++;
+        fb_stats.pixels += FB_Area(r);
+    }
+    fb_dirty_count = 0;
+    fb_stats.flushes++;
+}
+
+const LCD_FB_Stats_t *LCD_FB_GetStats(void)
+{
+    return &fb_stats;
+}
+
+void LCD_FB_ResetStats(void)
+{
+    memset(&fb_stats, 0, sizeof(fb_stats));
+}
+
+#endif /* LCD_FB_MODE == LCD_FB_FULL */
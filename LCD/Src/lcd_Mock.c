@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Mock.c
+ * @brief          : 记录型传输层实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 使用方法：
+ *   LCD_SetTransport(&LCD_Transport_Mock);
+ *   LCD_Mock_Reset();
+ *   ...调用任意绘图函数...
+ *   LCD_Mock_GetStats()->hash / cmd_bytes / data_bytes
+ * 不依赖HAL库，主机端也能直接编译
+ ******************************************************************************
+ */
+
+#include "lcd_Mock.h"
+
+#define FNV_OFFSET  2166136261u
+#define FNV_PRIME   16777619u
+
+static LCD_MockEntry_t mock_log[LCD_MOCK_LOG_SIZE];
+static LCD_MockStats_t mock_stats = { 0, 0, 0, 0, FNV_OFFSET, 0 };
+static uint8_t mock_dc = 1;
+
+/**
+ * @brief  记录一个字节
+ */
+static void Mock_Record(uint8_t byte)
+{
+    if(mock_stats.logged < LCD_MOCK_LOG_SIZE)
+    {
+        mock_log[mock_stats.logged].dc = mock_dc;
+        mock_log[mock_stats.logged].byte = byte;
+        mock_stats.logged++;
+    }
+
+    mock_stats.hash = (mock_stats.hash ^ mock_dc) * FNV_PRIME;
+    mock_stats.hash = (mock_stats.hash ^ byte) * FNV_PRIME;
+
+    mock_stats.bytes++;
+    if(mock_dc)
+        mock_stats.data_bytes++;
+    else
+        mock_stats.cmd_bytes++;
+}
+
+/**
+ * @brief  清空记录
+ */
+void LCD_Mock_Reset(void)
+{
+    mock_stats.bytes = 0;
+    mock_stats.cmd_bytes = 0;
+    mock_stats.data_bytes = 0;
+    mock_stats.selects = 0;
+    mock_stats.hash = FNV_OFFSET;
+    mock_stats.logged = 0;
+}
+
+/**
+ * @brief  获取记录统计
+ */
+const LCD_MockStats_t *LCD_Mock_GetStats(void)
+{
+    return &mock_stats;
+}
+
+/**
+ * @brief  获取逐字节日志（条目数见stats->logged）
+ */
+const LCD_MockEntry_t *LCD_Mock_GetLog(void)
+{
+    return mock_log;
+}
+
+/*---------------------------------------------------传输层接口----------------------------------------------------*/
+
+static void Mock_Init(void)
+{
+    mock_dc = 1;
+}
+
+static void Mock_Select(void)
+{
+    mock_stats.selects++;
+}
+
+static void Mock_Deselect(void)
+{
+}
+
+static void Mock_SetDC(uint8_t dc)
+{
+    mock_dc = dc ? 1 : 0;
+}
+
+static void Mock_Write(const uint8_t *buf, uint32_t len)
+{
+    while(len--)
+    {
+        Mock_Record(*buf++);
+    }
+}
+
+static void Mock_Write16(const uint16_t *px, uint32_t count)
+{
+    while(count--)
+    {
+        Mock_Record(*px >> 8);
+        Mock_Record(*px & 0xFF);
+        px++;
+    }
+}
+
+static void Mock_Fill16(uint16_t color, uint32_t count)
+{
+    while(count--)
+    {
+        Mock_Record(color >> 8);
+        Mock_Record(color & 0xFF);
+    }
+}
+
+static void Mock_Write16Async(const uint16_t *px, uint32_t count, void (*done)(void))
+{
+    Mock_Write16(px, count);
+    if(done) done();
+}
+
+const LCD_Transport_t LCD_Transport_Mock =
+{
+    "mock",
+    Mock_Init,
+    Mock_Select,
+    Mock_Deselect,
+    Mock_SetDC,
+    Mock_Write,
+    Mock_Write16,
+    Mock_Fill16,
+    Mock_Write16Async,
+};
@@ -0,0 +1,208 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Pipe.c
+ * @brief          : 像素发送流水线（乒乓缓冲）实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 缓冲区状态：空闲 -> 填充中(Acquire) -> 排队(Submit) -> 发送中 -> 空闲(DMA完成中断)
+ * 同一时刻最多一个缓冲区在发送；发送完成回调中直接启动排队的下一个缓冲区，
+ * 所以两个缓冲区之间SPI几乎没有空闲。
+ * 软件SPI/Mock后端的Write16Async是阻塞的，流水线退化为普通的逐块发送。
+ ******************************************************************************
+ */
+
+#include "lcd_Pipe.h"
+#include "lcd_Driver.h"
+#include <string.h>
+
+#define PIPE_BUFS       2
+
+#define PIPE_FREE       0
+#define PIPE_FILL       1
+#define PIPE_QUEUED     2
+#define PIPE_SENDING    3
+
+// 临界区：Submit与DMA完成中断都会修改发送状态
+#if defined(__CORTEX_M)
+#define PIPE_LOCK()     uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define PIPE_UNLOCK()   __set_PRIMASK(primask)
+#else
+#define PIPE_LOCK()     do {} while(0)
+#define PIPE_UNLOCK()   do {} while(0)
+#endif
+
+// DWT周期计数（主机端构建没有DWT，统计为0）
+#if defined(DWT)
+#define PIPE_CYCLES()   (DWT->CYCCNT)
+#else
+#define PIPE_CYCLES()   0U
+#endif
+
+static uint16_t pipe_buf[PIPE_BUFS][LCD_PIPE_BUF_PIXELS];
+static volatile uint8_t pipe_state[PIPE_BUFS];
+static uint32_t pipe_len[PIPE_BUFS];
+static volatile int8_t pipe_sending = -1;      // 正在发送的缓冲区，-1=无
+static volatile int8_t pipe_queued = -1;       // 排队等待发送的缓冲区，-1=无
+static uint8_t pipe_next = 0;                  // 下一个交给调用方的缓冲区
+static uint32_t pipe_start_cycles;             // 当前缓冲区开始发送时的周期数
+static uint8_t pipe_dwt_on = 0;
+
+static LCD_PipeStats_t pipe_stats;
+
+static void Pipe_Start(int8_t idx);
+
+/**
+ * @brief  打开DWT周期计数器（只做一次）
+ */
+static void Pipe_CycleInit(void)
+{
+    if(pipe_dwt_on) return;
+#if defined(DWT)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    pipe_dwt_on = 1;
+}
+
+/**
+ * @brief  当前缓冲区发送完成（DMA中断中调用，阻塞型后端在Write16Async内调用）
+ */
+static void Pipe_Done(void)
+{
+    int8_t next;
+
+    pipe_stats.xfer_cycles += PIPE_CYCLES() - pipe_start_cycles;
+    pipe_state[pipe_sending] = PIPE_FREE;
+    pipe_sending = -1;
+
+    next = pipe_queued;
+    if(next >= 0)
+    {
+        pipe_queued = -1;
+        Pipe_Start(next);
+    }
+}
+
+static void Pipe_Start(int8_t idx)
+{
+    pipe_state[idx] = PIPE_SENDING;
+    pipe_sending = idx;
+    pipe_start_cycles = PIPE_CYCLES();
+    LCD_GetTransport()->Write16Async(pipe_buf[idx], pipe_len[idx], Pipe_Done);
+}
+
+/**
+ * @brief  取得一个可以填充的缓冲区（容量LCD_PIPE_BUF_PIXELS像素）
+ * @return 缓冲区指针
+ * @note   两个缓冲区都在使用中时等待DMA释放一个
+ */
+uint16_t *LCD_Pipe_Acquire(void)
+{
+    uint8_t idx = pipe_next;
+    uint32_t t0;
+
+    Pipe_CycleInit();
+
+    if(pipe_state[idx] != PIPE_FREE)
+    {
+        t0 = PIPE_CYCLES();
+        while(pipe_state[idx] != PIPE_FREE);
+        pipe_stats.wait_cycles += PIPE_CYCLES() - t0;
+    }
+
+    pipe_state[idx] = PIPE_FILL;
+    pipe_next = (idx + 1) % PIPE_BUFS;
+    return pipe_buf[idx];
+}
+
+/**
+ * @brief  提交一个已填充的缓冲区，空闲时立即开始发送，否则排在当前发送之后
+ * @param  buf: LCD_Pipe_Acquire返回的缓冲区
+ * @param  count: 像素数（<=LCD_PIPE_BUF_PIXELS），0等同于Release
+ */
+void LCD_Pipe_Submit(uint16_t *buf, uint32_t count)
+{
+    int8_t idx = (buf == pipe_buf[0]) ? 0 : 1;
+
+    if(count == 0)
+    {
+        LCD_Pipe_Release(buf);
+        return;
+    }
+
+    pipe_len[idx] = count;
+    pipe_stats.submits++;
+    pipe_stats.pixels += count;
+
+    {
+        PIPE_LOCK();
+        if(pipe_sending < 0)
+        {
+            Pipe_Start(idx);
+        }
+        else
+        {
+            pipe_state[idx] = PIPE_QUEUED;
+            pipe_queued = idx;
+        }
+        PIPE_UNLOCK();
+    }
+}
+
+/**
+ * @brief  归还一个未提交的缓冲区（显示缓冲模式下数据已拷入RAM时使用）
+ */
+void LCD_Pipe_Release(uint16_t *buf)
+{
+    int8_t idx = (buf == pipe_buf[0]) ? 0 : 1;
+
+    pipe_state[idx] = PIPE_FREE;
+}
+
+/**
+ * @brief  等待所有已提交的缓冲区发送完毕
+ * @note   lcd_Driver.c在切换CS/DC或直接发送之前调用，保证字节顺序
+ */
+void LCD_Pipe_Drain(void)
+{
+    uint32_t t0;
+
+    if(pipe_sending < 0 && pipe_queued < 0) return;
+
+    t0 = PIPE_CYCLES();
+    while(pipe_sending >= 0 || pipe_queued >= 0);
+    pipe_stats.wait_cycles += PIPE_CYCLES() - t0;
+}
+
+/**
+ * @brief  获取流水线统计
+ */
+const LCD_PipeStats_t *LCD_Pipe_GetStats(void)
+{
+    return &pipe_stats;
+}
+
+/**
+ * @brief  清零流水线统计
+ */
+void LCD_Pipe_ResetStats(void)
+{
+    Pipe_CycleInit();
+    memset(&pipe_stats, 0, sizeof(pipe_stats));
+}
+
+/**
+ * @brief  SPI发送时间中被CPU渲染掩盖的比例
+ * @return 0~100，(发送周期 - 等待周期) / 发送周期
+ */
+uint8_t LCD_Pipe_OverlapPercent(void)
+{
+    uint32_t xfer = pipe_stats.xfer_cycles;
+    uint32_t wait = pipe_stats.wait_cycles;
+
+    if(xfer == 0) return 0;
+    if(wait >= xfer) return 0;
+    return (uint8_t)((uint64_t)(xfer - wait) * 100U / xfer);
+}
@@ -0,0 +1,338 @@
+/**
+ ******************************************************************************
+ * @file           : lcd_Transport.c
+ * @brief          : ST7735传输层实现
+ *                   软件SPI（GPIO模拟）和硬件SPI1+DMA两种后端
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 主要功能：
+ * - 软件SPI：逐位翻转SCL/SDA，作为没有接硬件SPI时的备用方案
+ * - 硬件SPI：SPI1发送 + DMA2 Stream3，长数据和纯色填充走DMA
+ * - CS/DC 仍由GPIO控制，切换前等待SPI发送完成
+ ******************************************************************************
+ */
+
+#include "lcd_Transport.h"
+#include "lcd_Driver.h"
+#include "LCD_Config.h"
+#if LCD_HW_SPI_ENABLE
+#include "spi.h"
+#endif
+
+/*---------------------------------------------------软件SPI后端----------------------------------------------------*/
+
+/**
+ * @brief  各GPIO后端发送一位：SCL拉低时准备SDA，SCL上升沿LCD采样
+ * @note   BSRR方式下第一次存储同时完成"SCL=0"和"SDA=数据位"，每位只需两条存储指令；
+ *         (~d>>n)&1 为0时SDA写入BSRR低半字(置1)，为1时写入高半字(清0)，没有分支。
+ *         SPI_WriteData按LCD_GPIO_BACKEND选用其中一种，吞吐量测试分别计时BSRR和位带两种
+ */
+#define SOFTSPI_BIT_BSRR(d, n)                                                              \
+    do {                                                                                    \
+        LCD_CTRL->BSRR = ((uint32_t)LCD_SCL << 16)                                          \
+                       | ((uint32_t)LCD_SDA << (((~(uint32_t)(d) >> (n)) & 1U) << 4));      \
+        LCD_CTRL->BSRR = LCD_SCL;                                                           \
+    } while(0)
+
+#define SOFTSPI_BIT_BITBAND(d, n)                                                           \
+    do {                                                                                    \
+        LCD_ODR_BB(LCD_SCL_POS) = 0U;                                                       \
+        LCD_ODR_BB(LCD_SDA_POS) = ((uint32_t)(d) >> (n)) & 1U;                              \
+        LCD_ODR_BB(LCD_SCL_POS) = 1U;                                                       \
+    } while(0)
+
+#define SOFTSPI_BIT_HAL(d, n)                                                               \
+    do {                                                                                    \
+        HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_RESET);                               \
+        HAL_GPIO_WritePin(LCD_CTRL, LCD_SDA, (((d) >> (n)) & 1U) ? GPIO_PIN_SET : GPIO_PIN_RESET); \
+        HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_SET);                                 \
+    } while(0)
+
+// 8位完全展开，MSB先发送
+#define SOFTSPI_BYTE(bit, d)                                                                \
+    do {                                                                                    \
+        bit(d, 7); bit(d, 6); bit(d, 5); bit(d, 4);                                         \
+        bit(d, 3); bit(d, 2); bit(d, 1); bit(d, 0);                                         \
+    } while(0)
+
+/**
+ * @brief  软件SPI发送8位数据
+ * @param  Data: 要发送的8位数据
+ * @return 无
+ * @note   引脚写法由LCD_Config.h中的LCD_GPIO_BACKEND决定
+ */
+static void SPI_WriteData(uint8_t Data)
+{
+#if (LCD_GPIO_BACKEND == LCD_GPIO_BSRR)
+    SOFTSPI_BYTE(SOFTSPI_BIT_BSRR, Data);
+#elif (LCD_GPIO_BACKEND == LCD_GPIO_BITBAND)
+    SOFTSPI_BYTE(SOFTSPI_BIT_BITBAND, Data);
+#else
+    SOFTSPI_BYTE(SOFTSPI_BIT_HAL, Data);
+#endif
+}
+
+/**
+ * @brief  软件SPI初始化
+ * @note   PA5/PA7重新配置为普通推挽输出（从硬件SPI切换回来时需要）
+ */
+static void SoftSPI_Init(void)
+{
+    LCD_GPIO_Init();
+}
+
+static void SoftSPI_Select(void)
+{
+    LCD_CS_CLR;
+}
+
+static void SoftSPI_Deselect(void)
+{
+    LCD_CS_SET;
+}
+
+static void SoftSPI_SetDC(uint8_t dc)
+{
+    if(dc)
+        LCD_DC_SET;
+    else
+        LCD_DC_CLR;
+}
+
+static void SoftSPI_Write(const uint8_t *buf, uint32_t len)
+{
+    while(len--)
+    {
+        SPI_WriteData(*buf++);
+    }
+}
+
+static void SoftSPI_Write16(const uint16_t *px, uint32_t count)
+{
+    while(count--)
+    {
+        SPI_WriteData(*px >> 8);
+        SPI_WriteData(*px & 0xFF);
+        px++;
+    }
+}
+
+static void SoftSPI_Fill16(uint16_t color, uint32_t count)
+{
+    while(count--)
+    {
+        SPI_WriteData(color >> 8);
+        SPI_WriteData(color & 0xFF);
+    }
+}
+
+static void SoftSPI_Write16Async(const uint16_t *px, uint32_t count, void (*done)(void))
+{
+    SoftSPI_Write16(px, count);     // CPU逐位发送，没有可重叠的时间
+    if(done) done();
+}
+
+const LCD_Transport_t LCD_Transport_SoftSPI =
+{
+    "soft-spi",
+    SoftSPI_Init,
+    SoftSPI_Select,
+    SoftSPI_Deselect,
+    SoftSPI_SetDC,
+    SoftSPI_Write,
+    SoftSPI_Write16,
+    SoftSPI_Fill16,
+    SoftSPI_Write16Async,
+};
+
+/*---------------------------------------------------软件SPI吞吐量测试----------------------------------------------------*/
+#if defined(DWT)
+
+/**
+ * @brief  原始的HAL_GPIO_WritePin逐位发送，作为测试基准
+ */
+static void SPI_WriteData_HAL(uint8_t Data)
+{
+    unsigned char i=0;
+
+    for(i = 8; i > 0; i--)
+    {
+        HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_RESET);
+        if(Data & 0x80)
+            HAL_GPIO_WritePin(LCD_CTRL, LCD_SDA, GPIO_PIN_SET);
+        else
+            HAL_GPIO_WritePin(LCD_CTRL, LCD_SDA, GPIO_PIN_RESET);
+        HAL_GPIO_WritePin(LCD_CTRL, LCD_SCL, GPIO_PIN_SET);
+        Data <<= 1;
+    }
+}
+
+// BSRR后端，与LCD_GPIO_BACKEND无关，总是可以计时
+static void SPI_WriteData_BSRR(uint8_t Data)
+{
+    SOFTSPI_BYTE(SOFTSPI_BIT_BSRR, Data);
+}
+
+// 位带后端
+static void SPI_WriteData_BitBand(uint8_t Data)
+{
+    SOFTSPI_BYTE(SOFTSPI_BIT_BITBAND, Data);
+}
+
+/**
+ * @brief  用一种写法发送bytes个字节，返回耗费的CPU周期
+ */
+static uint32_t SoftSPI_Time(void (*write)(uint8_t), uint32_t bytes)
+{
+    uint32_t i, start = DWT->CYCCNT;
+
+    for(i = 0; i < bytes; i++)
+    {
+        write((i & 1) ? 0xA5 : 0x5A);
+    }
+    return DWT->CYCCNT - start;
+}
+
+static uint32_t SoftSPI_Bps(uint32_t bytes, uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)bytes * 8U * SystemCoreClock / (cycles ? cycles : 1U));
+}
+
+/**
+ * @brief  用DWT周期计数器比较HAL方式、BSRR和位带三种写法的软件SPI速度
+ * @param  bytes: 每种方式发送的字节数
+ * @param  result: 输出结果
+ * @return 无
+ * @note   三种写法各有自己的发送函数，不经过LCD_PIN_*宏，一次运行就能比较，与LCD_GPIO_BACKEND无关；
+ *         测试期间CS保持高电平，LCD不会接收这些数据；
+ *         硬件SPI后端下PA5/PA7为复用功能，写ODR不影响引脚，但计时结果相同
+ */
+void LCD_SoftSPI_Benchmark(uint32_t bytes, LCD_SoftSPIBench_t *result)
+{
+    if(result == NULL || bytes == 0) return;
+
+    // 打开DWT周期计数器
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    LCD_CS_SET;
+
+    result->hal_cycles = SoftSPI_Time(SPI_WriteData_HAL, bytes);
+    result->bsrr_cycles = SoftSPI_Time(SPI_WriteData_BSRR, bytes);
+    result->bitband_cycles = SoftSPI_Time(SPI_WriteData_BitBand, bytes);
+
+    result->bytes = bytes;
+    result->hal_bps = SoftSPI_Bps(bytes, result->hal_cycles);
+    result->bsrr_bps = SoftSPI_Bps(bytes, result->bsrr_cycles);
+    result->bitband_bps = SoftSPI_Bps(bytes, result->bitband_cycles);
+}
+
+#else
+
+void LCD_SoftSPI_Benchmark(uint32_t bytes, LCD_SoftSPIBench_t *result)
+{
+    (void)bytes;
+    if(result == NULL) return;
+    result->bytes = 0;
+    result->hal_cycles = 0;
+    result->bsrr_cycles = 0;
+    result->bitband_cycles = 0;
+    result->hal_bps = 0;
+    result->bsrr_bps = 0;
+    result->bitband_bps = 0;
+}
+
+#endif /* DWT */
+
+/*---------------------------------------------------硬件SPI1 + DMA后端----------------------------------------------------*/
+#if LCD_HW_SPI_ENABLE
+
+static uint16_t hwspi_fill_color;   // 纯色填充时DMA的源（地址不递增）
+
+/**
+ * @brief  硬件SPI初始化
+ * @note   PA5/PA7切换到AF5(SPI1)，CS/DC/RES/BLK仍为GPIO
+ */
+static void HwSPI_Init(void)
+{
+    MX_SPI1_Init();
+    LCD_CS_SET;
+}
+
+static void HwSPI_Select(void)
+{
+    LCD_CS_CLR;
+}
+
+static void HwSPI_Deselect(void)
+{
+    SPI1_WaitIdle();    // 最后一个字节移出后才能拉高CS
+    LCD_CS_SET;
+}
+
+static void HwSPI_SetDC(uint8_t dc)
+{
+    SPI1_WaitIdle();    // DC在最后一位采样前不能变化
+    if(dc)
+        LCD_DC_SET;
+    else
+        LCD_DC_CLR;
+}
+
+static void HwSPI_Write(const uint8_t *buf, uint32_t len)
+{
+    SPI1_SetFrame16(0);
+    SPI1_Transmit(buf, len, 1);
+    if(len >= SPI1_DMA_MIN_BYTES)
+        SPI1_WaitIdle();    // 缓冲区可能在调用方栈上，等DMA读完再返回
+}
+
+static void HwSPI_Write16(const uint16_t *px, uint32_t count)
+{
+    SPI1_SetFrame16(1);     // 16位帧：小端内存中的uint16_t直接按高字节先发
+    SPI1_Transmit(px, count, 1);
+    if(count * 2 >= SPI1_DMA_MIN_BYTES)
+        SPI1_WaitIdle();
+}
+
+/**
+ * @brief  启动16位像素发送后立即返回
+ * @note   走DMA时done在DMA2_Stream3中断中调用；短数据轮询写完DR后直接调用
+ */
+static void HwSPI_Write16Async(const uint16_t *px, uint32_t count, void (*done)(void))
+{
+    SPI1_SetFrame16(1);
+    if(count * 2 < SPI1_DMA_MIN_BYTES)
+    {
+        SPI1_Transmit(px, count, 1);
+        if(done) done();
+        return;
+    }
+    SPI1_OnTxComplete(done);
+    SPI1_Transmit(px, count, 1);
+}
+
+static void HwSPI_Fill16(uint16_t color, uint32_t count)
+{
+    SPI1_SetFrame16(1);     // 16位帧：DR写入color，高字节先移出
+    hwspi_fill_color = color;
+    SPI1_Transmit(&hwspi_fill_color, count, 0);
+    SPI1_WaitIdle();
+}
+
+const LCD_Transport_t LCD_Transport_HwSPI =
+{
+    "spi1-dma",
+    HwSPI_Init,
+    HwSPI_Select,
+    HwSPI_Deselect,
+    HwSPI_SetDC,
+    HwSPI_Write,
+    HwSPI_Write16,
+    HwSPI_Fill16,
+    HwSPI_Write16Async,
+};
+
+#endif /* LCD_HW_SPI_ENABLE */
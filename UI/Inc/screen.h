@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file           : screen.h
+ * @brief          : 主界面布局
+ *                   把天气、室内温湿度、日期时间放到固定位置的控件上，
+ *                   main.c 和 esp32_weather.c 只提交数据，由 Screen_Update 统一绘制
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ */
+
+#ifndef __SCREEN_H
+#define __SCREEN_H
+
+#include <stdint.h>
+
+// 清屏并画出静态图标，初始化所有控件
+void Screen_Init(void);
+
+// 数据输入（只更新控件的绑定值）
+void Screen_SetIndoor(int humidity, int temperature);
+void Screen_AddIndoorSample(int humidity, int temperature);
+void Screen_SetWeather(const char *condition);
+void Screen_SetOutdoorTemp(const char *temp);
+void Screen_SetDateTime(const char *date, const char *time);
+
+// 只重画发生变化的控件，然后Lcd_Flush；没有变化时不发送任何数据
+void Screen_Update(void);
+
+#endif /* __SCREEN_H */
@@ -0,0 +1,167 @@
+/**
+ ******************************************************************************
+ * @file           : screen.c
+ * @brief          : 主界面布局实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 布局（坐标与原来 main.c / esp32_weather.c 中的直接绘图相同）：
+ *   (10,10)  天气状况        (80,10)  室外温度图标     (100,10) 室外温度
+ *   (1,50)   湿度图标        (50,50)  温度图标         (90,40)  图片
+ *   (25,55)  室内湿度        (68,55)  室内温度         (82,52)  度数圆点  (82,55) 单位
+ *   (10,90)  日期            (20,110) 时间
+ *   (0,128)  室内温湿度历史曲线（128x32，湿度蓝线灰色填充，温度红线）
+ * 室内温度的第二位与单位字符有两列重叠，温度重画后单位也要重画。
+ ******************************************************************************
+ */
+
+#include "screen.h"
+#include "GUI_Widget.h"
+#include "GUI_Chart.h"
+#include "GUI.h"
+#include "lcd_Driver.h"
+#include "font.h"
+
+// 静态图标
+static GUI_Widget_t scr_icon_humi;
+static GUI_Widget_t scr_icon_temp;
+static GUI_Widget_t scr_icon_pic;
+static GUI_Widget_t scr_icon_out;
+
+// 数据
+static GUI_Widget_t scr_weather;
+static GUI_Widget_t scr_out_temp;
+static GUI_Widget_t scr_humi;
+static GUI_Widget_t scr_temp;
+static GUI_Widget_t scr_degree;
+static GUI_Widget_t scr_unit;
+static GUI_Widget_t scr_date;
+static GUI_Widget_t scr_time;
+
+// 历史曲线
+static GUI_Chart_t scr_history;
+
+// 绘制顺序（温度、度数圆点、单位在Screen_Update中单独处理）
+static GUI_Widget_t *const scr_widgets[] =
+{
+    &scr_icon_humi,
+    &scr_icon_temp,
+    &scr_icon_pic,
+    &scr_icon_out,
+    &scr_weather,
+    &scr_out_temp,
+    &scr_humi,
+    &scr_date,
+    &scr_time,
+};
+
+/**
+ * @brief  清屏并初始化所有控件（图标在第一次Screen_Update时画出）
+ */
+void Screen_Init(void)
+{
+    Lcd_Clear(WHITE);
+
+    GUI_Icon_Init(&scr_icon_humi, 1, 50, gImage_humo_nei, WHITE);
+    GUI_Icon_Init(&scr_icon_temp, 50, 50, gImage_temp_nei, WHITE);
+    GUI_Icon_Init(&scr_icon_pic, 90, 40, gImage_1, WHITE);
+    GUI_Icon_Init(&scr_icon_out, 80, 10, gImage_temp_wai, WHITE);
+
+    GUI_Label_Init(&scr_weather, 10, 10, 8, GUI_FONT_ASCII16, BLACK, WHITE);    // 到室外温度图标为止
+    GUI_Label_Init(&scr_out_temp, 100, 10, 3, GUI_FONT_ASCII16, BLACK, WHITE);
+    GUI_Label_Init(&scr_humi, 25, 55, 3, GUI_FONT_ASCII16, BLACK, WHITE);       // "99%"，到室内温度图标为止
+    GUI_Label_Init(&scr_temp, 68, 55, 2, GUI_FONT_ASCII16, BLACK, WHITE);
+    GUI_Dot_Init(&scr_degree, 82, 52, 1, BLACK);
+    GUI_Label_Init(&scr_unit, 82, 55, 1, GUI_FONT_ASCII16, BLACK, WHITE);
+    GUI_Label_Init(&scr_date, 10, 90, 10, GUI_FONT_ASCII16, BLACK, WHITE);
+    GUI_Label_Init(&scr_time, 20, 110, 8, GUI_FONT_ASCII16, BLACK, WHITE);
+
+    GUI_Chart_Init(&scr_history, 0, 128, X_MAX_PIXEL, Y_MAX_PIXEL - 128, WHITE);
+    GUI_Chart_AddSeries(&scr_history, BLUE, GRAY0, 10);    // 湿度，范围按10%取整
+    GUI_Chart_AddSeries(&scr_history, RED, WHITE, 5);      // 温度，范围按5度取整，不填充
+}
+
+/**
+ * @brief  室内温湿度（DHT11）
+ * @note   高于30度红色，低于10度蓝色（圆点和单位为黑色小写c），其余黑色
+ * @note   DHT11湿度量程20~90%，超过99按99显示，避免标签画进右边的温度图标
+ */
+void Screen_SetIndoor(int humidity, int temperature)
+{
+    if(humidity > 99) humidity = 99;
+    GUI_Widget_SetInt(&scr_humi, humidity, "%d%%");
+    GUI_Widget_SetInt(&scr_temp, temperature, "%d");
+
+    if(temperature > 30)
+    {
+        GUI_Widget_SetColor(&scr_temp, RED, WHITE);
+        GUI_Widget_SetColor(&scr_degree, RED, WHITE);
+        GUI_Widget_SetColor(&scr_unit, RED, WHITE);
+        GUI_Widget_SetText(&scr_unit, "c");
+    }
+    else if(temperature < 10)
+    {
+        GUI_Widget_SetColor(&scr_temp, BLUE, WHITE);
+        GUI_Widget_SetColor(&scr_degree, BLACK, WHITE);
+        GUI_Widget_SetColor(&scr_unit, BLACK, WHITE);
+        GUI_Widget_SetText(&scr_unit, "c");
+    }
+    else
+    {
+        GUI_Widget_SetColor(&scr_temp, BLACK, WHITE);
+        GUI_Widget_SetColor(&scr_degree, BLACK, WHITE);
+        GUI_Widget_SetColor(&scr_unit, BLACK, WHITE);
+        GUI_Widget_SetText(&scr_unit, "C");
+    }
+}
+
+/**
+ * @brief  室内温湿度历史记录加入一个采样
+ * @note   由调用方按固定周期调用（与Screen_SetIndoor的刷新频率无关），第一个采样到来后才显示曲线
+ */
+void Screen_AddIndoorSample(int humidity, int temperature)
+{
+    int16_t v[2];
+
+    v[0] = (int16_t)humidity;
+    v[1] = (int16_t)temperature;
+    GUI_Chart_Push(&scr_history, v);
+}
+
+void Screen_SetWeather(const char *condition)
+{
+    GUI_Widget_SetText(&scr_weather, condition);
+}
+
+void Screen_SetOutdoorTemp(const char *temp)
+{
+    GUI_Widget_SetText(&scr_out_temp, temp);
+}
+
+void Screen_SetDateTime(const char *date, const char *time)
+{
+    GUI_Widget_SetText(&scr_date, date);
+    GUI_Widget_SetText(&scr_time, time);
+}
+
+/**
+ * @brief  只重画变化的控件并发送
+ */
+void Screen_Update(void)
+{
+    GUI_Widget_UpdateAll(scr_widgets, sizeof(scr_widgets) / sizeof(scr_widgets[0]));
+
+    // 温度、度数圆点、单位：第一次收到温度后才显示
+    if(scr_temp.text[0] != '\0')
+    {
+        if(GUI_Widget_Update(&scr_temp))
+            GUI_Widget_Invalidate(&scr_unit);
+        GUI_Widget_Update(&scr_degree);
+        GUI_Widget_Update(&scr_unit);
+    }
+
+    if(scr_history.count) GUI_Chart_Update(&scr_history);
+
+    Lcd_Flush();
+}
@@ -0,0 +1,47 @@
+# 构建时资源生成
+# assets/assets.txt 中列出的PNG/PPM图片和BDF字体由 tools/assets/asset_gen.py 转换为
+# ${CMAKE_BINARY_DIR}/generated/font_assets.c 和 font_assets.h（font.h包含后者）。
+# 用法：
+#   include(cmake/assets.cmake)
+#   weather_clock_assets(<目标> PRIVATE|PUBLIC)
+#   cmake --build <构建目录> --target assets      （只重新生成资源）
+# 选项：
+#   -DASSET_BIG_ENDIAN=ON   图片像素预先换成高字节在前，原始格式直接从Flash发送到LCD
+#   -DASSET_COMPRESS=OFF    忽略清单中的format=，所有图片按原始格式存放
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(ASSET_ROOT ${CMAKE_CURRENT_LIST_DIR}/..)
+option(ASSET_BIG_ENDIAN "Store image pixels high byte first" OFF)
+option(ASSET_COMPRESS "Use the per-image format from assets.txt (OFF stores every image raw)" ON)
+
+function(weather_clock_assets target scope)
+    set(out_dir ${CMAKE_BINARY_DIR}/generated)
+    set(outputs ${out_dir}/font_assets.c ${out_dir}/font_assets.h)
+
+    set(args)
+    if(ASSET_BIG_ENDIAN)
+        list(APPEND args --big-endian)
+    endif()
+    if(NOT ASSET_COMPRESS)
+        list(APPEND args --no-compress)
+    endif()
+
+    if(NOT TARGET assets)
+        file(GLOB_RECURSE asset_sources CONFIGURE_DEPENDS ${ASSET_ROOT}/assets/*)
+        add_custom_command(
+            OUTPUT ${outputs}
+            COMMAND ${Python3_EXECUTABLE} ${ASSET_ROOT}/tools/assets/asset_gen.py
+                    ${ASSET_ROOT}/assets/assets.txt -o ${out_dir} ${args}
+            DEPENDS ${asset_sources}
+                    ${ASSET_ROOT}/tools/assets/asset_gen.py
+                    ${ASSET_ROOT}/tools/assets/image_pack.py
+            COMMENT "Generating font and image assets"
+            VERBATIM
+        )
+        add_custom_target(assets DEPENDS ${outputs})
+    endif()
+
+    target_sources(${target} PRIVATE ${out_dir}/font_assets.c)
+    target_include_directories(${target} ${scope} ${out_dir})
+    add_dependencies(${target} assets)
+endfunction()
@@ -0,0 +1,430 @@
+#!/usr/bin/env python3
+"""
+asset_gen.py - 按资源清单把图片和字体转换为固件使用的C数组
+
+用法：
+    asset_gen.py assets/assets.txt -o build/generated [--big-endian] [--no-compress]
+
+生成 font_assets.c（数据）和 font_assets.h（extern声明、尺寸和字符数量），
+font.h 包含 font_assets.h，因此数组大小和 hz16_num 等常量总是和数据一致。
+
+清单每行一个资源（#开头为注释，路径相对清单所在目录）：
+    image  符号  源文件(.png/.ppm)  [format=auto|raw|indexed|rle] [bg=0xFFFF]
+    font   符号  源文件(.bdf)       layout=cells|flat|cjk|aa  size=宽x高  [range=首-尾] [bpp=2|4]
+
+字体布局（与GUI.c中的使用方式对应）：
+    cells  const unsigned char 符号[字符数][每字节数]，range内缺少的字符为空白（ascii_font）
+    flat   const unsigned char 符号[]，从range起点开始连续存放到最后一个有字形的字符，
+           额外生成 符号_num（sz32）
+    cjk    const FNT_Font_t 符号，码点升序的索引表 + 字形（FNT_FindGlyph二分查找），
+           只收录U+0080~U+FFFF，额外生成 符号_num；索引表和字形放在FNT_BLOB段（片内Flash的字库扇区）
+    aa     与cjk相同的FNT_Font_t，但包含range内的全部字符（含ASCII），每像素bpp位（2或4，默认2）
+           灰度，放在普通的只读数据中；源文件为灰度BDF（SIZE行第4个数为每像素位数）
+flat和cjk的数据放在 #if USE_ONCHIP_FLASH_FONT 中。
+
+TTF字体先用otf2bdf等工具按需要的字号栅格化为BDF再加入清单；aa字体用FontForge等工具导出灰度BDF。
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import image_pack  # noqa: E402
+
+
+class AssetError(Exception):
+    pass
+
+
+# ---------------------------------------------------------------- 图片读取
+
+def rgb_to_565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+def blend(c, a, bg):
+    return (c * a + bg * (255 - a) + 127) // 255
+
+
+def read_ppm(path, bg):
+    with open(path, 'rb') as f:
+        data = f.read()
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b'#':
+            pos = data.index(b'\n', pos) + 1
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[pos:end])
+        pos = end
+    magic, width, height, maxval = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+    if maxval > 255:
+        raise AssetError('%s: only 8-bit PPM is supported' % path)
+
+    if magic == b'P6':
+        raw = data[pos + 1:pos + 1 + width * height * 3]
+        values = list(raw)
+    elif magic == b'P3':
+        values = [int(v) for v in data[pos:].split()[:width * height * 3]]
+    else:
+        raise AssetError('%s: not a P3/P6 PPM' % path)
+    if len(values) < width * height * 3:
+        raise AssetError('%s: truncated pixel data' % path)
+    if maxval != 255:
+        values = [v * 255 // maxval for v in values]
+    return width, height, [rgb_to_565(*values[i:i + 3]) for i in range(0, width * height * 3, 3)]
+
+
+def png_unfilter(raw, width, height, bpp_bits):
+    stride = (width * bpp_bits + 7) // 8
+    step = max(1, bpp_bits // 8)
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - step] if i >= step else 0
+            b = prev[i]
+            c = prev[i - step] if i >= step else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+            elif ftype != 0:
+                raise AssetError('bad PNG filter %d' % ftype)
+        rows.append(line)
+        prev = line
+    return rows
+
+
+def read_png(path, bg):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise AssetError('%s: not a PNG file' % path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    trns = b''
+    while pos < len(data):
+        length, ctype = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if ctype == b'IHDR':
+            width, height, depth, color, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif ctype == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif ctype == b'tRNS':
+            trns = body
+        elif ctype == b'IDAT':
+            idat += body
+        elif ctype == b'IEND':
+            break
+
+    if interlace:
+        raise AssetError('%s: interlaced PNG is not supported' % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None or (depth != 8 and color != 3) or depth > 8:
+        raise AssetError('%s: unsupported PNG (colour type %d, depth %d)' % (path, color, depth))
+
+    rows = png_unfilter(zlib.decompress(idat), width, height, channels * depth)
+    bg_rgb = ((bg >> 11) << 3, ((bg >> 5) & 0x3F) << 2, (bg & 0x1F) << 3)
+    pixels = []
+    for line in rows:
+        for x in range(width):
+            if color == 3:
+                bit = x * depth
+                idx = (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+                r, g, b = palette[idx]
+                a = trns[idx] if idx < len(trns) else 255
+            else:
+                px = line[x * channels:(x + 1) * channels]
+                if color in (0, 4):
+                    r = g = b = px[0]
+                else:
+                    r, g, b = px[0], px[1], px[2]
+                a = px[-1] if color in (4, 6) else 255
+            if a != 255:
+                r, g, b = (blend(v, a, k) for v, k in zip((r, g, b), bg_rgb))
+            pixels.append(rgb_to_565(r, g, b))
+    return width, height, pixels
+
+
+def read_image(path, bg):
+    ext = os.path.splitext(path)[1].lower()
+    if ext == '.png':
+        return read_png(path, bg)
+    if ext in ('.ppm', '.pnm'):
+        return read_ppm(path, bg)
+    raise AssetError('%s: images must be .png or .ppm' % path)
+
+
+# ---------------------------------------------------------------- 字体读取
+
+def read_bdf(path, cell_w, cell_h, bpp=1):
+    """返回 {码点: 行优先、高位在前、每行按字节对齐的点阵}，字形按BDF基线放入 cell_w x cell_h 的格子
+
+    bpp为输出的每像素位数。灰度BDF（SIZE行第4个数为每像素位数2/4/8）按比例换算到bpp，
+    单色BDF输出bpp>1时点亮的像素取最大值。
+    """
+    glyphs = {}
+    ascent = None
+    font_bbx = None
+    src_bpp = 1
+    with open(path, encoding='utf-8', errors='replace') as f:
+        lines = iter(f.read().splitlines())
+
+    row_bytes = (cell_w * bpp + 7) // 8
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == 'SIZE' and len(words) > 4:
+            src_bpp = int(words[4])
+            if src_bpp not in (1, 2, 4, 8):
+                raise AssetError('%s: %d bits per pixel is not supported' % (path, src_bpp))
+        elif words[0] == 'FONT_ASCENT':
+            ascent = int(words[1])
+        elif words[0] == 'FONTBOUNDINGBOX':
+            font_bbx = [int(v) for v in words[1:5]]
+        elif words[0] == 'STARTCHAR':
+            code = None
+            bbx = None
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == 'ENCODING':
+                    code = int(words[1])
+                elif words[0] == 'BBX':
+                    bbx = [int(v) for v in words[1:5]]
+                elif words[0] == 'BITMAP':
+                    break
+            bitmap = []
+            for line in lines:
+                if line.strip() == 'ENDCHAR':
+                    break
+                bitmap.append(line.strip())
+            if code is None or code < 0 or bbx is None:
+                continue
+
+            if ascent is None:
+                ascent = (font_bbx[1] + font_bbx[3]) if font_bbx else cell_h
+            w, h, xoff, yoff = bbx
+            top = ascent - (yoff + h)
+            src_max, out_max = (1 << src_bpp) - 1, (1 << bpp) - 1
+            cell = bytearray(row_bytes * cell_h)
+            for r, hexrow in enumerate(bitmap[:h]):
+                bits = int(hexrow, 16) if hexrow else 0
+                nbits = len(hexrow) * 4
+                for c in range(w):
+                    v = (bits >> (nbits - (c + 1) * src_bpp)) & src_max
+                    v = (v * out_max + src_max // 2) // src_max
+                    if not v:
+                        continue
+                    x, y = xoff + c, top + r
+                    if not (0 <= x < cell_w and 0 <= y < cell_h):
+                        raise AssetError('%s: glyph U+%04X does not fit the %dx%d cell' % (path, code, cell_w, cell_h))
+                    cell[y * row_bytes + x * bpp // 8] |= v << (8 - bpp - x * bpp % 8)
+            glyphs[code] = bytes(cell)
+    return glyphs
+
+
+# ---------------------------------------------------------------- 输出
+
+def c_bytes(data, per_line, fmt='0x%02X'):
+    return [','.join(fmt % b for b in data[i:i + per_line]) for i in range(0, len(data), per_line)]
+
+
+def char_comment(code):
+    ch = chr(code)
+    return "'%s'" % ch if 0x20 < code < 0x7F else ('U+%04X' % code if code != 0x20 else "' '")
+
+
+class Output:
+    def __init__(self, manifest):
+        self.src = []
+        self.hdr = []
+        self.manifest = manifest
+
+    def image(self, name, path, opts, compress, big_endian):
+        bg = int(opts.get('bg', '0xFFFF'), 0)
+        fmt = opts.get('format', 'auto') if compress else 'raw'
+        width, height, pixels = read_image(path, bg)
+        data = image_pack.encode(width, height, pixels, fmt, big_endian)
+        kind = {image_pack.IMAGE_RAW: 'raw', image_pack.IMAGE_INDEXED: 'indexed',
+                image_pack.IMAGE_RLE: 'rle'}[data[7]]
+
+        self.src.append('/* %s: %dx%d %s */' % (os.path.basename(path), width, height, kind))
+        self.src.append(image_pack.format_array(name, data))
+        self.src.append('')
+        self.hdr.append('extern const unsigned char %s[%d];  /**< %dx%d %s */' % (name, len(data), width, height, kind))
+
+    def font(self, name, path, opts):
+        try:
+            cell_w, cell_h = (int(v) for v in opts['size'].lower().split('x'))
+            layout = opts['layout']
+        except (KeyError, ValueError):
+            raise AssetError('%s: font needs layout= and size=WxH' % name)
+        bpp = int(opts.get('bpp', '2' if layout == 'aa' else '1'))
+        if bpp not in ((2, 4) if layout == 'aa' else (1,)):
+            raise AssetError('%s: layout=%s does not support bpp=%d' % (name, layout, bpp))
+        glyphs = read_bdf(path, cell_w, cell_h, bpp)
+        nbytes = (cell_w * bpp + 7) // 8 * cell_h
+        blank = bytes(nbytes)
+        first, last = min(glyphs), max(glyphs)
+        if 'range' in opts:
+            first, last = (int(v, 0) for v in opts['range'].split('-'))
+
+        if layout == 'cells':
+            codes = range(first, last + 1)
+            self.src.append('/* %s: %dx%d, %s..%s */' % (os.path.basename(path), cell_w, cell_h,
+                                                          char_comment(first), char_comment(last)))
+            self.src.append('const unsigned char %s[%d][%d] = {' % (name, len(codes), nbytes))
+            for i, code in enumerate(codes):
+                self.src.append('    // 0x%02X %s' % (code, char_comment(code)))
+                self.src.append('    {%s}%s' % (','.join('0x%02X' % b for b in glyphs.get(code, blank)),
+                                                ',' if i + 1 < len(codes) else ''))
+            self.src.append('};')
+            self.hdr.append('extern const unsigned char %s[%d][%d];' % (name, len(codes), nbytes))
+
+        elif layout == 'flat':
+            present = [c for c in glyphs if first <= c <= last]
+            count = (max(present) - first + 1) if present else 0
+            self.src.append('/* %s: %dx%d */' % (os.path.basename(path), cell_w, cell_h))
+            self.src.append('const unsigned char %s[] = {' % name)
+            self.src.append('#if USE_ONCHIP_FLASH_FONT')
+            for code in range(first, first + count):
+                self.src.append('//"%s",' % chr(code))
+                self.src.extend(line + ',' for line in c_bytes(glyphs.get(code, blank), 32))
+            self.src.append('#else')
+            self.src.append('0x00')
+            self.src.append('#endif')
+            self.src.append('};')
+            self.hdr.append('extern const unsigned char %s[];' % name)
+            self.define(name + '_num', count, '从%s开始的字符数量' % char_comment(first))
+
+        elif layout == 'cjk':
+            codes = sorted(c for c in glyphs if first <= c <= last and 0x80 <= c <= 0xFFFF)
+            skipped = [c for c in glyphs if c > 0xFFFF]
+            if skipped:
+                print('asset_gen: %s: %d glyphs outside the BMP skipped' % (name, len(skipped)), file=sys.stderr)
+            self.coded_font(name, path, cell_w, cell_h, bpp, codes, glyphs, 'FNT_BLOB', True)
+
+        elif layout == 'aa':
+            codes = sorted(c for c in glyphs if first <= c <= last and c <= 0xFFFF)
+            self.coded_font(name, path, cell_w, cell_h, bpp, codes, glyphs, '', False)
+
+        else:
+            raise AssetError('%s: unknown font layout %s' % (name, layout))
+        self.src.append('')
+
+    def coded_font(self, name, path, cell_w, cell_h, bpp, codes, glyphs, section, onchip_only):
+        """FNT_Font_t：码点升序的索引表 + 字形，onchip_only时数据放在 #if USE_ONCHIP_FLASH_FONT 中"""
+        if len(codes) > 0xFFFF:
+            raise AssetError('%s: more than 65535 glyphs' % name)
+        nbytes = (cell_w * bpp + 7) // 8 * cell_h
+        attr = ' ' + section if section else ''
+
+        # 码点表和字形分开存放；关闭片内字库时只剩一个不计入count的占位元素
+        self.src.append('/* %s: %dx%d, 每像素%d位, %d个字符 */' % (os.path.basename(path), cell_w, cell_h, bpp, len(codes)))
+        self.src.append('static const uint16_t %s_codes[]%s = {' % (name, attr))
+        if onchip_only:
+            self.src.append('#if USE_ONCHIP_FLASH_FONT')
+        self.src.extend(line + ',' for line in c_bytes(codes, 8, '0x%04X'))
+        if onchip_only:
+            self.src.append('#endif')
+        self.src.append('0xFFFF')
+        self.src.append('};')
+        self.src.append('static const uint8_t %s_bitmaps[]%s = {' % (name, attr))
+        if onchip_only:
+            self.src.append('#if USE_ONCHIP_FLASH_FONT')
+        for code in codes:
+            self.src.append('/* U+%04X %s */ %s,' % (code, chr(code) if code > 0x20 else ' ',
+                                                      ','.join('0x%02X' % b for b in glyphs[code])))
+        if onchip_only:
+            self.src.append('#endif')
+        self.src.append('0x00')
+        self.src.append('};')
+        self.src.append('const FNT_Font_t %s = { %d, %d, %d, %d, %s_num, %s_codes, %s_bitmaps };'
+                        % (name, cell_w, cell_h, bpp, nbytes, name, name, name))
+        self.hdr.append('extern const FNT_Font_t %s;' % name)
+        if onchip_only:
+            self.hdr.append('#if USE_ONCHIP_FLASH_FONT')
+            self.define(name + '_num', len(codes), '字符数量')
+            self.hdr.append('#else')
+            self.define(name + '_num', 0, '不使用片内字库')
+            self.hdr.append('#endif')
+        else:
+            self.define(name + '_num', len(codes), '字符数量')
+
+    def define(self, name, value, comment):
+        self.hdr.append('#define %-16s %-4d /* %s */' % (name, value, comment))
+
+    def write(self, outdir):
+        banner = ['/* 由 tools/assets/asset_gen.py 根据 %s 生成，不要手工修改 */' % self.manifest, '']
+        src = banner + ['#include "font.h"', ''] + self.src
+        hdr = banner + ['#ifndef __FONT_ASSETS_H', '#define __FONT_ASSETS_H', ''] + self.hdr + \
+              ['', '#endif /* __FONT_ASSETS_H */', '']
+        os.makedirs(outdir, exist_ok=True)
+        for fname, lines in (('font_assets.c', src), ('font_assets.h', hdr)):
+            with open(os.path.join(outdir, fname), 'w', encoding='utf-8') as f:
+                f.write('\n'.join(lines))
+
+
+def parse_manifest(path):
+    entries = []
+    with open(path, encoding='utf-8') as f:
+        for lineno, line in enumerate(f, 1):
+            words = line.split('#', 1)[0].split()
+            if not words:
+                continue
+            if len(words) < 3 or words[0] not in ('image', 'font'):
+                raise AssetError('%s:%d: expected "image|font NAME FILE [key=value...]"' % (path, lineno))
+            opts = dict(w.split('=', 1) for w in words[3:])
+            entries.append((words[0], words[1], os.path.join(os.path.dirname(path), words[2]), opts))
+    return entries
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Generate font_assets.c/.h from the asset manifest')
+    ap.add_argument('manifest')
+    ap.add_argument('-o', '--outdir', required=True)
+    ap.add_argument('--big-endian', action='store_true', help='store image pixels high byte first')
+    ap.add_argument('--no-compress', action='store_true', help='store every image raw')
+    args = ap.parse_args(argv)
+
+    try:
+        entries = parse_manifest(args.manifest)
+        out = Output(os.path.basename(args.manifest))
+        for kind, name, path, opts in entries:
+            if kind == 'image':
+                out.image(name, path, opts, not args.no_compress, args.big_endian)
+            else:
+                out.font(name, path, opts)
+        out.write(args.outdir)
+    except (AssetError, OSError) as e:
+        sys.exit('asset_gen: %s' % e)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
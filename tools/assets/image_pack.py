@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+image_pack.py - 把Image2Lcd生成的原始RGB565图片数组转换为Gui_DrawImage支持的压缩格式
+
+用法：
+    image_pack.py font.c gImage_humo_nei gImage_temp_nei      # 打印转换后的数组
+    image_pack.py -f rle font.c gImage_1                      # 指定格式
+    image_pack.py -l font.c                                   # 列出每个图片各格式的大小
+    image_pack.py -b font.c gImage_1                          # 像素预先换成高字节在前
+
+格式（图片头第8字节，见LCD/Inc/GUI.h中的GUI_IMAGE_*）：
+    raw      0x1B  原始RGB565小端
+    indexed  0x50  调色板 + 1/2/4/8位索引，每行按字节对齐
+    rle      0x52  行程编码，颜色不超过256种时带调色板（8位索引），否则为RGB565
+    auto           取最小的一种（默认）
+
+图片头第0字节bit4（Image2Lcd的"WORD高低字节与PC相反"）置1时，像素和调色板为高字节在前，
+原始格式可以不经转换直接发送到LCD。
+"""
+
+import argparse
+import re
+import sys
+
+IMAGE_RAW = 0x1B
+IMAGE_INDEXED = 0x50
+IMAGE_RLE = 0x52
+IMAGE_BIG_ENDIAN = 0x10    # 图片头第0字节
+
+RLE_MAX = 128       # 一个包最多的像素数
+RLE_MIN_RUN = 3     # 重复次数达到这个值才单独成为重复包
+
+
+def parse_arrays(text):
+    """从C源码中找出所有 const unsigned char 名字[] = {...}; 返回 {名字: bytes}"""
+    arrays = {}
+    pattern = re.compile(r'const\s+unsigned\s+char\s+(\w+)\s*\[\s*\d*\s*\]\s*=\s*\{(.*?)\};', re.S)
+    for m in pattern.finditer(text):
+        body = re.sub(r'/\*.*?\*/|//[^\n]*', '', m.group(2), flags=re.S)
+        arrays[m.group(1)] = bytes(int(v, 0) for v in re.findall(r'0[xX][0-9A-Fa-f]+|\d+', body))
+    return arrays
+
+
+def decode_header(data):
+    """返回 (宽, 高, 像素列表)，只接受原始格式"""
+    if len(data) < 8:
+        raise ValueError('image shorter than its 8-byte header')
+    if data[7] != IMAGE_RAW:
+        raise ValueError('already packed (format byte 0x%02X)' % data[7])
+    width = data[2] | (data[3] << 8)
+    height = data[4] | (data[5] << 8)
+    need = 8 + width * height * 2
+    if len(data) < need:
+        raise ValueError('%dx%d image needs %d bytes, array has %d' % (width, height, need, len(data)))
+    hi, lo = (8, 9) if data[0] & IMAGE_BIG_ENDIAN else (9, 8)
+    pixels = [data[lo + 2 * i] | (data[hi + 2 * i] << 8) for i in range(width * height)]
+    return width, height, pixels
+
+
+def header(width, height, depth, fmt, big_endian):
+    scan = IMAGE_BIG_ENDIAN if big_endian else 0x00
+    return bytes([scan, depth, width & 0xFF, width >> 8, height & 0xFF, height >> 8, 0x01, fmt])
+
+
+def color_bytes(c, big_endian):
+    return bytes([c >> 8, c & 0xFF]) if big_endian else bytes([c & 0xFF, c >> 8])
+
+
+def palette_of(pixels):
+    """按出现顺序排列的调色板（超过256色返回None）"""
+    palette = list(dict.fromkeys(pixels))
+    return palette if len(palette) <= 256 else None
+
+
+def palette_bytes(palette, big_endian):
+    out = bytearray([len(palette) - 1])
+    for c in palette:
+        out += color_bytes(c, big_endian)
+    return bytes(out)
+
+
+def encode_raw(width, height, pixels, big_endian=False):
+    out = bytearray(header(width, height, 16, IMAGE_RAW, big_endian))
+    for c in pixels:
+        out += color_bytes(c, big_endian)
+    return bytes(out)
+
+
+def encode_indexed(width, height, pixels, big_endian=False):
+    palette = palette_of(pixels)
+    if palette is None:
+        return None
+    bpp = next(b for b in (1, 2, 4, 8) if len(palette) <= (1 << b))
+    index = {c: i for i, c in enumerate(palette)}
+
+    out = bytearray(header(width, height, bpp, IMAGE_INDEXED, big_endian))
+    out += palette_bytes(palette, big_endian)
+    for y in range(height):
+        row = bytearray((width * bpp + 7) // 8)
+        for x in range(width):
+            bit = x * bpp
+            row[bit // 8] |= index[pixels[y * width + x]] << (8 - bpp - bit % 8)
+        out += row
+    return bytes(out)
+
+
+def rle_packets(units):
+    """units为每个像素编码后的字节串，返回包序列"""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX]
+            del literal[:RLE_MAX]
+            out.append(len(chunk) - 1)
+            for u in chunk:
+                out.extend(u)
+
+    i = 0
+    while i < len(units):
+        run = 1
+        while i + run < len(units) and run < RLE_MAX and units[i + run] == units[i]:
+            run += 1
+        if run >= RLE_MIN_RUN:
+            flush_literal()
+            out.append(0x7F + run)
+            out.extend(units[i])
+        else:
+            literal.extend(units[i:i + run])
+        i += run
+    flush_literal()
+    return bytes(out)
+
+
+def encode_rle(width, height, pixels, big_endian=False):
+    palette = palette_of(pixels)
+    if palette is None:
+        out = bytearray(header(width, height, 16, IMAGE_RLE, big_endian))
+        out += rle_packets([color_bytes(c, big_endian) for c in pixels])
+    else:
+        index = {c: i for i, c in enumerate(palette)}
+        out = bytearray(header(width, height, 8, IMAGE_RLE, big_endian))
+        out += palette_bytes(palette, big_endian)
+        out += rle_packets([bytes([index[c]]) for c in pixels])
+    return bytes(out)
+
+
+ENCODERS = {
+    'raw': encode_raw,
+    'indexed': encode_indexed,
+    'rle': encode_rle,
+}
+
+
+def encode(width, height, pixels, fmt, big_endian=False):
+    if fmt != 'auto':
+        data = ENCODERS[fmt](width, height, pixels, big_endian)
+        if data is None:
+            raise ValueError('%s needs at most 256 colours' % fmt)
+        return data
+    candidates = [e(width, height, pixels, big_endian) for e in ENCODERS.values()]
+    return min((c for c in candidates if c is not None), key=len)
+
+
+def format_array(name, data, comment=''):
+    lines = ['const unsigned char %s[%d] = { %s' % (name, len(data), ','.join('0X%02X' % b for b in data[:8]) + ',')]
+    for i in range(8, len(data), 16):
+        lines.append(','.join('0X%02X' % b for b in data[i:i + 16]) + ',')
+    lines[-1] = lines[-1].rstrip(',')
+    lines.append('};' + ('  /* %s */' % comment if comment else ''))
+    return '\n'.join(lines)
+
+
+def main(argv):
+    ap = argparse.ArgumentParser(description='Pack Image2Lcd RGB565 arrays for Gui_DrawImage')
+    ap.add_argument('source', help='C file containing the raw gImage_* arrays')
+    ap.add_argument('names', nargs='*', help='arrays to convert (default: all raw images)')
+    ap.add_argument('-f', '--format', choices=['auto'] + list(ENCODERS), default='auto')
+    ap.add_argument('-b', '--big-endian', action='store_true', help='store pixels high byte first')
+    ap.add_argument('-l', '--list', action='store_true', help='only list the size of every format')
+    args = ap.parse_args(argv)
+
+    with open(args.source, encoding='utf-8', errors='replace') as f:
+        arrays = parse_arrays(f.read())
+
+    names = args.names or [n for n, d in arrays.items() if len(d) >= 8 and d[7] == IMAGE_RAW and d[1] == 16]
+    for name in names:
+        if name not in arrays:
+            sys.exit('%s: no array named %s' % (args.source, name))
+        width, height, pixels = decode_header(arrays[name])
+
+        if args.list:
+            sizes = []
+            for fmt, enc in ENCODERS.items():
+                data = enc(width, height, pixels)
+                sizes.append('%s=%s' % (fmt, len(data) if data else '-'))
+            print('%-20s %3dx%-3d %s' % (name, width, height, ' '.join(sizes)))
+            continue
+
+        data = encode(width, height, pixels, args.format, args.big_endian)
+        kind = {IMAGE_RAW: 'raw', IMAGE_INDEXED: 'indexed', IMAGE_RLE: 'rle'}[data[7]]
+        print(format_array(name, data, '%dx%d %s, raw %d bytes' % (width, height, kind, len(arrays[name]))))
+        print()
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:])
@@ -0,0 +1,563 @@
+/**
+ ******************************************************************************
+ * @file           : bench.c
+ * @brief          : GUI/驱动接口的SPI开销基准
+ *                   逐个调用 GUI.h、GUI_Widget.h、GUI_Clock.h、GUI_Chart.h 和 lcd_Driver.h 的公开函数，用ST7735模型统计
+ *                   总线上的事务数、CS翻转、字节数，并按给定SPI时钟估算线上时间
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 用法：lcd_bench [-c 时钟1,时钟2,...] [-t 阈值文件] [-g 输出阈值文件]
+ *
+ * 输出为制表符分隔的表格（第一行为表头），每个用例一行。
+ * 每个用例之前先清屏并Flush（不计入统计），窗口缓存/显示缓冲处于相同的起始状态。
+ *
+ * 阈值文件每行：用例名  最大字节数  最大CS翻转数（#开头为注释），
+ * 任一用例超过阈值时返回1；没有阈值的用例只输出不检查。
+ * -g 按本次测得的值加余量写出新的阈值文件（见Bench_Limit），开销变化是有意的时用它更新阈值。
+ * lcd_Driver.h 中只有声明没有实现的函数（Lcd_ReadReg、LCD_DisplayOn 等）不在表中。
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "st7735_sim.h"
+#include "lcd_Driver.h"
+#include "lcd_Pipe.h"
+#include "GUI.h"
+#include "GUI_Widget.h"
+#include "GUI_Clock.h"
+#include "GUI_Chart.h"
+#include "font.h"
+
+#define BENCH_CLOCKS_MAX    8
+#define BENCH_TIME_LINE     "11:20:01"
+
+typedef struct
+{
+    const char *name;
+    void (*setup)(void);    // NULL=清屏
+    void (*run)(void);
+} Bench_Case_t;
+
+typedef struct
+{
+    uint32_t bytes;
+    uint32_t cs;
+} Bench_Result_t;
+
+static uint16_t bench_bitmap[16 * 16];
+static GUI_Widget_t bench_label;
+static GUI_Clock_t bench_clock;
+static GUI_Chart_t bench_chart;
+
+/*---------------------------------------------------用例----------------------------------------------------*/
+
+static void Bench_NoSetup(void) { }
+
+static void Bench_Clear(void)
+{
+    Lcd_Clear(WHITE);
+    Lcd_Flush();
+}
+
+// 时间行已经显示了上一秒
+static void Bench_TimeLine(void)
+{
+    Bench_Clear();
+    Gui_DrawAsciiString(20, 110, BLACK, WHITE, BENCH_TIME_LINE);
+    Lcd_Flush();
+}
+
+// 标签已经显示了文字text
+static void Bench_Label(const char *text)
+{
+    Bench_Clear();
+    GUI_Label_Init(&bench_label, 20, 110, 8, GUI_FONT_ASCII16, BLACK, WHITE);
+    GUI_Widget_SetText(&bench_label, text);
+    GUI_Widget_Update(&bench_label);
+    Lcd_Flush();
+}
+
+// 先画一次，字形进入缓存
+static void Bench_Text16Warm(void)
+{
+    Bench_Clear();
+    Gui_DrawText16(10, 10, BLACK, WHITE, "孙");
+    Lcd_Flush();
+}
+
+static void Bench_LabelTime(void)   { Bench_Label(BENCH_TIME_LINE); }
+static void Bench_LabelNarrow(void) { Bench_Label("9%"); }
+static void Bench_LabelWide(void)   { Bench_Label("10%"); }
+
+// 时钟已经显示了给定时间
+static void Bench_Clock(uint8_t h, uint8_t m, uint8_t s, uint16_t ms)
+{
+    Bench_Clear();
+    GUI_Clock_Init(&bench_clock, 64, 80, 40);
+    GUI_Clock_SetTime(&bench_clock, h, m, s, ms);
+    GUI_Clock_Update(&bench_clock);
+    Lcd_Flush();
+}
+
+static void Bench_ClockNew(void)    { Bench_Clear(); GUI_Clock_Init(&bench_clock, 64, 80, 40); }
+static void Bench_ClockSecond(void) { Bench_Clock(10, 10, 30, 0); }
+static void Bench_ClockMinute(void) { Bench_Clock(10, 10, 59, 0); }
+
+// 128x32的温湿度曲线已经显示了60个采样（湿度40~49%，温度20~24度）
+static void Bench_Chart(void)
+{
+    int16_t v[2];
+    int i;
+
+    Bench_Clear();
+    GUI_Chart_Init(&bench_chart, 0, 128, X_MAX_PIXEL, 32, WHITE);
+    GUI_Chart_AddSeries(&bench_chart, BLUE, GRAY0, 10);
+    GUI_Chart_AddSeries(&bench_chart, RED, WHITE, 5);
+    for(i = 0; i < 60; i++)
+    {
+        v[0] = (int16_t)(40 + i % 10);
+        v[1] = (int16_t)(20 + i % 5);
+        GUI_Chart_Push(&bench_chart, v);
+    }
+    GUI_Chart_Update(&bench_chart);
+    Lcd_Flush();
+}
+
+// 第112~127行为16行的滚动区（天气预报/状态滚动条）
+#define BENCH_TICKER_Y  112
+#define BENCH_TICKER_H  16
+
+static void Bench_Ticker(void)
+{
+    Bench_Clear();
+    Lcd_ScrollArea(BENCH_TICKER_Y, BENCH_TICKER_H);
+}
+
+// 滚动条已经上移了5行，回绕点在滚动区中间
+static void Bench_TickerScrolled(void)
+{
+    Bench_Ticker();
+    Lcd_Scroll(5);
+}
+
+static void Run_Init(void)          { Lcd_Init(); }
+static void Run_Reset(void)         { Lcd_Reset(); }
+static void Run_WriteIndex(void)    { Lcd_WriteIndex(0x00); }      // NOP
+static void Run_WriteData(void)     { Lcd_WriteIndex(0x00); Lcd_WriteData(0x00); }
+static void Run_WriteReg(void)      { Lcd_WriteReg(0x36, 0xC8); }
+static void Run_WriteData16(void)   { Lcd_WriteIndex(0x00); LCD_WriteData_16Bit(WHITE); }
+static void Run_SetXY(void)         { Lcd_SetXY(10, 10); }
+static void Run_SetRegion(void)     { Lcd_SetRegion(0, 0, X_MAX_PIXEL - 1, Y_MAX_PIXEL - 1); }
+static void Run_ReadPoint(void)     { (void)Lcd_ReadPoint(10, 10); }
+static void Run_Clear(void)         { Lcd_Clear(BLACK); }
+static void Run_DrawPoint(void)     { Gui_DrawPoint(10, 10, RED); }
+static void Run_FillRect(void)      { Lcd_FillRect(10, 10, 50, 20, BLUE); }
+static void Run_HLine(void)         { Lcd_DrawHLine(0, 80, X_MAX_PIXEL, RED); }
+static void Run_VLine(void)         { Lcd_DrawVLine(64, 0, Y_MAX_PIXEL, RED); }
+static void Run_PushRect(void)      { Lcd_PushRect(10, 10, 16, 16, bench_bitmap, 16); }
+static void Run_Flush(void)         { Lcd_Flush(); }
+static void Run_BacklightOff(void)  { LCD_BacklightOff(); }
+static void Run_BacklightOn(void)   { LCD_BacklightOn(); }
+
+static void Run_Window(void)
+{
+    Lcd_BeginWindow(10, 10, 25, 25);
+    Lcd_WritePixel(RED);
+    Lcd_WritePixels(bench_bitmap, 16 * 16 - 1 - 64);
+    Lcd_FillPixels(GREEN, 64);
+    Lcd_EndWindow();
+}
+
+static void Run_Pipe(void)
+{
+    uint16_t *buf;
+
+    Lcd_BeginWindow(10, 10, 25, 25);
+    buf = Lcd_AcquirePixels();
+    memcpy(buf, bench_bitmap, sizeof(bench_bitmap));
+    Lcd_CommitPixels(buf, 16 * 16);
+    Lcd_EndWindow();
+}
+
+static void Run_BGR2RGB(void)       { (void)LCD_BGR2RGB(0x1234); }
+static void Run_Circle(void)        { Gui_Circle(64, 80, 30, RED); }
+static void Run_CircleEdge(void)    { Gui_Circle(5, 80, 20, RED); }
+static void Run_FillCircle(void)    { Gui_FillCircle(64, 80, 30, RED); }
+static void Run_RoundRect(void)     { Gui_FillRoundRect(14, 60, 100, 40, 8, BLUE); }
+static void Run_Arc(void)           { Gui_Arc(64, 80, 30, 6, 225, 270, GREEN); }
+static void Run_Gauge(void)         { Gui_Gauge(64, 80, 30, 6, 225, 270, 62, 100, BLUE, GRAY2); }
+
+// 对比用：同样的像素逐点画（外接矩形内逐个判断，Gui_DrawPoint输出）
+static uint8_t Ref_InRing(int dx, int dy, int R, int t, int start, int sweep)
+{
+    int32_t d2 = dx * dx + dy * dy, ri = (t > R) ? 0 : R + 1 - t;
+    int32_t c0 = Gui_SinQ15(start) * dy + Gui_CosQ15(start) * dx;                   // 与起始方向的叉积
+    int32_t c1 = Gui_SinQ15(start + sweep) * dy + Gui_CosQ15(start + sweep) * dx;
+    uint8_t s0 = c0 > 0 || (c0 == 0 && Gui_SinQ15(start) * dx - Gui_CosQ15(start) * dy > 0);
+    uint8_t s1 = c1 > 0 || (c1 == 0 && Gui_SinQ15(start + sweep) * dx - Gui_CosQ15(start + sweep) * dy > 0);
+
+    if(d2 > R * R + R || (ri > 0 && d2 <= ri * ri - ri)) return 0;
+    if(sweep >= 360) return 1;
+    return (sweep <= 180) ? (s0 && !s1) : (s0 || !s1);
+}
+
+static void Ref_PlotRing(int X, int Y, int R, int t, int start, int sweep, uint16_t color)
+{
+    int x, y;
+
+    for(y = Y - R; y <= Y + R; y++)
+        for(x = X - R; x <= X + R; x++)
+            if(Ref_InRing(x - X, y - Y, R, t, start, sweep)) Gui_DrawPoint(x, y, color);
+}
+
+static void Run_FillCirclePx(void)  { Ref_PlotRing(64, 80, 30, 31, 0, 360, RED); }
+static void Run_ArcPx(void)         { Ref_PlotRing(64, 80, 30, 6, 225, 270, GREEN); }
+static void Run_RoundRectPx(void)
+{
+    int x, y, cx, cy;
+
+    for(y = 60; y < 100; y++)
+        for(x = 14; x < 114; x++)
+        {
+            cx = (x < 22) ? 22 : (x > 105) ? 105 : x;
+            cy = (y < 68) ? 68 : (y > 91) ? 91 : y;
+            if((x - cx) * (x - cx) + (y - cy) * (y - cy) <= 8 * 8 + 8) Gui_DrawPoint(x, y, BLUE);
+        }
+}
+
+static void Run_Line(void)          { Gui_DrawLine(0, 0, X_MAX_PIXEL - 1, Y_MAX_PIXEL - 1, BLUE); }
+static void Run_Box(void)           { Gui_box(10, 10, 60, 30, GRAY1); }
+static void Run_Box2(void)          { Gui_box2(10, 10, 60, 30, 0); }
+static void Run_ButtonDown(void)    { DisplayButtonDown(10, 10, 70, 40); }
+static void Run_ButtonUp(void)      { DisplayButtonUp(10, 10, 70, 40); }
+
+static void Run_Text16(void)        { Gui_DrawText16(10, 10, BLACK, WHITE, "孙"); }
+static void Run_Text24(void)        { Gui_DrawText24(10, 10, BLACK, WHITE, "霖"); }
+
+static void Run_Bitmap(void)        { Gui_DrawBitmap(10, 10, 16, 16, bench_bitmap); }
+static void Run_Icon(void)          { Gui_DrawIcon(10, 10, 16, bench_bitmap); }
+static void Run_Image(void)         { Gui_DrawImage(90, 40, gImage_1); }
+static void Run_ImageRle(void)      { Gui_DrawImage(1, 50, gImage_humo_nei); }
+static void Run_ImageClipped(void)
+{
+    Gui_PushClip(0, 0, X_MAX_PIXEL, 60);    // 40x41的图片只剩右边38列、上面20行
+    Gui_DrawImage(90, 40, gImage_1);
+    Gui_PopClip();
+}
+static void Run_ImageIndexed(void)  { Gui_DrawImage(50, 50, gImage_temp_nei); }
+static void Run_AsciiChar(void)     { Gui_DrawAsciiChar(10, 10, BLACK, WHITE, 'A'); }
+static void Run_TimeString(void)    { Gui_DrawAsciiString(20, 110, BLACK, WHITE, BENCH_TIME_LINE); }
+static void Run_TimeTick(void)      { Gui_DrawAsciiString(20, 110, BLACK, WHITE, "11:20:02"); }
+static void Run_TimeOverlay(void)   { Gui_DrawAsciiString(20, 110, BLACK, BLACK, BENCH_TIME_LINE); }
+static void Run_TimeEdge(void)      { Gui_DrawAsciiString(100, 110, BLACK, WHITE, BENCH_TIME_LINE); }   // 3个半字可见
+static void Run_StringCenter(void)  { Gui_DrawAsciiStringCenter(0, 110, X_MAX_PIXEL, BLACK, WHITE, BENCH_TIME_LINE); }
+static void Run_LabelText(const char *text)
+{
+    GUI_Widget_SetText(&bench_label, text);
+    GUI_Widget_Update(&bench_label);
+}
+
+static void Run_LabelTick(void)     { Run_LabelText("11:20:02"); }
+static void Run_LabelSame(void)     { Run_LabelText(BENCH_TIME_LINE); }
+static void Run_LabelGrow(void)     { Run_LabelText("10%"); }
+static void Run_LabelShrink(void)   { Run_LabelText("9%"); }
+
+static void Run_ClockTime(uint8_t h, uint8_t m, uint8_t s, uint16_t ms)
+{
+    GUI_Clock_SetTime(&bench_clock, h, m, s, ms);
+    GUI_Clock_Update(&bench_clock);
+}
+
+static void Run_ClockFull(void)     { Run_ClockTime(10, 10, 30, 0); }
+static void Run_ClockStep(void)     { Run_ClockTime(10, 10, 30, 167); }    // 秒针走1°
+static void Run_ClockSecond(void)   { Run_ClockTime(10, 10, 31, 0); }
+static void Run_ClockMinute(void)   { Run_ClockTime(10, 11, 0, 0); }
+static void Run_ClockSame(void)     { Run_ClockTime(10, 10, 30, 0); }
+
+static void Run_ChartValue(int16_t humidity, int16_t temperature)
+{
+    int16_t v[2];
+
+    v[0] = humidity;
+    v[1] = temperature;
+    GUI_Chart_Push(&bench_chart, v);
+    GUI_Chart_Update(&bench_chart);
+}
+
+static void Run_ChartSample(void)   { Run_ChartValue(45, 22); }
+static void Run_ChartRescale(void)  { Run_ChartValue(55, 22); }   // 湿度超出40~50，纵轴变化
+static void Run_ChartSame(void)     { GUI_Chart_Update(&bench_chart); }
+
+static void Run_ScrollArea(void)    { Lcd_ScrollArea(BENCH_TICKER_Y, BENCH_TICKER_H); }
+static void Run_ScrollSame(void)    { Lcd_ScrollTo(Lcd_ScrollOffset()); }
+static void Run_ScrollOff(void)     { Lcd_ScrollArea(0, 0); }
+static void Run_TickerLine(void)
+{
+    Lcd_Scroll(1);                                                      // 内容上移一行
+    Lcd_FillRect(0, BENCH_TICKER_Y + BENCH_TICKER_H - 1, X_MAX_PIXEL, 1, BLUE);     // 只画新露出的一行
+}
+static void Run_TickerRedraw(void)  { Lcd_FillRect(0, BENCH_TICKER_Y, X_MAX_PIXEL, BENCH_TICKER_H, BLUE); }   // 不用硬件滚动时整条重画
+static void Run_ScrolledRect(void)  { Lcd_FillRect(0, 100, X_MAX_PIXEL, 40, RED); }   // 跨过滚动区上下边界和回绕点，分3段
+
+static void Run_TextAA4(void)       { Gui_DrawTextFont(20, 110, BLACK, WHITE, &ascii_aa, BENCH_TIME_LINE); }
+static void Run_TextAA2(void)       { Gui_DrawTextFont(10, 10, BLACK, WHITE, &num32_aa, "8"); }
+
+static void Run_Num32(void)         { Gui_DrawFont_Num32(10, 10, BLACK, WHITE, sz32_num - 1); }
+
+static const Bench_Case_t bench_cases[] =
+{
+    // lcd_Driver.h
+    { "Lcd_Init",                   Bench_NoSetup,  Run_Init },
+    { "Lcd_WriteIndex",             NULL,           Run_WriteIndex },
+    { "Lcd_WriteData",              NULL,           Run_WriteData },
+    { "Lcd_WriteReg",               NULL,           Run_WriteReg },
+    { "LCD_WriteData_16Bit",        NULL,           Run_WriteData16 },
+    { "Lcd_SetXY",                  NULL,           Run_SetXY },
+    { "Lcd_SetRegion",              NULL,           Run_SetRegion },
+    { "Lcd_ReadPoint",              NULL,           Run_ReadPoint },
+    { "Lcd_Clear",                  NULL,           Run_Clear },
+    { "Gui_DrawPoint",              NULL,           Run_DrawPoint },
+    { "Lcd_FillRect_50x20",         NULL,           Run_FillRect },
+    { "Lcd_DrawHLine",              NULL,           Run_HLine },
+    { "Lcd_DrawVLine",              NULL,           Run_VLine },
+    { "Lcd_Window_16x16",           NULL,           Run_Window },
+    { "Lcd_CommitPixels_16x16",     NULL,           Run_Pipe },
+    { "Lcd_PushRect_16x16",         NULL,           Run_PushRect },
+    { "Lcd_Flush_idle",             NULL,           Run_Flush },
+    { "LCD_BacklightOff",           NULL,           Run_BacklightOff },
+    { "LCD_BacklightOn",            Bench_NoSetup,  Run_BacklightOn },
+    // GUI.h
+    { "LCD_BGR2RGB",                NULL,           Run_BGR2RGB },
+    { "Gui_Circle_r30",             NULL,           Run_Circle },
+    { "Gui_Circle_edge",            NULL,           Run_CircleEdge },
+    { "Gui_FillCircle_r30",         NULL,           Run_FillCircle },
+    { "Gui_FillCircle_r30_pixels",  NULL,           Run_FillCirclePx },
+    { "Gui_FillRoundRect_100x40",   NULL,           Run_RoundRect },
+    { "Gui_FillRoundRect_pixels",   NULL,           Run_RoundRectPx },
+    { "Gui_Arc_r30_t6_270",         NULL,           Run_Arc },
+    { "Gui_Arc_r30_t6_270_pixels",  NULL,           Run_ArcPx },
+    { "Gui_Gauge_r30_62pct",        NULL,           Run_Gauge },
+    { "Gui_DrawLine_diag",          NULL,           Run_Line },
+    { "Gui_box_60x30",              NULL,           Run_Box },
+    { "Gui_box2_60x30",             NULL,           Run_Box2 },
+    { "DisplayButtonDown",          NULL,           Run_ButtonDown },
+    { "DisplayButtonUp",            NULL,           Run_ButtonUp },
+    { "Gui_DrawText16",             NULL,           Run_Text16 },
+    { "Gui_DrawText16_cached",      Bench_Text16Warm, Run_Text16 },
+    { "Gui_DrawText24",             NULL,           Run_Text24 },
+    { "Gui_DrawBitmap_16x16",       NULL,           Run_Bitmap },
+    { "Gui_DrawIcon_16",            NULL,           Run_Icon },
+    { "Gui_DrawImage_gImage_1",     NULL,           Run_Image },
+    { "Gui_DrawImage_rle",          NULL,           Run_ImageRle },
+    { "Gui_DrawImage_indexed",      NULL,           Run_ImageIndexed },
+    { "Gui_DrawImage_clipped",      NULL,           Run_ImageClipped },
+    { "Gui_DrawAsciiChar",          NULL,           Run_AsciiChar },
+    { "Gui_DrawAsciiString_time",   NULL,           Run_TimeString },
+    { "Gui_DrawAsciiString_tick",   Bench_TimeLine, Run_TimeTick },
+    { "Gui_DrawAsciiString_overlay", NULL,          Run_TimeOverlay },
+    { "Gui_DrawAsciiString_edge",   NULL,           Run_TimeEdge },
+    { "Gui_DrawAsciiStringCenter",  NULL,           Run_StringCenter },
+    { "Gui_DrawFont_Num32",         NULL,           Run_Num32 },
+    { "Gui_DrawTextFont_aa4_time",  NULL,           Run_TextAA4 },
+    { "Gui_DrawTextFont_aa2_num32", NULL,           Run_TextAA2 },
+    // GUI_Widget.h
+    { "GUI_Label_tick",             Bench_LabelTime,   Run_LabelTick },
+    { "GUI_Label_same",             Bench_LabelTime,   Run_LabelSame },
+    { "GUI_Label_grow",             Bench_LabelNarrow, Run_LabelGrow },
+    { "GUI_Label_shrink",           Bench_LabelWide,   Run_LabelShrink },
+    // GUI_Clock.h
+    { "GUI_Clock_full_r40",         Bench_ClockNew,    Run_ClockFull },
+    { "GUI_Clock_second_1deg",      Bench_ClockSecond, Run_ClockStep },
+    { "GUI_Clock_second_tick",      Bench_ClockSecond, Run_ClockSecond },
+    { "GUI_Clock_minute_tick",      Bench_ClockMinute, Run_ClockMinute },
+    { "GUI_Clock_same",             Bench_ClockSecond, Run_ClockSame },
+    // GUI_Chart.h
+    { "GUI_Chart_sample",           Bench_Chart,       Run_ChartSample },
+    { "GUI_Chart_rescale",          Bench_Chart,       Run_ChartRescale },
+    { "GUI_Chart_same",             Bench_Chart,       Run_ChartSame },
+    // 硬件滚动（最后一个用例关闭滚动区）
+    { "Lcd_ScrollArea_16",          NULL,                 Run_ScrollArea },
+    { "Lcd_Scroll_ticker_line",     Bench_Ticker,         Run_TickerLine },
+    { "Lcd_FillRect_ticker_redraw", Bench_Ticker,         Run_TickerRedraw },
+    { "Lcd_FillRect_scrolled",      Bench_TickerScrolled, Run_ScrolledRect },
+    { "Lcd_ScrollTo_same",          Bench_TickerScrolled, Run_ScrollSame },
+    { "Lcd_ScrollArea_off",         Bench_TickerScrolled, Run_ScrollOff },
+    // Lcd_Reset放最后：复位后面板处于睡眠状态
+    { "Lcd_Reset",                  NULL,           Run_Reset },
+};
+
+#define BENCH_CASES     (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+/*---------------------------------------------------阈值----------------------------------------------------*/
+
+/**
+ * @brief  在阈值文件中查找用例
+ * @return 1=找到，0=没有该用例，-1=文件无法打开
+ */
+static int Bench_LookupThreshold(const char *path, const char *name, Bench_Result_t *limit)
+{
+    FILE *f;
+    char line[256], key[128];
+    unsigned long bytes, cs;
+    int found = 0;
+
+    f = fopen(path, "r");
+    if(f == NULL) return -1;
+
+    while(fgets(line, sizeof(line), f))
+    {
+        if(line[0] == '#') continue;
+        if(sscanf(line, "%127s %lu %lu", key, &bytes, &cs) != 3) continue;
+        if(strcmp(key, name) == 0)
+        {
+            limit->bytes = (uint32_t)bytes;
+            limit->cs = (uint32_t)cs;
+            found = 1;
+            break;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+/**
+ * @brief  由测得的开销算出阈值
+ * @note   字节数留5%+16字节余量（小于一次开窗的11字节+几个像素的变化不算回归），
+ *         CS翻转留2次（多一个事务）；测得为0的用例（无变化时不应产生总线活动）阈值保持0
+ */
+static void Bench_Limit(const Bench_Result_t *r, Bench_Result_t *limit)
+{
+    limit->bytes = r->bytes ? r->bytes + r->bytes / 20 + 16 : 0;
+    limit->cs = r->cs ? r->cs + 2 : 0;
+}
+
+/*---------------------------------------------------主程序----------------------------------------------------*/
+
+static int Bench_ParseClocks(const char *arg, double *clocks)
+{
+    int n = 0;
+    char *end;
+
+    while(*arg && n < BENCH_CLOCKS_MAX)
+    {
+        clocks[n] = strtod(arg, &end);
+        if(end == arg || clocks[n] <= 0) return 0;
+        n++;
+        arg = (*end == ',') ? end + 1 : end;
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    // 默认：硬件SPI1的25MHz（spi.h SPI1_BAUD_PRESCALER=1）及其1/2、1/4
+    double clocks[BENCH_CLOCKS_MAX] = { 6.25e6, 12.5e6, 25e6 };
+    int nclocks = 3;
+    const char *thresholds = NULL;
+    FILE *gen = NULL;
+    const Sim_Stats_t *s;
+    Bench_Result_t r, limit;
+    size_t i;
+    int k, found, fail = 0;
+
+    for(k = 1; k < argc; k++)
+    {
+        if(strcmp(argv[k], "-c") == 0 && k + 1 < argc)
+        {
+            nclocks = Bench_ParseClocks(argv[++k], clocks);
+            if(nclocks == 0)
+            {
+                fprintf(stderr, "bad clock list: %s\n", argv[k]);
+                return 2;
+            }
+        }
+        else if(strcmp(argv[k], "-t") == 0 && k + 1 < argc)
+        {
+            thresholds = argv[++k];
+        }
+        else if(strcmp(argv[k], "-g") == 0 && k + 1 < argc && gen == NULL)
+        {
+            gen = fopen(argv[++k], "w");
+            if(gen == NULL)
+            {
+                fprintf(stderr, "cannot write %s\n", argv[k]);
+                return 2;
+            }
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [-c hz[,hz...]] [-t thresholds.tsv] [-g thresholds.tsv]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if(gen)
+    {
+        fprintf(gen, "# lcd_bench 阈值：用例名  最大字节数  最大CS翻转数\n");
+        fprintf(gen, "# 按默认配置（LCD_FB_MODE=0，软件SPI）测得，由 lcd_bench -g 生成：\n");
+        fprintf(gen, "# 字节数 = 测得值 + 5%% + 16，CS翻转 = 测得值 + 2，测得为0的用例保持0。\n");
+        fprintf(gen, "# 开销变化是有意的时重新生成；CTest的bench_check测试用它检查\n");
+    }
+
+    for(k = 0; k < 16 * 16; k++)
+        bench_bitmap[k] = (uint16_t)(k * 0x0821);
+
+    Sim_PowerOn();
+    Lcd_Init();
+
+    printf("case\ttransactions\tcs_toggles\tcmd_bytes\tparam_bytes\tpixel_bytes\tbytes");
+    for(k = 0; k < nclocks; k++)
+        printf("\tus@%.2fMHz", clocks[k] / 1e6);
+    printf("\n");
+
+    for(i = 0; i < BENCH_CASES; i++)
+    {
+        if(bench_cases[i].setup)
+            bench_cases[i].setup();
+        else
+            Bench_Clear();
+        LCD_Pipe_Drain();
+        Sim_ResetStats();
+
+        bench_cases[i].run();
+        Lcd_Flush();
+        LCD_Pipe_Drain();
+
+        s = Sim_GetStats();
+        r.bytes = s->cmd_bytes + s->param_bytes + s->pixel_bytes;
+        r.cs = s->cs_toggles;
+
+        printf("%s\t%u\t%u\t%u\t%u\t%u\t%u", bench_cases[i].name, s->transactions, s->cs_toggles,
+               s->cmd_bytes, s->param_bytes, s->pixel_bytes, r.bytes);
+        for(k = 0; k < nclocks; k++)
+            printf("\t%.1f", r.bytes * 8.0 * 1e6 / clocks[k]);
+        printf("\n");
+
+        if(gen)
+        {
+            Bench_Limit(&r, &limit);
+            fprintf(gen, "%-32s %8u %6u\n", bench_cases[i].name, limit.bytes, limit.cs);
+        }
+        if(thresholds == NULL) continue;
+
+        found = Bench_LookupThreshold(thresholds, bench_cases[i].name, &limit);
+        if(found < 0)
+        {
+            fprintf(stderr, "cannot open %s\n", thresholds);
+            return 2;
+        }
+        if(found && (r.bytes > limit.bytes || r.cs > limit.cs))
+        {
+            fprintf(stderr, "REGRESSION %s: bytes %u (max %u), cs_toggles %u (max %u)\n",
+                    bench_cases[i].name, r.bytes, limit.bytes, r.cs, limit.cs);
+            fail = 1;
+        }
+    }
+
+    if(gen) fclose(gen);
+    return fail;
+}
@@ -0,0 +1,432 @@
+/**
+ ******************************************************************************
+ * @file           : font_bench.c
+ * @brief          : 汉字字库查找吞吐量基准
+ *                   用不同大小的合成字库比较 FNT_FindGlyph（码点二分查找）
+ *                   与原来逐个比较索引的线性查找，并统计UTF-8解码+查找的速度；
+ *                   第二张表统计GUI.c字形缓存在几种用字分布下的命中率和每字耗时，
+ *                   第三张表统计字符串缓存画天气标签的命中率和每串耗时
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 用法：font_bench [每组查找次数]      （默认2000000）
+ *
+ * 合成字库的码点均匀分布在CJK统一汉字区（U+4E00~U+9FA5），查找的字符随机抽取，
+ * 一半在字库中、一半不在。输出为制表符分隔的表格；查找结果与线性查找不一致时返回1。
+ *
+ * 字形缓存表用3500字的合成字库经 Gui_DrawTextFont 逐字绘制，传输层换成不发送的空后端，
+ * 耗时只包含查找、展开和缓存本身；命中缓存画出的像素与未命中时不一致时返回1。
+ * 字符串缓存表同样使用空后端，画出的像素与逐字画不一致时返回1。
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "font.h"
+#include "GUI.h"
+#include "lcd_Driver.h"
+#include "lcd_Transport.h"
+#include "st7735_sim.h"
+
+#define BENCH_CJK_FIRST     0x4E00
+#define BENCH_CJK_LAST      0x9FA5
+#define BENCH_GLYPH_BYTES   32
+#define BENCH_KEYS          4096    // 预先生成的查找码点，循环使用
+#define BENCH_CACHE_FONT    3500    // 字形缓存表使用的字库大小（常用汉字）
+#define BENCH_WEATHER_HOT   8       // 天气/星期文字中反复出现的字数
+#define BENCH_WEATHER_VOCAB 48      // 天气/星期文字总共用到的字数
+#define BENCH_LABELS_FIT    4       // 前4个标签共24字，8x16字体6144字节，放得下默认的字符串缓存
+
+static const unsigned bench_sizes[] = { 4, 64, 500, 3500, 7000, 20902 };
+
+static uint16_t bench_codes[BENCH_CJK_LAST - BENCH_CJK_FIRST + 1];
+static uint8_t *bench_bitmaps;
+static uint32_t bench_keys[BENCH_KEYS];
+static volatile uintptr_t bench_sink;   // 防止查找被优化掉
+
+static double Bench_Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 原来hz16[]的方式：从头逐个比较
+static const uint8_t *Bench_Linear(const FNT_Font_t *font, uint32_t code)
+{
+    uint32_t k;
+
+    for(k = 0; k < font->count; k++)
+    {
+        if(font->codes[k] == code)
+            return font->bitmaps + k * font->glyph_bytes;
+    }
+    return NULL;
+}
+
+// 码点均匀分布在汉字区，每个字形填入自己的码点便于校验
+static void Bench_MakeFont(FNT_Font_t *font, unsigned count)
+{
+    unsigned i, span = BENCH_CJK_LAST - BENCH_CJK_FIRST + 1;
+
+    for(i = 0; i < count; i++)
+    {
+        bench_codes[i] = (uint16_t)(BENCH_CJK_FIRST + (unsigned long)i * span / count);
+        memcpy(bench_bitmaps + i * BENCH_GLYPH_BYTES, &bench_codes[i], sizeof(uint16_t));
+    }
+    font->width = 16;
+    font->height = 16;
+    font->bpp = 1;
+    font->glyph_bytes = BENCH_GLYPH_BYTES;
+    font->count = (uint16_t)count;
+    font->codes = bench_codes;
+    font->bitmaps = bench_bitmaps;
+
+    // 一半取字库中的码点，一半取汉字区中任意码点（大多不在字库中）
+    for(i = 0; i < BENCH_KEYS; i++)
+    {
+        if(i & 1)
+            bench_keys[i] = bench_codes[rand() % count];
+        else
+            bench_keys[i] = BENCH_CJK_FIRST + rand() % span;
+    }
+}
+
+static double Bench_Run(const FNT_Font_t *font, const uint8_t *(*find)(const FNT_Font_t *, uint32_t), unsigned long n)
+{
+    unsigned long i;
+    double t0 = Bench_Now();
+
+    for(i = 0; i < n; i++)
+    {
+        bench_sink += (uintptr_t)find(font, bench_keys[i & (BENCH_KEYS - 1)]);
+    }
+    return Bench_Now() - t0;
+}
+
+// 把查找码点编码成UTF-8字符串，测 FNT_Utf8Next + FNT_FindGlyph
+static double Bench_RunUtf8(const FNT_Font_t *font, unsigned long n)
+{
+    static char text[BENCH_KEYS * 3 + 1];
+    const char *s;
+    unsigned long done = 0;
+    unsigned i;
+    double t0;
+
+    for(i = 0; i < BENCH_KEYS; i++)
+    {
+        text[i * 3 + 0] = (char)(0xE0 | (bench_keys[i] >> 12));
+        text[i * 3 + 1] = (char)(0x80 | ((bench_keys[i] >> 6) & 0x3F));
+        text[i * 3 + 2] = (char)(0x80 | (bench_keys[i] & 0x3F));
+    }
+    text[BENCH_KEYS * 3] = '\0';
+
+    t0 = Bench_Now();
+    while(done < n)
+    {
+        s = text;
+        while(*s)
+        {
+            bench_sink += (uintptr_t)FNT_FindGlyph(font, FNT_Utf8Next(&s));
+        }
+        done += BENCH_KEYS;
+    }
+    return (Bench_Now() - t0) * n / done;
+}
+
+// 二分查找与线性查找对每个码点的结果必须相同，找到的字形必须是这个码点的
+static int Bench_Check(const FNT_Font_t *font)
+{
+    uint32_t code;
+    const uint8_t *a, *b;
+
+    for(code = BENCH_CJK_FIRST - 1; code <= BENCH_CJK_LAST + 1; code++)
+    {
+        a = FNT_FindGlyph(font, code);
+        b = Bench_Linear(font, code);
+        if(a != b || (a && memcmp(a, &(uint16_t){ (uint16_t)code }, sizeof(uint16_t)) != 0))
+        {
+            fprintf(stderr, "%u glyphs: U+%04X found %p, linear scan %p\n", font->count, (unsigned)code, (void *)a, (void *)b);
+            return 1;
+        }
+    }
+    return FNT_FindGlyph(font, 0x10000 + BENCH_CJK_FIRST) != NULL;
+}
+
+/*---------------------------------------------------字形缓存----------------------------------------------------*/
+
+// 什么也不发送的传输层
+static void Null_Init(void) { }
+static void Null_SetDC(uint8_t dc) { (void)dc; }
+static void Null_Write(const uint8_t *buf, uint32_t len) { (void)buf; (void)len; }
+static void Null_Write16(const uint16_t *px, uint32_t count) { (void)px; (void)count; }
+static void Null_Fill16(uint16_t color, uint32_t count) { (void)color; (void)count; }
+static void Null_Write16Async(const uint16_t *px, uint32_t count, void (*done)(void))
+{
+    (void)px; (void)count;
+    if(done) done();
+}
+
+static const LCD_Transport_t bench_null_transport =
+{
+    "null", Null_Init, Null_Init, Null_Init, Null_SetDC, Null_Write, Null_Write16, Null_Fill16, Null_Write16Async,
+};
+
+typedef struct
+{
+    const char *name;
+    unsigned vocab;         // 用到的不同字数
+    unsigned hot;           // 其中3/4的字从前hot个里抽取，0=按顺序轮流
+} Cache_Case_t;
+
+static const Cache_Case_t cache_cases[] =
+{
+    { "cycle_slots",    GUI_GLYPH_CACHE_SLOTS,      0 },    // 正好装得下：全部命中
+    { "cycle_slots+1",  GUI_GLYPH_CACHE_SLOTS + 1,  0 },    // 按顺序轮流多一个字：LRU全部不命中，即无缓存的开销
+    { "weather_text",   BENCH_WEATHER_VOCAB,        BENCH_WEATHER_HOT },
+};
+
+static void Bench_Utf8(char *buf, uint32_t code)
+{
+    buf[0] = (char)(0xE0 | (code >> 12));
+    buf[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+    buf[2] = (char)(0x80 | (code & 0x3F));
+    buf[3] = '\0';
+}
+
+// 在字库中取vocab个字，按用例的分布生成绘制顺序
+static void Bench_CacheKeys(const FNT_Font_t *font, const Cache_Case_t *c)
+{
+    unsigned i, k;
+
+    for(i = 0; i < BENCH_KEYS; i++)
+    {
+        if(c->hot == 0)
+            k = i % c->vocab;
+        else if(rand() % 4)
+            k = rand() % c->hot;
+        else
+            k = rand() % c->vocab;
+        bench_keys[i] = font->codes[k * (font->count / c->vocab)];
+    }
+}
+
+static double Bench_CacheRun(const FNT_Font_t *font, unsigned long n)
+{
+    char text[4];
+    unsigned long i;
+    double t0 = Bench_Now();
+
+    for(i = 0; i < n; i++)
+    {
+        Bench_Utf8(text, bench_keys[i & (BENCH_KEYS - 1)]);
+        Gui_DrawTextFont(0, 0, BLACK, WHITE, font, text);
+    }
+    return Bench_Now() - t0;
+}
+
+/**
+ * @brief  在ST7735模型上比较同一组字未命中和命中缓存时画出的画面
+ * @return 0=一致
+ */
+static int Bench_CacheCheck(const FNT_Font_t *font)
+{
+    static const Cache_Case_t c = { "check", GUI_GLYPH_CACHE_SLOTS, 0 };
+    char text[4];
+    uint32_t hash[2];
+    unsigned pass, i;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    Bench_CacheKeys(font, &c);
+    Gui_GlyphCacheReset();
+
+    for(pass = 0; pass < 2; pass++)
+    {
+        Lcd_Clear(WHITE);
+        for(i = 0; i < c.vocab; i++)
+        {
+            Bench_Utf8(text, bench_keys[i]);
+            Gui_DrawTextFont((i % 8) * 16, (i / 8) * 16, BLACK, WHITE, font, text);
+        }
+        Lcd_Flush();
+        hash[pass] = Sim_Hash();
+    }
+
+    if(hash[0] != hash[1] || Gui_GlyphCacheGetStats()->hits != c.vocab)
+    {
+        fprintf(stderr, "glyph cache: cold %08x, cached %08x, %u hits\n",
+                (unsigned)hash[0], (unsigned)hash[1], (unsigned)Gui_GlyphCacheGetStats()->hits);
+        return 1;
+    }
+    return 0;
+}
+
+static int Bench_Cache(unsigned long n)
+{
+    const GUI_GlyphCacheStats_t *st = Gui_GlyphCacheGetStats();
+    const LCD_Transport_t *sim = LCD_GetTransport();
+    FNT_Font_t font;
+    double t;
+    size_t i;
+    int fail;
+
+    if(GUI_GLYPH_CACHE_SLOTS == 0) return 0;   // 缓存已关闭
+
+    Bench_MakeFont(&font, BENCH_CACHE_FONT);
+    fail = Bench_CacheCheck(&font);
+    LCD_SetTransport(&bench_null_transport);
+
+    printf("\ncache_case\tslots\tvocab\thits\tmisses\tevictions\thit_pct\tns_per_glyph\n");
+    for(i = 0; i < sizeof(cache_cases) / sizeof(cache_cases[0]); i++)
+    {
+        Bench_CacheKeys(&font, &cache_cases[i]);
+        Gui_GlyphCacheReset();
+        t = Bench_CacheRun(&font, n);
+
+        printf("%s\t%u\t%u\t%u\t%u\t%u\t%.1f\t%.1f\n", cache_cases[i].name, GUI_GLYPH_CACHE_SLOTS,
+               cache_cases[i].vocab, (unsigned)st->hits, (unsigned)st->misses, (unsigned)st->evictions,
+               100.0 * st->hits / (st->hits + st->misses), t * 1e9 / n);
+    }
+    LCD_SetTransport(sim);
+    return fail;
+}
+
+/*---------------------------------------------------字符串缓存----------------------------------------------------*/
+
+// 天气界面上反复出现的标签
+static const char *const bench_labels[] =
+{
+    "Sunny", "Cloudy", "Beijing", "Monday", "Overcast", "Light rain",
+    "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday",
+};
+
+typedef struct
+{
+    const char *name;
+    unsigned labels;        // 轮流画前labels个标签
+    uint8_t cached;         // 0=逐字画（原来的方式）
+} String_Case_t;
+
+static const String_Case_t string_cases[] =
+{
+    { "per_char",       BENCH_LABELS_FIT,   0 },
+    { "labels_fit",     BENCH_LABELS_FIT,   1 },    // 放得下：除第一轮外全部命中
+    { "labels_thrash",  12,                 1 },    // 放不下，按顺序轮流：LRU全部不命中，即缓存本身的开销
+};
+
+static void Bench_Label(uint16_t x, uint16_t y, const char *s, uint8_t cached)
+{
+    if(cached)
+    {
+        Gui_DrawAsciiString(x, y, BLACK, WHITE, s);
+        return;
+    }
+    for(; *s; s++, x += 8)
+        Gui_DrawAsciiChar(x, y, BLACK, WHITE, *s);
+}
+
+/**
+ * @brief  在ST7735模型上比较逐字画、缓存未命中和命中时画出的画面
+ * @return 0=一致
+ */
+static int Bench_StringCheck(void)
+{
+    uint32_t hash[3];
+    unsigned pass, i;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    Gui_StringCacheReset();
+
+    for(pass = 0; pass < 3; pass++)
+    {
+        Lcd_Clear(WHITE);
+        for(i = 0; i < BENCH_LABELS_FIT; i++)
+            Bench_Label(0, i * 16, bench_labels[i], pass > 0);
+        Lcd_Flush();
+        hash[pass] = Sim_Hash();
+    }
+
+    if(hash[0] != hash[1] || hash[1] != hash[2] || Gui_StringCacheGetStats()->hits != BENCH_LABELS_FIT)
+    {
+        fprintf(stderr, "string cache: per char %08x, cold %08x, cached %08x, %u hits\n",
+                (unsigned)hash[0], (unsigned)hash[1], (unsigned)hash[2],
+                (unsigned)Gui_StringCacheGetStats()->hits);
+        return 1;
+    }
+    return 0;
+}
+
+static int Bench_Strings(unsigned long n)
+{
+    const GUI_StringCacheStats_t *st = Gui_StringCacheGetStats();
+    const LCD_Transport_t *sim = LCD_GetTransport();
+    unsigned long i;
+    size_t k;
+    double t;
+    int fail;
+
+    if(GUI_STRING_CACHE_BYTES == 0) return 0;  // 缓存已关闭
+
+    fail = Bench_StringCheck();
+    LCD_SetTransport(&bench_null_transport);
+
+    printf("\nstring_case\tlabels\thits\tmisses\tevictions\thit_pct\tbytes_saved\tns_per_string\n");
+    for(k = 0; k < sizeof(string_cases) / sizeof(string_cases[0]); k++)
+    {
+        Gui_StringCacheReset();
+        t = Bench_Now();
+        for(i = 0; i < n; i++)
+            Bench_Label(0, 0, bench_labels[i % string_cases[k].labels], string_cases[k].cached);
+        t = Bench_Now() - t;
+
+        printf("%s\t%u\t%u\t%u\t%u\t%u\t%lu\t%.1f\n", string_cases[k].name, string_cases[k].labels,
+               (unsigned)st->hits, (unsigned)st->misses, (unsigned)st->evictions,
+               Gui_StringCacheHitPercent(), (unsigned long)st->bytes_saved, t * 1e9 / n);
+    }
+    LCD_SetTransport(sim);
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned long n = (argc > 1) ? strtoul(argv[1], NULL, 0) : 2000000UL;
+    FNT_Font_t font;
+    double t_bin, t_lin, t_utf8;
+    unsigned long n_lin;
+    size_t i;
+    int fail = 0;
+
+    bench_bitmaps = calloc(sizeof(bench_codes) / sizeof(bench_codes[0]), BENCH_GLYPH_BYTES);
+    if(bench_bitmaps == NULL || n == 0) return 1;
+    srand(1);
+
+    printf("glyphs\tindex_bytes\tbsearch_ns\tlinear_ns\tutf8_ns\tbsearch_Mlookup_s\n");
+    for(i = 0; i < sizeof(bench_sizes) / sizeof(bench_sizes[0]); i++)
+    {
+        Bench_MakeFont(&font, bench_sizes[i]);
+        fail |= Bench_Check(&font);
+
+        // 线性查找在大字库上很慢，按字库大小减少次数
+        n_lin = n / (1 + bench_sizes[i] / 64);
+        if(n_lin == 0) n_lin = 1;
+
+        t_bin = Bench_Run(&font, FNT_FindGlyph, n);
+        t_lin = Bench_Run(&font, Bench_Linear, n_lin);
+        t_utf8 = Bench_RunUtf8(&font, n);
+
+        printf("%u\t%u\t%.1f\t%.1f\t%.1f\t%.1f\n",
+               bench_sizes[i], bench_sizes[i] * 2,
+               t_bin * 1e9 / n, t_lin * 1e9 / n_lin, t_utf8 * 1e9 / n, n / t_bin / 1e6);
+    }
+
+    fail |= Bench_Cache(n / 8);
+    fail |= Bench_Strings(n / 64);
+
+    free(bench_bitmaps);
+    return fail;
+}
@@ -0,0 +1,60 @@
+/**
+ ******************************************************************************
+ * @file           : stm32f4xx_hal.h（主机端替身）
+ * @brief          : lcd_sim 使用的最小HAL接口
+ *                   只提供LCD驱动用到的GPIO类型/函数和HAL_Delay，
+ *                   引脚写操作由 sim_hal.c 转给ST7735模型解码
+ ******************************************************************************
+ */
+
+#ifndef __STM32F4xx_HAL_H
+#define __STM32F4xx_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct
+{
+    volatile uint32_t ODR;
+    volatile uint32_t BSRR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef sim_gpioa;
+#define GPIOA                       (&sim_gpioa)
+
+#define GPIO_PIN_0                  ((uint16_t)0x0001)
+#define GPIO_PIN_1                  ((uint16_t)0x0002)
+#define GPIO_PIN_2                  ((uint16_t)0x0004)
+#define GPIO_PIN_3                  ((uint16_t)0x0008)
+#define GPIO_PIN_4                  ((uint16_t)0x0010)
+#define GPIO_PIN_5                  ((uint16_t)0x0020)
+#define GPIO_PIN_6                  ((uint16_t)0x0040)
+#define GPIO_PIN_7                  ((uint16_t)0x0080)
+
+#define GPIO_MODE_OUTPUT_PP         0x00000001U
+#define GPIO_NOPULL                 0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH   0x00000003U
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    do {} while(0)
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_Delay(uint32_t Delay);
+uint32_t HAL_GetTick(void);
+
+#endif /* __STM32F4xx_HAL_H */
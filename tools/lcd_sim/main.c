@@ -0,0 +1,200 @@
+/**
+ ******************************************************************************
+ * @file           : main.c
+ * @brief          : lcd_sim 入口
+ *                   按 Core/Src/main.c 和 esp32_weather.c 的显示流程（UI/Src/screen.c）逐个场景绘制，
+ *                   每个场景保存一张PPM快照并打印引脚层统计
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 用法：lcd_sim [输出目录]      （默认当前目录）
+ *
+ * 驱动自身的LCD_Stats_t与模型在引脚上看到的字节数不一致时返回1，
+ * 用来发现绕过LCD_Tx*统计的发送路径；数据没有变化的idle场景产生总线活动时也返回1。
+ * 每个场景画完后的屏幕哈希与sim_scenes[]中记录的不同时返回1（三种显示缓冲模式的画面相同，共用一组哈希）；
+ * 画面是有意改变的，看过PPM快照后把输出的哈希抄回表中。
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "st7735_sim.h"
+#include "lcd_Driver.h"
+#include "lcd_Pipe.h"
+#include "GUI.h"
+#include "font.h"
+#include "screen.h"
+
+typedef struct
+{
+    const char *name;
+    void (*draw)(void);
+    uint8_t idle;           // 1=不应产生任何总线活动
+    uint32_t hash;          // 期望的Sim_Hash()
+} Sim_Scene_t;
+
+/*---------------------------------------------------场景----------------------------------------------------*/
+
+static void Scene_Init(void)
+{
+    Lcd_Init();
+}
+
+// 开机画面（main.c USER CODE 2）
+static void Scene_Boot(void)
+{
+    Screen_Init();
+    Screen_Update();
+}
+
+// get_weather()
+static void Scene_Weather(void)
+{
+    Screen_SetOutdoorTemp("23");
+    Screen_SetWeather("Cloudy");
+    Screen_Update();
+}
+
+// 主循环中的DHT11温湿度
+static void Scene_Sensor(void)
+{
+    Screen_SetIndoor(45, 26);
+    Screen_Update();
+}
+
+// get_time()
+static void Scene_Time(void)
+{
+    Screen_SetDateTime("2025/10/17", "11:20:01");
+    Screen_Update();
+}
+
+// 下一秒：只有最后一位变化
+static void Scene_Tick(void)
+{
+    Screen_SetDateTime("2025/10/17", "11:20:02");
+    Screen_Update();
+}
+
+// 主循环再走一遍，所有数据都没变
+static void Scene_Idle(void)
+{
+    Screen_SetIndoor(45, 26);
+    Screen_SetOutdoorTemp("23");
+    Screen_SetWeather("Cloudy");
+    Screen_SetDateTime("2025/10/17", "11:20:02");
+    Screen_Update();
+}
+
+// 主循环按周期记录室内温湿度：攒够一屏多的采样（缓冲区回绕）
+static void Scene_History(void)
+{
+    int i;
+
+    for(i = 0; i < 140; i++) Screen_AddIndoorSample(45 + (i % 20) / 4, 24 + (i % 30) / 10);
+    Screen_Update();
+}
+
+// 下一个采样，纵轴范围不变：只重画新采样、游标和游标后一列
+static void Scene_Sample(void)
+{
+    Screen_AddIndoorSample(47, 25);
+    Screen_Update();
+}
+
+static const Sim_Scene_t sim_scenes[] =
+{
+    { "init",    Scene_Init,    0, 0x2b5d1dc5 },
+    { "boot",    Scene_Boot,    0, 0x3e520643 },
+    { "weather", Scene_Weather, 0, 0xae148415 },
+    { "sensor",  Scene_Sensor,  0, 0x6b16be6d },
+    { "time",    Scene_Time,    0, 0x0885c75d },
+    { "tick",    Scene_Tick,    0, 0x57ef902f },
+    { "idle",    Scene_Idle,    1, 0x57ef902f },
+    { "history", Scene_History, 0, 0xf63fae8b },
+    { "sample",  Scene_Sample,  0, 0xf93408ad },
+};
+
+/*---------------------------------------------------主程序----------------------------------------------------*/
+
+/**
+ * @brief  驱动统计与引脚层统计比较
+ * @return 0=一致
+ */
+static int Sim_CheckStats(const char *name)
+{
+    const Sim_Stats_t *s = Sim_GetStats();
+    const LCD_Stats_t *d = LCD_GetStats();
+    int bad = 0;
+
+    if(d->selects != s->transactions) bad = 1;
+    if(d->cmd_bytes != s->cmd_bytes) bad = 1;
+    if(d->param_bytes != s->param_bytes) bad = 1;
+    if(d->pixel_bytes != s->pixel_bytes) bad = 1;
+
+    if(bad)
+    {
+        fprintf(stderr, "%s: driver stats differ from bus: selects %u/%u cmd %u/%u param %u/%u pixel %u/%u\n",
+                name, d->selects, s->transactions, d->cmd_bytes, s->cmd_bytes,
+                d->param_bytes, s->param_bytes, d->pixel_bytes, s->pixel_bytes);
+    }
+    if(s->errors || s->oob_pixels || s->sleep_pixels)
+    {
+        fprintf(stderr, "%s: %u protocol errors, %u out-of-range pixels, %u pixels while asleep\n",
+                name, s->errors, s->oob_pixels, s->sleep_pixels);
+        bad = 1;
+    }
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    const char *outdir = (argc > 1) ? argv[1] : ".";
+    char path[512];
+    const Sim_Stats_t *s;
+    uint32_t hash;
+    size_t i;
+    int fail = 0;
+
+    Sim_PowerOn();
+
+    printf("%-8s %6s %6s %6s %6s %8s %6s %6s %10s\n",
+           "scene", "trans", "cs", "cmd", "param", "pixel", "wins", "errs", "hash");
+
+    for(i = 0; i < sizeof(sim_scenes) / sizeof(sim_scenes[0]); i++)
+    {
+        Sim_ResetStats();
+        LCD_ResetStats();
+
+        sim_scenes[i].draw();
+        LCD_Pipe_Drain();
+
+        s = Sim_GetStats();
+        hash = Sim_Hash();
+        printf("%-8s %6u %6u %6u %6u %8u %6u %6u   %08x\n",
+               sim_scenes[i].name, s->transactions, s->cs_toggles, s->cmd_bytes,
+               s->param_bytes, s->pixel_bytes, s->windows, s->errors, hash);
+
+        fail |= Sim_CheckStats(sim_scenes[i].name);
+        if(sim_scenes[i].idle && s->cs_toggles)
+        {
+            fprintf(stderr, "%s: expected no bus activity, saw %u CS toggles\n", sim_scenes[i].name, s->cs_toggles);
+            fail = 1;
+        }
+        if(hash != sim_scenes[i].hash)
+        {
+            fprintf(stderr, "%s: screen hash %08x, expected %08x\n", sim_scenes[i].name, hash, sim_scenes[i].hash);
+            fail = 1;
+        }
+
+        snprintf(path, sizeof(path), "%s/%02u_%s.ppm", outdir, (unsigned)i, sim_scenes[i].name);
+        if(Sim_WritePPM(path) != 0)
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            fail = 1;
+        }
+    }
+
+    return fail;
+}
@@ -0,0 +1,43 @@
+/**
+ ******************************************************************************
+ * @file           : sim_hal.c
+ * @brief          : lcd_sim 的HAL替身
+ *                   HAL_GPIO_WritePin 更新GPIOA的ODR并把电平变化交给ST7735模型，
+ *                   HAL_Delay 只推进虚拟毫秒计数，不真正等待
+ ******************************************************************************
+ */
+
+#include "stm32f4xx_hal.h"
+#include "st7735_sim.h"
+
+GPIO_TypeDef sim_gpioa;
+static uint32_t sim_tick = 0;
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    uint32_t old = GPIOx->ODR;
+
+    if(PinState != GPIO_PIN_RESET)
+        GPIOx->ODR = old | GPIO_Pin;
+    else
+        GPIOx->ODR = old & ~(uint32_t)GPIO_Pin;
+
+    if(GPIOx == &sim_gpioa && GPIOx->ODR != old)
+        Sim_PinsChanged(old, GPIOx->ODR);
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    sim_tick += Delay;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return sim_tick;
+}
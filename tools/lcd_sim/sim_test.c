@@ -0,0 +1,1267 @@
+/**
+ ******************************************************************************
+ * @file           : sim_test.c
+ * @brief          : 驱动/GUI的主机端回归测试
+ *                   在ST7735模型上检查总线字节流，并把字形、直线、图片和填充图形的输出
+ *                   与逐点画的参考逐像素比较，检查硬件滚动后屏幕上的内容，由CTest逐个调用
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 用法：sim_test [用例名 ...]      （不带参数时运行全部用例）
+ *
+ * 每个用例通过时输出 PASS，失败时在stderr说明原因并输出 FAIL；任一用例失败时返回1。
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include "st7735_sim.h"
+#include "lcd_Driver.h"
+#include "lcd_Transport.h"
+#include "lcd_Mock.h"
+#include "lcd_Pipe.h"
+#include "GUI.h"
+#include "font.h"
+
+typedef struct
+{
+    const char *name;
+    int (*run)(void);       // 返回0=通过
+} Test_Case_t;
+
+/*---------------------------------------------------传输层一致性----------------------------------------------------*/
+
+// 覆盖命令、开窗、纯色填充、像素流、流水线缓冲和文字/图片的场景
+static void Test_Scene(void)
+{
+    uint16_t *buf;
+    int i;
+
+    Lcd_Clear(WHITE);
+    Lcd_FillRect(10, 10, 50, 20, BLUE);
+    Gui_DrawLine(0, 0, X_MAX_PIXEL - 1, Y_MAX_PIXEL - 1, RED);
+    Gui_Circle(64, 80, 30, GREEN);
+    Gui_box(70, 120, 40, 20, GRAY1);
+    Gui_DrawAsciiString(20, 110, BLACK, WHITE, "11:20:01");
+    Gui_DrawText16(10, 40, BLACK, WHITE, "孙");
+    Gui_DrawImage(90, 40, gImage_1);
+
+    Lcd_BeginWindow(0, 140, 15, 155);
+    buf = Lcd_AcquirePixels();
+    for(i = 0; i < 256; i++) buf[i] = (uint16_t)(i * 0x0101);
+    Lcd_CommitPixels(buf, 256);
+    Lcd_EndWindow();
+
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+}
+
+/**
+ * @brief  用指定传输层画一遍场景
+ * @note   每次从相同的状态开始：显示缓冲为黑屏、字形/字符串缓存为空、窗口缓存失效（切换传输层时）
+ */
+static void Test_DrawWith(const LCD_Transport_t *transport)
+{
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+    Lcd_Clear(BLACK);
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+    Gui_GlyphCacheReset();
+    Gui_StringCacheReset();
+
+    LCD_SetTransport(transport);
+    Sim_ResetStats();
+    LCD_Mock_Reset();
+    Test_Scene();
+}
+
+/**
+ * @brief  软件SPI在引脚上发出的(dc,byte)流与记录型传输层记下的必须完全相同
+ */
+static int Test_TransportMock(void)
+{
+    const Sim_Stats_t *s = Sim_GetStats();
+    const LCD_MockStats_t *m = LCD_Mock_GetStats();
+    const LCD_MockEntry_t *log;
+    uint32_t hash, selects, bytes;
+    static const uint8_t expect[][2] =     // 窗口缓存失效后填充一个2x1矩形
+    {
+        { 0, 0x2A }, { 1, 0x00 }, { 1, 10 + 2 }, { 1, 0x00 }, { 1, 11 + 2 },
+        { 0, 0x2B }, { 1, 0x00 }, { 1, 20 + 3 }, { 1, 0x00 }, { 1, 20 + 3 },
+        { 0, 0x2C }, { 1, 0xF8 }, { 1, 0x00 }, { 1, 0xF8 }, { 1, 0x00 },
+    };
+    uint32_t i;
+
+    Sim_PowerOn();
+    Lcd_Init();
+
+    Test_DrawWith(&LCD_Transport_SoftSPI);
+    hash = s->bus_hash;
+    selects = s->transactions;
+    bytes = s->cmd_bytes + s->param_bytes + s->pixel_bytes;
+
+    Test_DrawWith(&LCD_Transport_Mock);
+    if(s->transactions != 0)
+    {
+        fprintf(stderr, "mock transport reached the bus: %u transactions\n", s->transactions);
+        return 1;
+    }
+    if(m->hash != hash || m->selects != selects || m->bytes != bytes)
+    {
+        fprintf(stderr, "soft-spi hash %08x, %u selects, %u bytes; mock hash %08x, %u selects, %u bytes\n",
+                (unsigned)hash, (unsigned)selects, (unsigned)bytes,
+                (unsigned)m->hash, (unsigned)m->selects, (unsigned)m->bytes);
+        return 1;
+    }
+
+    // 逐字节日志与手算的命令序列比较
+    LCD_SetTransport(&LCD_Transport_Mock);
+    Lcd_Clear(BLACK);
+    Lcd_Flush();
+    Lcd_WriteIndex(0x00);                   // NOP，使窗口缓存失效
+    LCD_Mock_Reset();
+    Lcd_FillRect(10, 20, 2, 1, RED);
+    Lcd_Flush();
+
+    log = LCD_Mock_GetLog();
+    if(m->logged != sizeof(expect) / sizeof(expect[0]))
+    {
+        fprintf(stderr, "mock log: %u entries, expected %u\n",
+                (unsigned)m->logged, (unsigned)(sizeof(expect) / sizeof(expect[0])));
+        return 1;
+    }
+    for(i = 0; i < m->logged; i++)
+    {
+        if(log[i].dc != expect[i][0] || log[i].byte != expect[i][1])
+        {
+            fprintf(stderr, "mock log[%u]: dc=%u 0x%02X, expected dc=%u 0x%02X\n",
+                    (unsigned)i, log[i].dc, log[i].byte, expect[i][0], expect[i][1]);
+            return 1;
+        }
+    }
+
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+    return 0;
+}
+
+/*---------------------------------------------------矩形填充----------------------------------------------------*/
+
+typedef struct
+{
+    uint16_t x, y, w, h;    // Lcd_FillRect参数
+    uint16_t cw, ch;        // 裁剪到屏幕后的宽高
+} Test_Fill_t;
+
+static const Test_Fill_t test_fills[] =
+{
+    {  10,  10,  50,  20,  50,  20 },
+    {   0,   0, 128, 160, 128, 160 },   // 整屏
+    { 127,   0,   1,   1,   1,   1 },   // 单个像素
+    {   0, 159, 128,   1, 128,   1 },   // 最后一行
+    { 120, 150,  20,  20,   8,  10 },   // 右下角裁剪
+    {   0,  80, 300,   2, 128,   2 },   // 宽度超出屏幕
+    {  64,  64,   0,  10,   0,   0 },   // 空矩形
+    { 128,   0,  10,  10,   0,   0 },   // 完全在屏幕外
+};
+
+/**
+ * @brief  每次填充的SPI字节数 = w*h*2（像素） + 11（CASET/RASET各1+4字节，RAMWR 1字节），一次事务
+ * @note   填充前用NOP使窗口缓存失效，否则与上一个窗口相同的CASET/RASET会被省掉；
+ *         条带模式在Flush时按条带分成多个窗口，列范围不变，之后每个窗口只有RASET+RAMWR 6字节
+ */
+static int Test_FillRect(void)
+{
+    const Sim_Stats_t *s = Sim_GetStats();
+    const Test_Fill_t *f;
+    uint32_t pixels, header, trans;
+    size_t i;
+    int fail = 0;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+
+    for(i = 0; i < sizeof(test_fills) / sizeof(test_fills[0]); i++)
+    {
+        f = &test_fills[i];
+        Lcd_Clear(BLACK);                   // 显示缓冲模式下每个像素都要变化才会全部发送
+        Lcd_Flush();
+        Lcd_WriteIndex(0x00);
+        LCD_Pipe_Drain();
+        Sim_ResetStats();
+
+        Lcd_FillRect(f->x, f->y, f->w, f->h, (uint16_t)(WHITE - i));
+        Lcd_Flush();
+        LCD_Pipe_Drain();
+
+        pixels = (uint32_t)f->cw * f->ch;
+        header = pixels ? 11 : 0;
+        trans = pixels ? 1 : 0;
+#if (LCD_FB_MODE == LCD_FB_BAND)
+        if(pixels) header += 6 * (s->windows - 1);
+        trans = s->windows;                 // 每个条带一次事务
+#endif
+        if(s->pixel_bytes != pixels * 2 || s->cmd_bytes + s->param_bytes != header || s->transactions != trans)
+        {
+            fprintf(stderr, "FillRect(%u, %u, %u, %u): %u pixel bytes, %u header bytes, %u transactions; "
+                    "expected %u, %u, %u\n", f->x, f->y, f->w, f->h, s->pixel_bytes,
+                    s->cmd_bytes + s->param_bytes, s->transactions,
+                    (unsigned)(pixels * 2), (unsigned)header, (unsigned)trans);
+            fail = 1;
+        }
+    }
+    return fail;
+}
+
+/*---------------------------------------------------逐像素对比----------------------------------------------------*/
+
+static uint16_t test_snap[Y_MAX_PIXEL][X_MAX_PIXEL];
+
+/**
+ * @brief  清屏为GRAY1并清空裁剪区和字形/字符串缓存，每一遍都从相同的状态开始
+ */
+static void Test_Blank(void)
+{
+    Lcd_Clear(GRAY1);
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+    Gui_ResetClip();
+    Gui_GlyphCacheReset();
+    Gui_StringCacheReset();
+}
+
+/**
+ * @brief  被测函数和逐点参考（Gui_DrawPoint）各画一遍，屏上每个像素都必须相同
+ * @param  what: 失败时输出的说明
+ * @return 0=一致
+ */
+static int Test_Compare(const char *what, void (*draw)(void), void (*ref)(void))
+{
+    uint16_t x, y, c;
+    uint32_t diff = 0;
+
+    Test_Blank();
+    draw();
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+    for(y = 0; y < Y_MAX_PIXEL; y++)
+        for(x = 0; x < X_MAX_PIXEL; x++) test_snap[y][x] = Sim_GetPixel(x, y);
+
+    Test_Blank();
+    ref();
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+    for(y = 0; y < Y_MAX_PIXEL; y++)
+    {
+        for(x = 0; x < X_MAX_PIXEL; x++)
+        {
+            c = Sim_GetPixel(x, y);
+            if(c == test_snap[y][x]) continue;
+            if(diff == 0)
+                fprintf(stderr, "%s: pixel (%u, %u) is %04X, reference %04X\n", what, x, y, test_snap[y][x], c);
+            diff++;
+        }
+    }
+    if(diff) fprintf(stderr, "%s: %u pixels differ\n", what, (unsigned)diff);
+    return diff != 0;
+}
+
+/*---------------------------------------------------字形----------------------------------------------------*/
+
+typedef enum { GLYPH_ASCII, GLYPH_HZ16, GLYPH_HZ24, GLYPH_NUM32 } Test_GlyphKind_t;
+
+typedef struct
+{
+    uint8_t kind;               // Test_GlyphKind_t
+    uint16_t code;              // 码点；大号数字为0~9
+    uint16_t x, y, w, h;
+    const uint8_t *bits;        // 字库中的点阵，按行扫描、高位在前，每行(w+7)/8字节
+} Test_Glyph_t;
+
+#define TEST_GLYPHS_MAX     128
+
+static Test_Glyph_t test_glyphs[TEST_GLYPHS_MAX];
+static uint16_t test_glyph_n;
+static uint16_t test_fc, test_bc;
+static uint8_t test_by_string;          // 1=同一行相邻的同种字连成一串画（经过字符串缓存）
+
+// 码点编码为UTF-8（只有BMP），返回字节数，不加结束符
+static uint8_t Test_Utf8(char *dst, uint16_t code)
+{
+    if(code < 0x80)
+    {
+        dst[0] = (char)code;
+        return 1;
+    }
+    if(code < 0x800)
+    {
+        dst[0] = (char)(0xC0 | (code >> 6));
+        dst[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    dst[0] = (char)(0xE0 | (code >> 12));
+    dst[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+    dst[2] = (char)(0x80 | (code & 0x3F));
+    return 3;
+}
+
+static void Test_GlyphAdd(uint8_t kind, uint16_t code, uint16_t w, uint16_t h, const uint8_t *bits)
+{
+    Test_Glyph_t *g;
+
+    if(test_glyph_n < TEST_GLYPHS_MAX)
+    {
+        g = &test_glyphs[test_glyph_n];
+        g->kind = kind;
+        g->code = code;
+        g->w = w;
+        g->h = h;
+        g->bits = bits;
+    }
+    test_glyph_n++;
+}
+
+/**
+ * @brief  把95个ASCII字符、hz16/hz24的全部字形和所有大号数字从左到右、从上到下排在一屏里
+ * @return 0=放得下
+ * @note   GUI_FONT_AA=1时ASCII和大号数字用抗锯齿字库画，输出是混合色，没有逐位的参考，不排入
+ */
+static int Test_GlyphLayout(void)
+{
+    uint16_t i, x = 0, y = 0, row_h = 0;
+    Test_Glyph_t *g;
+
+    test_glyph_n = 0;
+#if !GUI_FONT_AA
+    for(i = 0x20; i <= 0x7E; i++) Test_GlyphAdd(GLYPH_ASCII, i, 8, 16, ascii_font[i - 0x20]);
+#endif
+    for(i = 0; i < hz16.count; i++)
+        Test_GlyphAdd(GLYPH_HZ16, hz16.codes[i], hz16.width, hz16.height, hz16.bitmaps + (uint32_t)i * hz16.glyph_bytes);
+    for(i = 0; i < hz24.count; i++)
+        Test_GlyphAdd(GLYPH_HZ24, hz24.codes[i], hz24.width, hz24.height, hz24.bitmaps + (uint32_t)i * hz24.glyph_bytes);
+#if !GUI_FONT_AA
+    for(i = 0; i < sz32_num; i++) Test_GlyphAdd(GLYPH_NUM32, i, 32, 32, sz32 + i * 32 * 4);
+#endif
+
+    if(test_glyph_n > TEST_GLYPHS_MAX)
+    {
+        fprintf(stderr, "%u glyphs, at most %u fit in the table\n", test_glyph_n, TEST_GLYPHS_MAX);
+        return 1;
+    }
+    for(i = 0; i < test_glyph_n; i++)
+    {
+        g = &test_glyphs[i];
+        if(x + g->w > X_MAX_PIXEL)
+        {
+            x = 0;
+            y += row_h;
+            row_h = 0;
+        }
+        g->x = x;
+        g->y = y;
+        x += g->w;
+        if(g->h > row_h) row_h = g->h;
+    }
+    if(y + row_h > Y_MAX_PIXEL)
+    {
+        fprintf(stderr, "glyphs need %u rows, the screen has %u\n", y + row_h, Y_MAX_PIXEL);
+        return 1;
+    }
+    return 0;
+}
+
+// 逐字画：GBK16/GBK24兼容接口和Gui_DrawAsciiChar经过字形缓存
+static void Test_GlyphOne(const Test_Glyph_t *g)
+{
+    char text[4];
+
+    text[Test_Utf8(text, g->code)] = '\0';
+    switch(g->kind)
+    {
+        case GLYPH_ASCII: Gui_DrawAsciiChar(g->x, g->y, test_fc, test_bc, (char)g->code); break;
+        case GLYPH_HZ16:  Gui_DrawFont_GBK16(g->x, g->y, test_fc, test_bc, (uint8_t *)text); break;
+        case GLYPH_HZ24:  Gui_DrawFont_GBK24(g->x, g->y, test_fc, test_bc, (uint8_t *)text); break;
+        default:          Gui_DrawFont_Num32(g->x, g->y, test_fc, test_bc, g->code); break;
+    }
+}
+
+static void Test_GlyphDraw(void)
+{
+    char text[GUI_STRING_CACHE_TEXT];
+    const Test_Glyph_t *g;
+    uint16_t i, j;
+    size_t n;
+    uint8_t pass;
+
+    for(pass = 0; pass < 2; pass++)         // 第二遍在原处重画，命中字形/字符串缓存
+    {
+        for(i = 0; i < test_glyph_n; i = j)
+        {
+            g = &test_glyphs[i];
+            j = i + 1;
+            if(!test_by_string || g->kind == GLYPH_NUM32)
+            {
+                Test_GlyphOne(g);
+                continue;
+            }
+
+            n = Test_Utf8(text, g->code);
+            while(j < test_glyph_n && test_glyphs[j].kind == g->kind && test_glyphs[j].y == g->y && n + 4 <= sizeof(text))
+                n += Test_Utf8(text + n, test_glyphs[j++].code);
+            text[n] = '\0';
+
+            switch(g->kind)
+            {
+                case GLYPH_ASCII: Gui_DrawAsciiString(g->x, g->y, test_fc, test_bc, text); break;
+                case GLYPH_HZ16:  Gui_DrawText16(g->x, g->y, test_fc, test_bc, text); break;
+                default:          Gui_DrawText24(g->x, g->y, test_fc, test_bc, text); break;
+            }
+        }
+    }
+}
+
+// 改写前的画法：逐位判断，前景画fc、背景画bc，fc==bc时背景透明
+static void Test_GlyphRef(void)
+{
+    const Test_Glyph_t *g;
+    uint16_t i, r, c, stride;
+
+    for(i = 0; i < test_glyph_n; i++)
+    {
+        g = &test_glyphs[i];
+        stride = (g->w + 7) / 8;
+        for(r = 0; r < g->h; r++)
+        {
+            for(c = 0; c < g->w; c++)
+            {
+                if(g->bits[r * stride + c / 8] & (0x80 >> (c % 8))) Gui_DrawPoint(g->x + c, g->y + r, test_fc);
+                else if(test_fc != test_bc) Gui_DrawPoint(g->x + c, g->y + r, test_bc);
+            }
+        }
+    }
+}
+
+static const uint16_t test_glyph_colors[][2] =     // {fc, bc}
+{
+    { BLACK,  WHITE  },
+    { WHITE,  BLACK  },
+    { RED,    BLUE   },
+    { 0x1234, 0xFEDC },
+    { YELLOW, YELLOW },     // 透明
+    { BLACK,  BLACK  },     // 透明
+};
+
+/**
+ * @brief  全部字形按每组前景/背景色逐字和整串各画一遍，与字库点阵逐像素比较
+ */
+static int Test_Glyphs(void)
+{
+    char what[64];
+    size_t i;
+    int fail = 0;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+
+    if(hz16.bpp != 1 || hz24.bpp != 1)
+    {
+        fprintf(stderr, "hz16/hz24 must be 1-bpp fonts (%u/%u)\n", hz16.bpp, hz24.bpp);
+        return 1;
+    }
+    if(Test_GlyphLayout()) return 1;
+
+    for(i = 0; i < sizeof(test_glyph_colors) / sizeof(test_glyph_colors[0]); i++)
+    {
+        test_fc = test_glyph_colors[i][0];
+        test_bc = test_glyph_colors[i][1];
+        for(test_by_string = 0; test_by_string < 2; test_by_string++)
+        {
+            snprintf(what, sizeof(what), "%u glyphs fc=%04X bc=%04X %s", test_glyph_n, test_fc, test_bc,
+                     test_by_string ? "as strings" : "one by one");
+            fail |= Test_Compare(what, Test_GlyphDraw, Test_GlyphRef);
+        }
+    }
+    return fail;
+}
+
+/*---------------------------------------------------直线和空心圆----------------------------------------------------*/
+
+#define TEST_LINES          200
+
+static uint32_t test_seed;
+
+// 线性同余伪随机数，每一遍从同一个种子开始
+static uint16_t Test_Rand(uint16_t n)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return (uint16_t)((test_seed >> 16) % n);
+}
+
+// 改写前的Gui_DrawLine：Bresenham逐点
+static void Test_LineRef(int x0, int y0, int x1, int y1, uint16_t color)
+{
+    int dx = x1 - x0, dy = y1 - y0, x_inc = 1, y_inc = 1, error, i;
+
+    if(dx < 0) { x_inc = -1; dx = -dx; }
+    if(dy < 0) { y_inc = -1; dy = -dy; }
+
+    if(dx > dy)
+    {
+        error = 2 * dy - dx;
+        for(i = 0; i <= dx; i++)
+        {
+            Gui_DrawPoint(x0, y0, color);
+            if(error >= 0) { error -= 2 * dx; y0 += y_inc; }
+            error += 2 * dy;
+            x0 += x_inc;
+        }
+    }
+    else
+    {
+        error = 2 * dx - dy;
+        for(i = 0; i <= dy; i++)
+        {
+            Gui_DrawPoint(x0, y0, color);
+            if(error >= 0) { error -= 2 * dy; x0 += x_inc; }
+            error += 2 * dx;
+            y0 += y_inc;
+        }
+    }
+}
+
+// 改写前的Gui_Circle：8个对称点逐点画，伸出屏幕的坐标转成uint16_t后被Gui_DrawPoint丢弃
+static void Test_CirclePoints(int X, int Y, int a, int b, uint16_t fc)
+{
+    Gui_DrawPoint(X + a, Y + b, fc);
+    Gui_DrawPoint(X - a, Y + b, fc);
+    Gui_DrawPoint(X + a, Y - b, fc);
+    Gui_DrawPoint(X - a, Y - b, fc);
+    Gui_DrawPoint(X + b, Y + a, fc);
+    Gui_DrawPoint(X - b, Y + a, fc);
+    Gui_DrawPoint(X + b, Y - a, fc);
+    Gui_DrawPoint(X - b, Y - a, fc);
+}
+
+static void Test_CircleRef(int X, int Y, int R, uint16_t fc)
+{
+    int a = 0, b = R, c = 3 - 2 * R;
+
+    while(a < b)
+    {
+        Test_CirclePoints(X, Y, a, b, fc);
+        if(c < 0) c = c + 4 * a + 6;
+        else
+        {
+            c = c + 4 * (a - b) + 10;
+            b -= 1;
+        }
+        a += 1;
+    }
+    if(a == b) Test_CirclePoints(X, Y, a, b, fc);
+}
+
+typedef struct
+{
+    uint16_t x, y, r;
+} Test_Circle_t;
+
+static const Test_Circle_t test_circles[] =
+{
+    {  64,  80,  30 },
+    {  64,  80,   0 },
+    {  64,  80,   1 },
+    {   5,  80,  20 },      // 伸出左边
+    { 120, 150,  25 },      // 伸出右下角
+    {   0,   0,  12 },
+    {  64,  80, 100 },      // 比屏幕大
+};
+
+/**
+ * @brief  随机直线（包括水平、垂直和伸出屏幕的端点）和各种位置的空心圆
+ * @param  ref: 1=用改写前的逐点画法
+ */
+static void Test_LineScene(uint8_t ref)
+{
+    uint16_t x0, y0, x1, y1, color;
+    size_t i;
+
+    test_seed = 1;
+    for(i = 0; i < TEST_LINES; i++)
+    {
+        x0 = Test_Rand(X_MAX_PIXEL + 20);
+        y0 = Test_Rand(Y_MAX_PIXEL + 20);
+        x1 = (i % 8 == 1) ? x0 : Test_Rand(X_MAX_PIXEL + 20);
+        y1 = (i % 8 == 0) ? y0 : Test_Rand(Y_MAX_PIXEL + 20);
+        color = Test_Rand(0xFFFF);
+        if(ref) Test_LineRef(x0, y0, x1, y1, color);
+        else Gui_DrawLine(x0, y0, x1, y1, color);
+    }
+
+    for(i = 0; i < sizeof(test_circles) / sizeof(test_circles[0]); i++)
+    {
+        color = (uint16_t)(RED >> i);
+        if(ref) Test_CircleRef(test_circles[i].x, test_circles[i].y, test_circles[i].r, color);
+        else Gui_Circle(test_circles[i].x, test_circles[i].y, test_circles[i].r, color);
+    }
+}
+
+static void Test_LinesDraw(void)    { Test_LineScene(0); }
+static void Test_LinesRef(void)     { Test_LineScene(1); }
+
+/**
+ * @brief  合并成水平/垂直段的直线和空心圆与改写前的逐点输出比较
+ */
+static int Test_Lines(void)
+{
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+
+    return Test_Compare("lines and circles", Test_LinesDraw, Test_LinesRef);
+}
+
+/*---------------------------------------------------图片----------------------------------------------------*/
+
+#define TEST_IMG_W          23      // 奇数宽度：1/2/4位索引的行尾不是整字节
+#define TEST_IMG_H          13
+#define TEST_IMG_PIXELS     (64 * 64)
+
+typedef struct
+{
+    uint8_t format;         // GUI_IMAGE_*
+    uint8_t bpp;            // 索引位数；行程编码为8（调色板索引）或16（RGB565）；原始格式为16
+    uint8_t be;             // 1=高字节在前
+} Test_ImageFormat_t;
+
+static const Test_ImageFormat_t test_image_formats[] =
+{
+    { GUI_IMAGE_RAW,     16, 0 },
+    { GUI_IMAGE_RAW,     16, 1 },
+    { GUI_IMAGE_INDEXED,  1, 0 },
+    { GUI_IMAGE_INDEXED,  2, 0 },
+    { GUI_IMAGE_INDEXED,  4, 0 },
+    { GUI_IMAGE_INDEXED,  8, 0 },
+    { GUI_IMAGE_INDEXED,  2, 1 },
+    { GUI_IMAGE_RLE,     16, 0 },
+    { GUI_IMAGE_RLE,     16, 1 },
+    { GUI_IMAGE_RLE,      8, 0 },
+};
+
+typedef struct
+{
+    uint16_t x, y;                  // 图片左上角
+    uint16_t cx, cy, cw, ch;        // 裁剪区，cw=0时不裁剪（只被屏幕裁剪）
+} Test_Place_t;
+
+static const Test_Place_t test_places[] =
+{
+    {   4,   4,   0,   0,   0,   0 },
+    { 110, 150,   0,   0,   0,   0 },     // 被屏幕右下角裁剪
+    {  35,  25,  40,  30,  40,  40 },     // 裁掉左边和上边
+    {  45,  82,  40,  80,  15,   8 },     // 裁掉右边和下边
+    {  64, 110,  70, 115,   8,   3 },     // 四边都裁掉
+};
+
+static const uint8_t *test_image;
+static uint16_t test_image_px[TEST_IMG_PIXELS];    // 期望的像素（按行）
+static uint8_t test_image_buf[8 + 2 + 2 * 256 + 2 * TEST_IMG_W * TEST_IMG_H * 2];
+
+static uint16_t Test_Rd16(const uint8_t *p, uint8_t be)
+{
+    return (uint16_t)(be ? ((p[0] << 8) | p[1]) : (p[0] | (p[1] << 8)));
+}
+
+static uint8_t *Test_Wr16(uint8_t *p, uint16_t v, uint8_t be)
+{
+    p[be ? 1 : 0] = (uint8_t)v;
+    p[be ? 0 : 1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+/**
+ * @brief  按GUI.h中的格式说明把合成图片编码到test_image_buf，期望像素写入test_image_px
+ * @note   第2~8行同一种颜色：跨行的长行程超过128个像素，要拆成多个重复包
+ */
+static void Test_ImageEncode(const Test_ImageFormat_t *f)
+{
+    uint8_t idx[TEST_IMG_W * TEST_IMG_H];
+    uint16_t pal[16];
+    uint16_t colors = (f->format == GUI_IMAGE_INDEXED && f->bpp < 4) ? (uint16_t)(1u << f->bpp) : 16;
+    uint16_t x, y, stride;
+    uint32_t i, j, n, total = TEST_IMG_W * TEST_IMG_H;
+    uint8_t *p = test_image_buf;
+    uint8_t step = (f->bpp == 8) ? 1 : 2;
+
+    for(i = 0; i < colors; i++) pal[i] = (uint16_t)((i + 1) * 0x1357 ^ (i << 11));
+    for(y = 0; y < TEST_IMG_H; y++)
+    {
+        for(x = 0; x < TEST_IMG_W; x++)
+        {
+            i = (uint32_t)y * TEST_IMG_W + x;
+            idx[i] = (y >= 2 && y <= 8) ? 0 : (uint8_t)((x / 5 + y / 3 + (x * y) % 3) % colors);
+            test_image_px[i] = pal[idx[i]];
+        }
+    }
+
+    memset(test_image_buf, 0, sizeof(test_image_buf));
+    p[0] = f->be ? GUI_IMAGE_BIG_ENDIAN : 0;
+    p[1] = f->bpp;
+    p[2] = TEST_IMG_W;
+    p[4] = TEST_IMG_H;
+    p[6] = 1;
+    p[7] = f->format;
+    p += 8;
+
+    if(f->format == GUI_IMAGE_RAW)
+    {
+        for(i = 0; i < total; i++) p = Test_Wr16(p, test_image_px[i], f->be);
+        return;
+    }
+    if(f->bpp != 16)
+    {
+        *p++ = (uint8_t)(colors - 1);
+        for(i = 0; i < colors; i++) p = Test_Wr16(p, pal[i], f->be);
+    }
+
+    if(f->format == GUI_IMAGE_INDEXED)
+    {
+        stride = (TEST_IMG_W * f->bpp + 7) / 8;
+        for(y = 0; y < TEST_IMG_H; y++)
+            for(x = 0; x < TEST_IMG_W; x++)
+                p[y * stride + x * f->bpp / 8] |= (uint8_t)(idx[y * TEST_IMG_W + x] << (8 - f->bpp - x * f->bpp % 8));
+        return;
+    }
+
+    // 行程编码：2个以上相同像素为重复包，其余攒成原样包，每包最多128个像素
+    for(i = 0; i < total; i += n)
+    {
+        for(n = 1; i + n < total && n < 128 && idx[i + n] == idx[i]; n++);
+        if(n >= 2)
+        {
+            *p++ = (uint8_t)(0x7F + n);
+            if(step == 1) *p++ = idx[i];
+            else p = Test_Wr16(p, test_image_px[i], f->be);
+            continue;
+        }
+        for(n = 1; i + n < total && n < 128 && !(i + n + 1 < total && idx[i + n + 1] == idx[i + n]); n++);
+        *p++ = (uint8_t)(n - 1);
+        for(j = i; j < i + n; j++)
+        {
+            if(step == 1) *p++ = idx[j];
+            else p = Test_Wr16(p, test_image_px[j], f->be);
+        }
+    }
+}
+
+/**
+ * @brief  独立于GUI.c的逐像素解码，用来检查资源生成的图片
+ * @return 0=格式正确且不超过test_image_px
+ */
+static int Test_ImageDecode(const uint8_t *img)
+{
+    uint16_t w = img[2] | (img[3] << 8), h = img[4] | (img[5] << 8);
+    uint8_t be = img[0] & GUI_IMAGE_BIG_ENDIAN, bpp = img[1];
+    const uint8_t *pal = img + 9, *src;
+    uint32_t i, n, total = (uint32_t)w * h;
+    uint16_t x, y, stride;
+    uint8_t ctrl, bit;
+
+    if(total > TEST_IMG_PIXELS) return 1;
+
+    switch(img[7])
+    {
+        case GUI_IMAGE_INDEXED:
+            if(bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return 1;
+            src = pal + 2 * (img[8] + 1);
+            stride = (uint16_t)((w * bpp + 7) / 8);
+            for(y = 0; y < h; y++)
+            {
+                for(x = 0; x < w; x++)
+                {
+                    bit = (uint8_t)(x * bpp % 8);
+                    n = (src[y * stride + x * bpp / 8] >> (8 - bpp - bit)) & ((1u << bpp) - 1);
+                    test_image_px[y * w + x] = Test_Rd16(pal + 2 * n, be);
+                }
+            }
+            return 0;
+
+        case GUI_IMAGE_RLE:
+            if(bpp == 8) src = pal + 2 * (img[8] + 1);
+            else
+            {
+                pal = NULL;
+                src = img + 8;
+            }
+            for(i = 0; i < total; )
+            {
+                ctrl = *src++;
+                n = (ctrl & 0x80) ? ctrl - 0x7Fu : ctrl + 1u;
+                while(n-- && i < total)
+                {
+                    test_image_px[i++] = pal ? Test_Rd16(pal + 2 * src[0], be) : Test_Rd16(src, be);
+                    if(!(ctrl & 0x80)) src += pal ? 1 : 2;
+                }
+                if(ctrl & 0x80) src += pal ? 1 : 2;
+            }
+            return 0;
+
+        default:
+            for(i = 0; i < total; i++) test_image_px[i] = Test_Rd16(img + 8 + 2 * i, be);
+            return 0;
+    }
+}
+
+static void Test_ImageDraw(void)
+{
+    const Test_Place_t *p;
+    size_t i;
+
+    for(i = 0; i < sizeof(test_places) / sizeof(test_places[0]); i++)
+    {
+        p = &test_places[i];
+        if(p->cw) Gui_PushClip(p->cx, p->cy, p->cw, p->ch);
+        Gui_DrawImage(p->x, p->y, test_image);
+        if(p->cw) Gui_PopClip();
+    }
+}
+
+// 期望的像素逐点画，只画裁剪区内的
+static void Test_ImageRef(void)
+{
+    uint16_t w = test_image[2] | (test_image[3] << 8), h = test_image[4] | (test_image[5] << 8);
+    const Test_Place_t *p;
+    uint16_t x, y, px, py;
+    size_t i;
+
+    for(i = 0; i < sizeof(test_places) / sizeof(test_places[0]); i++)
+    {
+        p = &test_places[i];
+        for(y = 0; y < h; y++)
+        {
+            for(x = 0; x < w; x++)
+            {
+                px = p->x + x;
+                py = p->y + y;
+                if(p->cw && (px < p->cx || px >= p->cx + p->cw || py < p->cy || py >= p->cy + p->ch)) continue;
+                Gui_DrawPoint(px, py, test_image_px[y * w + x]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief  每种格式的合成图片和资源中的图片在各种裁剪下与期望像素逐像素比较
+ */
+static int Test_Images(void)
+{
+    static const struct { const char *name; const uint8_t *data; } assets[] =
+    {
+        { "gImage_humo_nei", gImage_humo_nei },
+        { "gImage_temp_nei", gImage_temp_nei },
+        { "gImage_temp_wai", gImage_temp_wai },
+        { "gImage_1",        gImage_1 },
+    };
+    const Test_ImageFormat_t *f;
+    char what[64];
+    size_t i;
+    int fail = 0;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+
+    test_image = test_image_buf;
+    for(i = 0; i < sizeof(test_image_formats) / sizeof(test_image_formats[0]); i++)
+    {
+        f = &test_image_formats[i];
+        Test_ImageEncode(f);
+        snprintf(what, sizeof(what), "image format 0x%02X %u-bit%s", f->format, f->bpp, f->be ? " big-endian" : "");
+        fail |= Test_Compare(what, Test_ImageDraw, Test_ImageRef);
+    }
+
+    for(i = 0; i < sizeof(assets) / sizeof(assets[0]); i++)
+    {
+        test_image = assets[i].data;
+        if(Test_ImageDecode(test_image))
+        {
+            fprintf(stderr, "%s: unsupported header\n", assets[i].name);
+            fail = 1;
+            continue;
+        }
+        fail |= Test_Compare(assets[i].name, Test_ImageDraw, Test_ImageRef);
+    }
+    return fail;
+}
+
+/*---------------------------------------------------填充图形----------------------------------------------------*/
+
+typedef enum { SHAPE_FILL_CIRCLE, SHAPE_ROUND_RECT, SHAPE_ARC, SHAPE_GAUGE } Test_ShapeKind_t;
+
+typedef struct
+{
+    uint8_t kind;               // Test_ShapeKind_t
+    uint16_t x, y;              // 圆心；圆角矩形为左上角
+    uint16_t r;                 // 外半径；圆角矩形为圆角半径
+    uint16_t w, h;              // 圆角矩形的宽高
+    uint16_t thick;             // 环宽
+    int16_t start;              // 起始角度
+    uint16_t sweep;             // 跨过的角度
+    uint16_t value;             // 仪表的数值，满刻度100
+} Test_Shape_t;
+
+static const Test_Shape_t test_shapes[] =
+{
+    { SHAPE_FILL_CIRCLE,  64,  80,  30,   0,  0,  0,    0,   0,   0 },
+    { SHAPE_FILL_CIRCLE,  64,  80,   0,   0,  0,  0,    0,   0,   0 },
+    { SHAPE_FILL_CIRCLE,  64,  80,   1,   0,  0,  0,    0,   0,   0 },
+    { SHAPE_FILL_CIRCLE,   0,   0,  10,   0,  0,  0,    0,   0,   0 },
+    { SHAPE_FILL_CIRCLE, 127, 159,   7,   0,  0,  0,    0,   0,   0 },
+    { SHAPE_FILL_CIRCLE,  64,  80,  90,   0,  0,  0,    0,   0,   0 },   // 比屏幕大
+    { SHAPE_ROUND_RECT,   14,  60,   8, 100, 40,  0,    0,   0,   0 },
+    { SHAPE_ROUND_RECT,    0,   0,  20,  30, 30,  0,    0,   0,   0 },   // 圆角减小到14
+    { SHAPE_ROUND_RECT,   10, 100,   3,  25,  7,  0,    0,   0,   0 },
+    { SHAPE_ROUND_RECT,  100, 140,   6,  40, 30,  0,    0,   0,   0 },   // 伸出屏幕
+    { SHAPE_ROUND_RECT,   50,  50,   3,   1,  1,  0,    0,   0,   0 },
+    { SHAPE_ARC,          64,  80,  30,   0,  0,  6,  225, 270,   0 },
+    { SHAPE_ARC,          64,  80,  40,   0,  0,  1,    0, 360,   0 },
+    { SHAPE_ARC,          30,  40,  25,   0,  0, 10,   30, 100,   0 },
+    { SHAPE_ARC,          64,  80,  50,   0,  0,  5,  -45,  90,   0 },
+    { SHAPE_ARC,         100, 120,  20,   0,  0, 21,  300, 200,   0 },   // 实心扇形，大于半圆
+    { SHAPE_ARC,          64,  80,  20,   0,  0, 25,   90, 180,   0 },   // 实心半圆
+    { SHAPE_ARC,           5, 150,  20,   0,  0,  8,   90, 180,   0 },   // 伸出屏幕
+    { SHAPE_GAUGE,        64,  80,  30,   0,  0,  6,  225, 270,  62 },
+    { SHAPE_GAUGE,        64,  80,  30,   0,  0,  6,  225, 270,   0 },
+    { SHAPE_GAUGE,        64,  80,  30,   0,  0,  6,  225, 270, 150 },   // 超过满刻度
+    { SHAPE_GAUGE,        64,  80,  45,   0,  0, 12,    0, 360,  40 },
+};
+
+static const Test_Shape_t *test_shape;
+
+#define TEST_PI             3.14159265358979323846
+
+/**
+ * @brief  双精度参考：点(dx,dy)是否在外半径R、宽thick的圆环的扇形[start, start+sweep)内
+ * @note   圆环为到圆心距离小于R+0.5、且不小于内半径R+1-thick减0.5的像素；
+ *         圆心本身没有方向，按Gui_Arc的半平面判断，只在大于半圆的扇形内
+ */
+static uint8_t Test_InRing(int dx, int dy, int R, int thick, int start, int sweep)
+{
+    int32_t d2 = dx * dx + dy * dy, ri = (thick > R) ? 0 : R + 1 - thick;
+    double a;
+
+    if(sweep <= 0 || thick <= 0) return 0;
+    if(d2 > R * R + R) return 0;
+    if(ri > 0 && d2 <= ri * ri - ri) return 0;
+    if(sweep >= 360) return 1;
+    if(dx == 0 && dy == 0) return sweep > 180;
+
+    a = atan2(dx, -dy) * 180.0 / TEST_PI - start;      // 0=12点方向，顺时针（屏幕y向下）
+    a = fmod(fmod(a, 360.0) + 360.0, 360.0);
+    if(a > 360.0 - 1e-9) a = 0.0;
+    return a < sweep - 1e-9;
+}
+
+static void Test_ShapeDraw(void)
+{
+    const Test_Shape_t *s = test_shape;
+
+    switch(s->kind)
+    {
+        case SHAPE_FILL_CIRCLE: Gui_FillCircle(s->x, s->y, s->r, RED); break;
+        case SHAPE_ROUND_RECT:  Gui_FillRoundRect(s->x, s->y, s->w, s->h, s->r, BLUE); break;
+        case SHAPE_ARC:         Gui_Arc(s->x, s->y, s->r, s->thick, s->start, s->sweep, GREEN); break;
+        default:                Gui_Gauge(s->x, s->y, s->r, s->thick, s->start, s->sweep, s->value, 100, BLUE, GRAY2); break;
+    }
+}
+
+static void Test_ShapeRef(void)
+{
+    const Test_Shape_t *s = test_shape;
+    int x, y, cx, cy, r = s->r, x1 = s->x + s->w - 1, y1 = s->y + s->h - 1;
+    int split = (int)s->sweep * ((s->value > 100) ? 100 : s->value) / 100;
+    int side = (s->w < s->h) ? s->w : s->h;
+
+    if(s->kind == SHAPE_ROUND_RECT)
+    {
+        if(side > 0 && r > (side - 1) / 2) r = (side - 1) / 2;
+        for(y = s->y; y <= y1; y++)
+        {
+            for(x = s->x; x <= x1; x++)
+            {
+                cx = (x < s->x + r) ? s->x + r : (x > x1 - r) ? x1 - r : x;    // 最近的圆角圆心
+                cy = (y < s->y + r) ? s->y + r : (y > y1 - r) ? y1 - r : y;
+                if((x - cx) * (x - cx) + (y - cy) * (y - cy) <= r * r + r) Gui_DrawPoint(x, y, BLUE);
+            }
+        }
+        return;
+    }
+
+    for(y = s->y - r; y <= s->y + r; y++)
+    {
+        for(x = s->x - r; x <= s->x + r; x++)
+        {
+            switch(s->kind)
+            {
+                case SHAPE_FILL_CIRCLE:
+                    if(Test_InRing(x - s->x, y - s->y, r, r + 1, 0, 360)) Gui_DrawPoint(x, y, RED);
+                    break;
+                case SHAPE_ARC:
+                    if(Test_InRing(x - s->x, y - s->y, r, s->thick, s->start, s->sweep)) Gui_DrawPoint(x, y, GREEN);
+                    break;
+                default:
+                    if(Test_InRing(x - s->x, y - s->y, r, s->thick, s->start, split)) Gui_DrawPoint(x, y, BLUE);
+                    else if(Test_InRing(x - s->x, y - s->y, r, s->thick, s->start + split, s->sweep - split)) Gui_DrawPoint(x, y, GRAY2);
+                    break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief  按水平段输出的填充图形与双精度的几何定义逐像素比较
+ */
+static int Test_Shapes(void)
+{
+    static const char *const kinds[] = { "Gui_FillCircle", "Gui_FillRoundRect", "Gui_Arc", "Gui_Gauge" };
+    char what[80];
+    size_t i;
+    int fail = 0;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+
+    for(i = 0; i < sizeof(test_shapes) / sizeof(test_shapes[0]); i++)
+    {
+        test_shape = &test_shapes[i];
+        snprintf(what, sizeof(what), "%s #%u", kinds[test_shape->kind], (unsigned)i);
+        fail |= Test_Compare(what, Test_ShapeDraw, Test_ShapeRef);
+    }
+    return fail;
+}
+
+/*---------------------------------------------------硬件滚动----------------------------------------------------*/
+
+static const uint16_t test_scroll_areas[][2] =     // {y, h}
+{
+    { 144,  16 },       // 底部滚动条，到最后一行为止
+    {   0, 160 },       // 整屏
+    { 112,  16 },
+    {  20,  50 },
+    {   0,   1 },
+};
+
+static const int16_t test_scroll_steps[] = { 1, 7, -3, 80, -1 };
+
+static uint16_t test_mem[Y_MAX_PIXEL][X_MAX_PIXEL];    // 偏移为0时各行的内容
+static uint16_t test_scroll_y, test_scroll_h, test_scroll_off;
+
+// 屏幕行y当前显示的是test_mem中的哪一行
+static uint16_t Test_MemRow(uint16_t y)
+{
+    if(y < test_scroll_y || y >= test_scroll_y + test_scroll_h) return y;
+    return test_scroll_y + (y - test_scroll_y + test_scroll_off) % test_scroll_h;
+}
+
+// 期望中在屏幕坐标画一个像素
+static void Test_MemPut(uint16_t x, uint16_t y, uint16_t color)
+{
+    if(x < X_MAX_PIXEL && y < Y_MAX_PIXEL) test_mem[Test_MemRow(y)][x] = color;
+}
+
+/**
+ * @brief  屏幕上每个像素与期望比较，模型不能有协议错误或越界像素
+ * @return 0=一致
+ */
+static int Test_ScrollCheck(const char *what)
+{
+    const Sim_Stats_t *s = Sim_GetStats();
+    uint16_t x, y, c, e;
+    uint32_t diff = 0;
+
+    Lcd_Flush();
+    LCD_Pipe_Drain();
+    for(y = 0; y < Y_MAX_PIXEL; y++)
+    {
+        for(x = 0; x < X_MAX_PIXEL; x++)
+        {
+            c = Sim_GetPixel(x, y);
+            e = test_mem[Test_MemRow(y)][x];
+            if(c == e) continue;
+            if(diff == 0)
+                fprintf(stderr, "%s (area %u+%u, offset %u): pixel (%u, %u) is %04X, expected %04X\n",
+                        what, test_scroll_y, test_scroll_h, test_scroll_off, x, y, c, e);
+            diff++;
+        }
+    }
+    if(diff) fprintf(stderr, "%s: %u pixels differ\n", what, (unsigned)diff);
+    if(s->errors || s->oob_pixels)
+    {
+        fprintf(stderr, "%s (area %u+%u): %u protocol errors, %u out-of-range pixels\n",
+                what, test_scroll_y, test_scroll_h, s->errors, s->oob_pixels);
+        return 1;
+    }
+    return diff != 0;
+}
+
+/**
+ * @brief  跨过滚动区上下边界和回绕点画一个矩形、一个像素窗口和一个字符
+ * @param  tag: 颜色种子，每次画的内容不同
+ */
+static void Test_ScrollDraw(uint16_t tag)
+{
+    uint16_t wrap = test_scroll_y + (test_scroll_h - test_scroll_off) % test_scroll_h;    // 显示test_mem第一行的屏幕行
+    uint16_t ys = (test_scroll_y >= 3) ? test_scroll_y - 3 : 0;
+    uint16_t ye = (test_scroll_y + test_scroll_h + 2 < Y_MAX_PIXEL) ? test_scroll_y + test_scroll_h + 2 : Y_MAX_PIXEL - 1;
+    uint16_t color = (uint16_t)(0x1111 * (tag % 14 + 1)), x, y, r, c, *buf;     // 不会是WHITE（字符前景色）
+    uint32_t i, n;
+
+    // 矩形：从滚动区上面3行到下面3行
+    Lcd_FillRect(8, ys, 30, ye - ys + 1, color);
+    for(y = ys; y <= ye; y++)
+        for(x = 8; x < 38; x++) Test_MemPut(x, y, color);
+
+    // 像素窗口：回绕点上下各3行，每个像素不同
+    ys = (wrap >= 3) ? wrap - 3 : 0;
+    ye = (wrap + 3 < Y_MAX_PIXEL) ? wrap + 3 : Y_MAX_PIXEL - 1;
+    Lcd_BeginWindow(50, ys, 65, ye);
+    n = (uint32_t)16 * (ye - ys + 1);
+    for(i = 0; i < n; )
+    {
+        buf = Lcd_AcquirePixels();
+        for(c = 0; c < LCD_PIPE_BUF_PIXELS && i < n; c++, i++)
+        {
+            buf[c] = (uint16_t)(i * 37 + tag);
+            Test_MemPut(50 + i % 16, ys + i / 16, buf[c]);
+        }
+        Lcd_CommitPixels(buf, c);
+    }
+    Lcd_EndWindow();
+
+    // 字符：跨过回绕点
+    y = (wrap >= 8) ? wrap - 8 : 0;
+    if(y > Y_MAX_PIXEL - 16) y = Y_MAX_PIXEL - 16;
+    Gui_DrawAsciiChar(90, y, WHITE, color, (char)('A' + tag % 26));
+    for(r = 0; r < 16; r++)
+        for(c = 0; c < 8; c++)
+            Test_MemPut(90 + c, y + r, (ascii_font['A' + tag % 26 - 0x20][r] & (0x80 >> c)) ? WHITE : color);
+}
+
+/**
+ * @brief  各种滚动区（包括到最后一行为止的）滚动后，屏幕与期望逐像素比较；
+ *         跨过滚动区边界和回绕点画的内容随后续滚动一起移动
+ */
+static int Test_Scroll(void)
+{
+    char what[48];
+    size_t a, k;
+    uint16_t x, y, tag = 0;
+    int fail = 0;
+
+    Sim_PowerOn();
+    Lcd_Init();
+    LCD_SetTransport(&LCD_Transport_SoftSPI);
+    Gui_ResetClip();
+
+    for(a = 0; a < sizeof(test_scroll_areas) / sizeof(test_scroll_areas[0]); a++)
+    {
+        // 每行一种颜色
+        test_scroll_y = test_scroll_h = test_scroll_off = 0;
+        for(y = 0; y < Y_MAX_PIXEL; y++)
+        {
+            Lcd_FillRect(0, y, X_MAX_PIXEL, 1, (uint16_t)(0x8000 | (y * 97 + a)));
+            for(x = 0; x < X_MAX_PIXEL; x++) test_mem[y][x] = (uint16_t)(0x8000 | (y * 97 + a));
+        }
+
+        if(!Lcd_ScrollArea(test_scroll_areas[a][0], test_scroll_areas[a][1]))
+        {
+            fprintf(stderr, "Lcd_ScrollArea(%u, %u) rejected\n", test_scroll_areas[a][0], test_scroll_areas[a][1]);
+            fail = 1;
+            continue;
+        }
+        test_scroll_y = test_scroll_areas[a][0];
+        test_scroll_h = test_scroll_areas[a][1];
+        fail |= Test_ScrollCheck("set area");
+
+        for(k = 0; k < sizeof(test_scroll_steps) / sizeof(test_scroll_steps[0]); k++)
+        {
+            Lcd_Scroll(test_scroll_steps[k]);
+            test_scroll_off = (uint16_t)((test_scroll_off + test_scroll_h * 2 + test_scroll_steps[k] % test_scroll_h) % test_scroll_h);
+            if(Lcd_ScrollOffset() != test_scroll_off)
+            {
+                fprintf(stderr, "Lcd_ScrollOffset() is %u, expected %u\n", Lcd_ScrollOffset(), test_scroll_off);
+                fail = 1;
+            }
+            snprintf(what, sizeof(what), "scroll %d", test_scroll_steps[k]);
+            fail |= Test_ScrollCheck(what);
+
+            Test_ScrollDraw(tag++);
+            snprintf(what, sizeof(what), "draw after scroll %d", test_scroll_steps[k]);
+            fail |= Test_ScrollCheck(what);
+        }
+
+        // 关闭滚动：先滚回偏移0，屏幕上的内容回到设置时的位置
+        Lcd_ScrollArea(0, 0);
+        test_scroll_off = 0;
+        fail |= Test_ScrollCheck("scroll off");
+        test_scroll_y = test_scroll_h = 0;
+    }
+    return fail;
+}
+
+/*---------------------------------------------------主程序----------------------------------------------------*/
+
+static const Test_Case_t test_cases[] =
+{
+    { "transport_mock",     Test_TransportMock },
+    { "fill_rect",          Test_FillRect },
+    { "glyphs",             Test_Glyphs },
+    { "lines",              Test_Lines },
+    { "images",             Test_Images },
+    { "shapes",             Test_Shapes },
+    { "scroll",             Test_Scroll },
+};
+
+#define TEST_CASES      (sizeof(test_cases) / sizeof(test_cases[0]))
+
+static int Test_Run(const Test_Case_t *t)
+{
+    int fail = t->run();
+
+    printf("%s %s\n", fail ? "FAIL" : "PASS", t->name);
+    return fail ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    size_t i;
+    int k, found, fail = 0;
+
+    if(argc < 2)
+    {
+        for(i = 0; i < TEST_CASES; i++) fail |= Test_Run(&test_cases[i]);
+        return fail;
+    }
+
+    for(k = 1; k < argc; k++)
+    {
+        found = 0;
+        for(i = 0; i < TEST_CASES; i++)
+        {
+            if(strcmp(argv[k], test_cases[i].name) == 0)
+            {
+                fail |= Test_Run(&test_cases[i]);
+                found = 1;
+            }
+        }
+        if(!found)
+        {
+            fprintf(stderr, "unknown test case: %s\n", argv[k]);
+            fail = 1;
+        }
+    }
+    return fail;
+}
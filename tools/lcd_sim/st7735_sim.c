@@ -0,0 +1,381 @@
+/**
+ ******************************************************************************
+ * @file           : st7735_sim.c
+ * @brief          : 主机端ST7735模型实现
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 串行接口按4线SPI模式0/3解码：CS为低时在SCL上升沿采样SDA，MSB先，
+ * 第8位采样时同时采样DC决定是命令还是数据；CS拉高复位位计数。
+ * 引脚定义直接取自lcd_Driver.h，和固件保持一致。
+ ******************************************************************************
+ */
+
+#include "st7735_sim.h"
+#include "lcd_Driver.h"
+#include <stdio.h>
+#include <string.h>
+
+// (dc,byte)流哈希，与lcd_Mock.c相同
+#define FNV_OFFSET          2166136261u
+#define FNV_PRIME           16777619u
+
+// MADCTL位
+#define MADCTL_MY           0x80
+#define MADCTL_MX           0x40
+#define MADCTL_MV           0x20
+#define MADCTL_BGR          0x08
+
+static uint16_t sim_gram[SIM_GRAM_H][SIM_GRAM_W];   // 物理显存（RGB565，按物理地址存放）
+
+static struct
+{
+    uint8_t  sleep;         // 1=睡眠（复位后）
+    uint8_t  display_on;
+    uint8_t  inverted;      // INVON
+    uint8_t  backlight;     // BLK引脚
+    uint8_t  madctl;
+    uint8_t  colmod;
+
+    uint8_t  cmd;           // 当前命令
+    uint8_t  param[6];
+    uint8_t  nparam;
+
+    uint16_t xs, xe, ys, ye;    // CASET/RASET窗口
+    uint16_t cx, cy;            // RAMWR写指针
+    uint8_t  px[3];             // 正在拼接的像素字节
+    uint8_t  npx;
+
+    uint8_t  scroll;        // 1=滚动模式（VSCSAD之后，NORON退出）
+    uint16_t tfa, vsa, bfa; // VSCRDEF：上固定区/滚动区/下固定区行数（物理显示行）
+    uint16_t ssa;           // VSCSAD：滚动区第一行显示的显存行
+
+    uint8_t  shift;         // 移位寄存器
+    uint8_t  bits;
+} sim;
+
+static Sim_Stats_t sim_stats;
+
+/*---------------------------------------------------显存----------------------------------------------------*/
+
+/**
+ * @brief  控制器地址(列,行)按MADCTL映射到物理显存
+ * @return 1=在显存内
+ */
+static int Sim_Map(uint16_t c, uint16_t r, uint8_t madctl, uint16_t *pc, uint16_t *pr)
+{
+    uint16_t t;
+
+    if(madctl & MADCTL_MV)
+    {
+        t = c;
+        c = r;
+        r = t;
+    }
+    if(c >= SIM_GRAM_W || r >= SIM_GRAM_H) return 0;
+    if(madctl & MADCTL_MX) c = SIM_GRAM_W - 1 - c;
+    if(madctl & MADCTL_MY) r = SIM_GRAM_H - 1 - r;
+    *pc = c;
+    *pr = r;
+    return 1;
+}
+
+/**
+ * @brief  写一个像素并移动写指针（列地址先递增，行尾换行，窗口末尾回到起点）
+ */
+static void Sim_WritePixel(uint16_t color)
+{
+    uint16_t pc, pr;
+
+    if(sim.sleep) sim_stats.sleep_pixels++;
+
+    // 显存中统一按RGB顺序保存，BGR位在快照时处理
+    if(Sim_Map(sim.cx, sim.cy, sim.madctl, &pc, &pr))
+    {
+        sim_gram[pr][pc] = color;
+        sim_stats.pixels++;
+    }
+    else
+    {
+        sim_stats.oob_pixels++;
+    }
+
+    if(++sim.cx > sim.xe)
+    {
+        sim.cx = sim.xs;
+        if(++sim.cy > sim.ye)
+            sim.cy = sim.ys;
+    }
+}
+
+/*---------------------------------------------------命令解码----------------------------------------------------*/
+
+static void Sim_PanelReset(void)
+{
+    sim.sleep = 1;
+    sim.display_on = 0;
+    sim.inverted = 0;
+    sim.madctl = 0x00;
+    sim.colmod = 0x06;      // 复位默认18位
+    sim.cmd = 0x00;
+    sim.nparam = 0;
+    sim.xs = 0;
+    sim.xe = SIM_GRAM_W - 1;
+    sim.ys = 0;
+    sim.ye = SIM_GRAM_H - 1;
+    sim.npx = 0;
+    sim.scroll = 0;
+    sim.tfa = 0;
+    sim.vsa = SIM_GRAM_H;
+    sim.bfa = 0;
+    sim.ssa = 0;
+    sim_stats.resets++;
+}
+
+static void Sim_Command(uint8_t cmd)
+{
+    sim_stats.commands++;
+    sim_stats.cmd_bytes++;
+    sim.cmd = cmd;
+    sim.nparam = 0;
+
+    switch(cmd)
+    {
+        case 0x01: Sim_PanelReset(); break;     // SWRESET
+        case 0x10: sim.sleep = 1; break;        // SLPIN
+        case 0x11: sim.sleep = 0; break;        // SLPOUT
+        case 0x13: sim.scroll = 0; break;       // NORON：退出滚动模式
+        case 0x20: sim.inverted = 0; break;     // INVOFF
+        case 0x21: sim.inverted = 1; break;     // INVON
+        case 0x28: sim.display_on = 0; break;   // DISPOFF
+        case 0x29: sim.display_on = 1; break;   // DISPON
+        case 0x2C:                              // RAMWR：写指针回到窗口起点
+            sim.cx = sim.xs;
+            sim.cy = sim.ys;
+            sim.npx = 0;
+            sim_stats.windows++;
+            break;
+        default: break;
+    }
+}
+
+static void Sim_PixelByte(uint8_t b)
+{
+    sim_stats.pixel_bytes++;
+    sim.px[sim.npx++] = b;
+
+    if(sim.colmod == 0x05)
+    {
+        if(sim.npx == 2)
+        {
+            Sim_WritePixel((uint16_t)(sim.px[0] << 8) | sim.px[1]);
+            sim.npx = 0;
+        }
+    }
+    else if(sim.colmod == 0x06)
+    {
+        // 18位：每字节高6位有效，转换为RGB565保存
+        if(sim.npx == 3)
+        {
+            Sim_WritePixel((uint16_t)(((sim.px[0] & 0xF8) << 8) | ((sim.px[1] & 0xFC) << 3) | (sim.px[2] >> 3)));
+            sim.npx = 0;
+        }
+    }
+    else
+    {
+        sim_stats.errors++;
+        sim.npx = 0;
+    }
+}
+
+static void Sim_Data(uint8_t b)
+{
+    if(sim.cmd == 0x2C)
+    {
+        Sim_PixelByte(b);
+        return;
+    }
+
+    sim_stats.param_bytes++;
+    if(sim.nparam < sizeof(sim.param))
+        sim.param[sim.nparam] = b;
+    sim.nparam++;
+
+    switch(sim.cmd)
+    {
+        case 0x2A:                              // CASET
+            if(sim.nparam == 4)
+            {
+                sim.xs = (uint16_t)(sim.param[0] << 8) | sim.param[1];
+                sim.xe = (uint16_t)(sim.param[2] << 8) | sim.param[3];
+            }
+            break;
+        case 0x2B:                              // RASET
+            if(sim.nparam == 4)
+            {
+                sim.ys = (uint16_t)(sim.param[0] << 8) | sim.param[1];
+                sim.ye = (uint16_t)(sim.param[2] << 8) | sim.param[3];
+            }
+            break;
+        case 0x33:                              // VSCRDEF
+            if(sim.nparam == 6)
+            {
+                sim.tfa = (uint16_t)(sim.param[0] << 8) | sim.param[1];
+                sim.vsa = (uint16_t)(sim.param[2] << 8) | sim.param[3];
+                sim.bfa = (uint16_t)(sim.param[4] << 8) | sim.param[5];
+                if(sim.tfa + sim.vsa + sim.bfa != SIM_GRAM_H || sim.vsa == 0)
+                    sim_stats.errors++;     // 三段之和必须等于显存行数
+            }
+            break;
+        case 0x37:                              // VSCSAD
+            if(sim.nparam == 2)
+            {
+                sim.ssa = (uint16_t)(sim.param[0] << 8) | sim.param[1];
+                sim.scroll = 1;
+                if(sim.ssa < sim.tfa || sim.ssa >= sim.tfa + sim.vsa)
+                    sim_stats.errors++;     // 起始地址必须在滚动区内
+            }
+            break;
+        case 0x36:                              // MADCTL
+            if(sim.nparam == 1) sim.madctl = b;
+            break;
+        case 0x3A:                              // COLMOD
+            if(sim.nparam == 1)
+            {
+                sim.colmod = b & 0x07;
+                if(sim.colmod != 0x05 && sim.colmod != 0x06)
+                    sim_stats.errors++;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*---------------------------------------------------引脚解码----------------------------------------------------*/
+
+void Sim_PinsChanged(uint32_t old_pins, uint32_t new_pins)
+{
+    uint32_t diff = old_pins ^ new_pins;
+
+    sim.backlight = (new_pins & LCD_BLK) ? 1 : 0;
+
+    // RES低电平有效：下降沿复位面板
+    if((diff & LCD_RES) && !(new_pins & LCD_RES))
+        Sim_PanelReset();
+
+    if(diff & LCD_CS)
+    {
+        sim_stats.cs_toggles++;
+        if(!(new_pins & LCD_CS))
+        {
+            sim_stats.transactions++;
+        }
+        else if(sim.bits)
+        {
+            sim_stats.errors++;     // 字节没发完就结束了事务
+        }
+        sim.bits = 0;
+    }
+
+    // CS为低时SCL上升沿采样
+    if((diff & LCD_SCL) && (new_pins & LCD_SCL) && !(new_pins & LCD_CS))
+    {
+        sim.shift = (uint8_t)((sim.shift << 1) | ((new_pins & LCD_SDA) ? 1 : 0));
+        if(++sim.bits == 8)
+        {
+            sim.bits = 0;
+            sim_stats.bus_hash = (sim_stats.bus_hash ^ ((new_pins & LCD_DC) ? 1U : 0U)) * FNV_PRIME;
+            sim_stats.bus_hash = (sim_stats.bus_hash ^ sim.shift) * FNV_PRIME;
+            if(new_pins & LCD_DC)
+                Sim_Data(sim.shift);
+            else
+                Sim_Command(sim.shift);
+        }
+    }
+}
+
+/*---------------------------------------------------快照/统计----------------------------------------------------*/
+
+void Sim_PowerOn(void)
+{
+    memset(sim_gram, 0, sizeof(sim_gram));
+    memset(&sim, 0, sizeof(sim));
+    Sim_PanelReset();
+    Sim_ResetStats();
+}
+
+const Sim_Stats_t *Sim_GetStats(void)
+{
+    return &sim_stats;
+}
+
+void Sim_ResetStats(void)
+{
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    sim_stats.bus_hash = FNV_OFFSET;
+}
+
+uint16_t Sim_GetPixel(uint16_t x, uint16_t y)
+{
+    uint16_t pc, pr, c;
+
+    if(x >= SIM_WIDTH || y >= SIM_HEIGHT) return 0;
+    if(sim.sleep || !sim.display_on || !sim.backlight) return 0x0000;
+
+    if(!Sim_Map(x + SIM_COL_OFFSET, y + SIM_ROW_OFFSET, SIM_MADCTL_REF, &pc, &pr)) return 0;
+
+    // 滚动模式：显示行TFA显示显存行SSA，滚动区内按VSA循环，固定区不动
+    if(sim.scroll && sim.vsa && sim.tfa + sim.vsa <= SIM_GRAM_H && pr >= sim.tfa && pr < sim.tfa + sim.vsa)
+        pr = (uint16_t)(sim.tfa + (pr - sim.tfa + sim.ssa + sim.vsa - sim.tfa % sim.vsa) % sim.vsa);
+    c = sim_gram[pr][pc];
+
+    // 与参考方向的RGB/BGR顺序不同时，屏上看到的是红蓝交换的颜色
+    if((sim.madctl ^ SIM_MADCTL_REF) & MADCTL_BGR)
+        c = (uint16_t)((c << 11) | (c & 0x07E0) | (c >> 11));
+    if(sim.inverted)
+        c = (uint16_t)~c;
+    return c;
+}
+
+uint32_t Sim_Hash(void)
+{
+    uint32_t h = 2166136261U;
+    uint16_t x, y, c;
+
+    for(y = 0; y < SIM_HEIGHT; y++)
+    {
+        for(x = 0; x < SIM_WIDTH; x++)
+        {
+            c = Sim_GetPixel(x, y);
+            h = (h ^ (c >> 8)) * 16777619U;
+            h = (h ^ (c & 0xFF)) * 16777619U;
+        }
+    }
+    return h;
+}
+
+int Sim_WritePPM(const char *path)
+{
+    FILE *f;
+    uint16_t x, y, c;
+    uint8_t rgb[3];
+
+    f = fopen(path, "wb");
+    if(f == NULL) return -1;
+
+    fprintf(f, "P6\n%d %d\n255\n", SIM_WIDTH, SIM_HEIGHT);
+    for(y = 0; y < SIM_HEIGHT; y++)
+    {
+        for(x = 0; x < SIM_WIDTH; x++)
+        {
+            c = Sim_GetPixel(x, y);
+            rgb[0] = (uint8_t)(((c >> 11) & 0x1F) * 255 / 31);
+            rgb[1] = (uint8_t)(((c >> 5) & 0x3F) * 255 / 63);
+            rgb[2] = (uint8_t)((c & 0x1F) * 255 / 31);
+            fwrite(rgb, 1, 3, f);
+        }
+    }
+    return fclose(f);
+}
@@ -0,0 +1,74 @@
+/**
+ ******************************************************************************
+ * @file           : st7735_sim.h
+ * @brief          : 主机端ST7735模型
+ *                   从CS/DC/SCL/SDA/RES引脚电平解码SPI字节流，
+ *                   执行SLPOUT/CASET/RASET/RAMWR/MADCTL/COLMOD/VSCRDEF/VSCSAD等命令，写入模拟显存
+ * @author         : Chipdriver
+ * @version        : V1.0
+ * @date           : 2025-01-10
+ ******************************************************************************
+ * 显存模型：
+ * - 驱动按MADCTL=0xC8（MX|MY|BGR）写入，逻辑坐标偏移为列+2、行+3（LCD_Config.h）；
+ *   显存按 (128+2*2)列 x LCD_GRAM_ROWS行 建模，与固件使用同一个行数，
+ *   镜像后可见区域为列2~129、行地址3~162
+ * - 像素按当前MADCTL的MX/MY/MV映射到物理显存，快照时按参考方向读回逻辑坐标
+ * - 只有COLMOD=0x05(16位)和0x06(18位)会被解码，其他格式计入errors
+ * - 硬件垂直滚动：VSCSAD之后进入滚动模式（NORON/复位退出），快照时滚动区内的显示行
+ *   按SSA循环映射到显存行；VSCRDEF三段之和不等于SIM_GRAM_H、VSCSAD不在滚动区内时计入errors
+ ******************************************************************************
+ */
+
+#ifndef __ST7735_SIM_H
+#define __ST7735_SIM_H
+
+#include <stdint.h>
+#include "LCD_Config.h"
+
+#define SIM_WIDTH           128     // 可见区域（逻辑坐标）
+#define SIM_HEIGHT          160
+#define SIM_COL_OFFSET      2       // 驱动CASET中的列偏移
+#define SIM_ROW_OFFSET      3       // 驱动RASET中的行偏移
+#define SIM_GRAM_W          (SIM_WIDTH + 2 * SIM_COL_OFFSET)
+#define SIM_GRAM_H          LCD_GRAM_ROWS
+#define SIM_MADCTL_REF      0xC8    // 快照按这个方向把物理显存还原为逻辑坐标
+
+/**
+ * @brief 模型统计（引脚层看到的真实总线活动）
+ */
+typedef struct
+{
+    uint32_t transactions;  /**< CS下降沿次数 */
+    uint32_t cs_toggles;    /**< CS电平变化次数（上升+下降） */
+    uint32_t commands;      /**< 命令个数 */
+    uint32_t cmd_bytes;     /**< DC=0字节数 */
+    uint32_t param_bytes;   /**< DC=1且不在RAMWR中的字节数 */
+    uint32_t pixel_bytes;   /**< RAMWR中的字节数 */
+    uint32_t pixels;        /**< 写入显存的像素数 */
+    uint32_t windows;       /**< RAMWR命令次数 */
+    uint32_t oob_pixels;    /**< 地址超出物理显存而丢弃的像素 */
+    uint32_t sleep_pixels;  /**< 睡眠状态下写入的像素（真实屏上会丢失） */
+    uint32_t errors;        /**< 协议错误：CS中途拉高时的残缺字节、不支持的COLMOD等 */
+    uint32_t resets;        /**< 硬件复位(RES)和SWRESET次数 */
+    uint32_t bus_hash;      /**< 总线上(dc,byte)流的FNV-1a哈希，算法与lcd_Mock.c相同 */
+} Sim_Stats_t;
+
+// 引脚电平变化（由sim_hal.c中的HAL_GPIO_WritePin调用，pins为LCD_CTRL的ODR）
+void Sim_PinsChanged(uint32_t old_pins, uint32_t new_pins);
+
+// 上电状态（显存清零、统计清零）
+void Sim_PowerOn(void);
+
+const Sim_Stats_t *Sim_GetStats(void);
+void Sim_ResetStats(void);
+
+// 读取逻辑坐标处"屏幕上看到的"RGB565颜色（睡眠/关显示/关背光时为黑，INVON时取反）
+uint16_t Sim_GetPixel(uint16_t x, uint16_t y);
+
+// 可见图像的FNV-1a哈希，用于比较两次渲染结果
+uint32_t Sim_Hash(void);
+
+// 把可见图像保存为PPM(P6)，成功返回0
+int Sim_WritePPM(const char *path);
+
+#endif /* __ST7735_SIM_H */